@@ -0,0 +1,162 @@
+/* Ejemplo de uso de libmemsim desde C: errores sin excepciones, contadores,
+ * instantánea de bloques y la misma carga atendida operación por operación y
+ * en lotes, que debe terminar en el mismo estado. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "memsim_c.h"
+
+#define MEMORY (1 << 22)
+#define BATCH 1024
+#define ROUNDS 250
+
+/* Tamanos pseudoaleatorios reproducibles (xorshift) */
+static uint32_t next_size(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return 1 + *state % 256;
+}
+
+/* Cada ronda asigna BATCH procesos nuevos y libera los de la ronda anterior */
+static void fill_round(memsim_op* allocs, memsim_op* frees, int round, uint32_t* state) {
+    int i;
+    for (i = 0; i < BATCH; i++) {
+        allocs[i].id = (uint64_t)round * BATCH + (uint64_t)i;
+        allocs[i].size = next_size(state);
+        frees[i].id = (uint64_t)(round - 1) * BATCH + (uint64_t)i;
+    }
+}
+
+static double run_single(memsim_manager* manager, memsim_op* allocs, memsim_op* frees, long long* ok) {
+    uint32_t state = 2463534242u;
+    clock_t begin = clock();
+    int round, i;
+    for (round = 0; round < ROUNDS; round++) {
+        fill_round(allocs, frees, round, &state);
+        for (i = 0; i < BATCH; i++) {
+            *ok += memsim_alloc(manager, allocs[i].id, allocs[i].size, NULL) == MEMSIM_OK;
+        }
+        for (i = 0; round > 0 && i < BATCH; i++) {
+            *ok += memsim_free(manager, frees[i].id, NULL, NULL) == MEMSIM_OK;
+        }
+    }
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+static double run_batch(memsim_manager* manager, memsim_op* allocs, memsim_op* frees, long long* ok) {
+    uint32_t state = 2463534242u;
+    clock_t begin = clock();
+    int round;
+    for (round = 0; round < ROUNDS; round++) {
+        fill_round(allocs, frees, round, &state);
+        *ok += (long long)memsim_alloc_batch(manager, allocs, BATCH);
+        if (round > 0) {
+            *ok += (long long)memsim_free_batch(manager, frees, BATCH);
+        }
+    }
+    return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+/* Compara dos gestores bloque a bloque mediante sus instantáneas */
+static int same_blocks(const memsim_manager* first, const memsim_manager* second) {
+    memsim_snapshot* a = memsim_snapshot_create(first);
+    memsim_snapshot* b = memsim_snapshot_create(second);
+    memsim_block x, y;
+    int same = a != NULL && b != NULL && memsim_snapshot_size(a) == memsim_snapshot_size(b);
+    while (same && memsim_snapshot_next(a, &x) && memsim_snapshot_next(b, &y)) {
+        same = x.start == y.start && x.size == y.size && x.used == y.used && x.id == y.id;
+    }
+    memsim_snapshot_destroy(a);
+    memsim_snapshot_destroy(b);
+    return same;
+}
+
+static void show_stats(const char* label, const memsim_manager* manager) {
+    memsim_stats stats;
+    stats.struct_size = sizeof(stats);
+    if (memsim_get_stats(manager, &stats) != MEMSIM_OK) {
+        printf("%-10s sin contadores\n", label);
+        return;
+    }
+    printf("%-10s usada=%lld libre=%lld bloques_libres=%lld mayor_hueco=%lld operaciones=%lld fallos=%lld\n", label,
+           (long long)stats.used_memory, (long long)stats.free_memory, (long long)stats.free_blocks,
+           (long long)stats.largest_free_block, (long long)stats.operations, (long long)stats.failed_allocations);
+}
+
+static int basic_demo(void) {
+    memsim_manager* manager = memsim_create(100, MEMSIM_BEST_FIT);
+    memsim_snapshot* snapshot;
+    memsim_block block;
+    int64_t start = -1, size = 0;
+    int failures = 0;
+    
+    printf("ABI %u\n", memsim_abi_version());
+    failures += memsim_create(0, MEMSIM_FIRST_FIT) != NULL;
+    failures += memsim_alloc(manager, 1, 30, &start) != MEMSIM_OK || start != 0;
+    failures += memsim_alloc(manager, 2, 20, &start) != MEMSIM_OK || start != 30;
+    failures += memsim_alloc(manager, 1, 5, &start) != MEMSIM_DUPLICATE || start != -1;
+    failures += memsim_alloc(manager, 3, 0, NULL) != MEMSIM_INVALID_SIZE;
+    failures += memsim_alloc(manager, 3, 80, NULL) != MEMSIM_NO_MEMORY;
+    failures += memsim_free(manager, 9, NULL, NULL) != MEMSIM_NOT_FOUND;
+    failures += memsim_free(manager, 1, &start, &size) != MEMSIM_OK || start != 0 || size != 30;
+    failures += memsim_set_algorithm(manager, 7) != MEMSIM_INVALID_ARGUMENT;
+    failures += memsim_set_layout(manager, 8, 1, 0) != MEMSIM_INVALID_ARGUMENT;
+    failures += memsim_check(manager) != MEMSIM_OK;
+    
+    snapshot = memsim_snapshot_create(manager);
+    printf("Bloques (%zu):", memsim_snapshot_size(snapshot));
+    while (memsim_snapshot_next(snapshot, &block)) {
+        if (block.used) {
+            printf(" [%lld+%lld id=%llu]", (long long)block.start, (long long)block.size,
+                   (unsigned long long)block.id);
+        } else {
+            printf(" [%lld+%lld libre]", (long long)block.start, (long long)block.size);
+        }
+    }
+    printf("\n");
+    memsim_snapshot_destroy(snapshot);
+    show_stats("Basico", manager);
+    memsim_destroy(manager);
+    return failures;
+}
+
+int main(void) {
+    memsim_op* allocs = malloc(BATCH * sizeof(memsim_op));
+    memsim_op* frees = malloc(BATCH * sizeof(memsim_op));
+    memsim_manager* single = memsim_create(MEMORY, MEMSIM_FIRST_FIT);
+    memsim_manager* batched = memsim_create(MEMORY, MEMSIM_FIRST_FIT);
+    long long single_ok = 0, batch_ok = 0;
+    double operations = 2.0 * BATCH * ROUNDS - BATCH;
+    double single_seconds, batch_seconds;
+    int failures;
+    
+    if (allocs == NULL || frees == NULL || single == NULL || batched == NULL) {
+        printf("No se pudo crear el gestor\n");
+        return 1;
+    }
+    failures = basic_demo();
+    
+    single_seconds = run_single(single, allocs, frees, &single_ok);
+    batch_seconds = run_batch(batched, allocs, frees, &batch_ok);
+    printf("\n%.0f operaciones, lotes de %d, memoria %d, First Fit\n", operations, BATCH, MEMORY);
+    printf("Una a una: %8.3f s  %12.0f ops/s  (%lld con exito)\n", single_seconds,
+           operations / (single_seconds > 0 ? single_seconds : 1e-9), single_ok);
+    printf("En lotes:  %8.3f s  %12.0f ops/s  (%lld con exito)\n", batch_seconds,
+           operations / (batch_seconds > 0 ? batch_seconds : 1e-9), batch_ok);
+    show_stats("Una a una", single);
+    show_stats("En lotes", batched);
+    
+    failures += single_ok != batch_ok;
+    failures += !same_blocks(single, batched);
+    failures += memsim_check(single) != MEMSIM_OK || memsim_check(batched) != MEMSIM_OK;
+    printf("%s\n", failures == 0 ? "Verificacion correcta: mismo estado final con y sin lotes"
+                                 : "Verificacion FALLIDA");
+    
+    memsim_destroy(single);
+    memsim_destroy(batched);
+    free(allocs);
+    free(frees);
+    return failures == 0 ? 0 : 1;
+}
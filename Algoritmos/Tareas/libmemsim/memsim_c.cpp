@@ -0,0 +1,305 @@
+// Implementación de la API en C (memsim_c.h) sobre DynamicMemoryManager. Cada
+// entrada atrapa toda excepción y la convierte en MEMSIM_INTERNAL_ERROR. Los
+// identificadores se guardan como nombres de proceso en decimal.
+#define MEMSIM_BUILDING_LIBRARY
+#include "memsim_c.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../memsim/memory_manager.hpp"
+
+using namespace memsim;
+
+struct memsim_manager {
+    DynamicMemoryManager<SizeOrderedIndex> manager;
+    
+    // Búferes de los lotes; conservan su capacidad entre llamadas
+    std::vector<BatchRequest> requests;
+    std::vector<std::string> names;
+    std::vector<std::string_view> name_views;
+    std::vector<BatchResult> results;
+    
+    memsim_manager(Address size, AllocationAlgorithm algorithm) : manager(size, algorithm) {}
+};
+
+struct memsim_snapshot {
+    std::vector<memsim_block> blocks;
+    size_t next = 0;
+};
+
+namespace {
+
+// Nombre decimal de un identificador, sin reservar memoria
+class IdName {
+private:
+    std::array<char, 24> text;
+    size_t length;
+
+public:
+    explicit IdName(uint64_t id) {
+        length = static_cast<size_t>(std::to_chars(text.data(), text.data() + text.size(), id).ptr - text.data());
+    }
+    
+    std::string_view view() const {
+        return std::string_view(text.data(), length);
+    }
+};
+
+void assign_name(std::string& name, uint64_t id) {
+    IdName text(id);
+    name.assign(text.view());
+}
+
+bool valid_algorithm(int32_t algorithm) {
+    return algorithm >= MEMSIM_FIRST_FIT && algorithm <= static_cast<int32_t>(ALGORITHM_NAMES.size());
+}
+
+AllocationAlgorithm to_algorithm(int32_t algorithm) {
+    return static_cast<AllocationAlgorithm>(algorithm - 1);
+}
+
+memsim_status to_status(OpStatus status) {
+    return static_cast<memsim_status>(status);
+}
+
+size_t reject_batch(memsim_op* ops, size_t count) {
+    for (size_t i = 0; ops != nullptr && i < count; i++) {
+        ops[i].start = -1;
+        ops[i].status = MEMSIM_INVALID_ARGUMENT;
+    }
+    return 0;
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t memsim_abi_version(void) {
+    return MEMSIM_ABI_VERSION;
+}
+
+const char* memsim_status_name(int32_t status) {
+    static const char* const NAMES[] = {"ok", "invalid_size", "duplicate", "no_memory", "not_found",
+                                        "invalid_argument", "internal_error"};
+    return status >= 0 && status <= MEMSIM_INTERNAL_ERROR ? NAMES[status] : "unknown";
+}
+
+memsim_manager* memsim_create(int64_t total_memory, int32_t algorithm) {
+    if (total_memory <= 0 || total_memory > MAX_TOTAL_MEMORY || !valid_algorithm(algorithm)) {
+        return nullptr;
+    }
+    try {
+        return new memsim_manager(total_memory, to_algorithm(algorithm));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void memsim_destroy(memsim_manager* manager) {
+    delete manager;
+}
+
+memsim_status memsim_set_algorithm(memsim_manager* manager, int32_t algorithm) {
+    if (manager == nullptr || !valid_algorithm(algorithm)) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    // Pasar a TLSF arma sus listas segregadas y puede quedarse sin memoria
+    try {
+        manager->manager.set_algorithm(to_algorithm(algorithm));
+        return MEMSIM_OK;
+    } catch (...) {
+        return MEMSIM_INTERNAL_ERROR;
+    }
+}
+
+memsim_status memsim_set_layout(memsim_manager* manager, int32_t alignment, int32_t min_split, int32_t header) {
+    if (manager == nullptr) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    try {
+        return manager->manager.set_layout({alignment, min_split, header}) ? MEMSIM_OK : MEMSIM_INVALID_ARGUMENT;
+    } catch (...) {
+        return MEMSIM_INTERNAL_ERROR;
+    }
+}
+
+memsim_status memsim_alloc(memsim_manager* manager, uint64_t id, int64_t size, int64_t* start) {
+    if (manager == nullptr) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    try {
+        Address position = -1;
+        OpStatus status = manager->manager.try_allocate(IdName(id).view(), size, position);
+        if (start != nullptr) {
+            *start = status == OpStatus::OK ? position : -1;
+        }
+        return to_status(status);
+    } catch (...) {
+        return MEMSIM_INTERNAL_ERROR;
+    }
+}
+
+memsim_status memsim_free(memsim_manager* manager, uint64_t id, int64_t* start, int64_t* size) {
+    if (manager == nullptr) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    try {
+        Address position = -1, freed = 0;
+        OpStatus status = manager->manager.try_deallocate(IdName(id).view(), position, freed);
+        if (start != nullptr) {
+            *start = status == OpStatus::OK ? position : -1;
+        }
+        if (size != nullptr) {
+            *size = status == OpStatus::OK ? freed : 0;
+        }
+        return to_status(status);
+    } catch (...) {
+        return MEMSIM_INTERNAL_ERROR;
+    }
+}
+
+size_t memsim_alloc_batch(memsim_manager* manager, memsim_op* ops, size_t count) {
+    if (manager == nullptr || (ops == nullptr && count > 0)) {
+        return reject_batch(ops, count);
+    }
+    try {
+        auto& requests = manager->requests;
+        requests.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            assign_name(requests[i].process_name, ops[i].id);
+            requests[i].size = ops[i].size;
+        }
+        manager->manager.try_allocate_batch(requests, manager->results);
+        
+        size_t succeeded = 0;
+        for (size_t i = 0; i < count; i++) {
+            const BatchResult& result = manager->results[i];
+            ops[i].status = to_status(result.status);
+            ops[i].start = result.status == OpStatus::OK ? result.start : -1;
+            succeeded += result.status == OpStatus::OK ? 1 : 0;
+        }
+        return succeeded;
+    } catch (...) {
+        for (size_t i = 0; i < count; i++) {
+            ops[i].status = MEMSIM_INTERNAL_ERROR;
+        }
+        return 0;
+    }
+}
+
+size_t memsim_free_batch(memsim_manager* manager, memsim_op* ops, size_t count) {
+    if (manager == nullptr || (ops == nullptr && count > 0)) {
+        return reject_batch(ops, count);
+    }
+    try {
+        auto& names = manager->names;
+        auto& views = manager->name_views;
+        if (names.size() < count) {
+            names.resize(count);
+        }
+        views.clear();
+        for (size_t i = 0; i < count; i++) {
+            assign_name(names[i], ops[i].id);
+            views.push_back(names[i]);
+        }
+        manager->manager.try_deallocate_batch(views, manager->results);
+        
+        size_t succeeded = 0;
+        for (size_t i = 0; i < count; i++) {
+            const BatchResult& result = manager->results[i];
+            bool ok = result.status == OpStatus::OK;
+            ops[i].status = to_status(result.status);
+            ops[i].start = ok ? result.start : -1;
+            ops[i].size = ok ? result.size : 0;
+            succeeded += ok ? 1 : 0;
+        }
+        return succeeded;
+    } catch (...) {
+        for (size_t i = 0; i < count; i++) {
+            ops[i].status = MEMSIM_INTERNAL_ERROR;
+        }
+        return 0;
+    }
+}
+
+memsim_status memsim_get_stats(const memsim_manager* manager, memsim_stats* stats) {
+    if (manager == nullptr || stats == nullptr || stats->struct_size < sizeof(uint32_t)) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    const DynamicMemoryManager<SizeOrderedIndex>& target = manager->manager;
+    const MemoryCounters& counters = target.get_counters();
+    memsim_stats full{};
+    full.struct_size = stats->struct_size;
+    full.algorithm = static_cast<int32_t>(target.get_algorithm()) + 1;
+    full.total_memory = target.get_total_memory();
+    full.used_memory = counters.used_memory;
+    full.free_memory = counters.free_memory;
+    full.requested_memory = counters.requested_memory;
+    full.header_memory = counters.header_memory;
+    full.free_blocks = counters.free_blocks;
+    full.used_blocks = static_cast<int64_t>(target.blocks().size()) - counters.free_blocks - counters.cached_blocks;
+    full.largest_free_block = target.get_largest_free_block();
+    full.operations = counters.operations;
+    full.failed_allocations = counters.failed_allocations;
+    // Un llamador compilado con una versión anterior recibe solo los campos que conoce
+    std::memcpy(stats, &full, std::min<size_t>(stats->struct_size, sizeof(full)));
+    return MEMSIM_OK;
+}
+
+memsim_status memsim_check(const memsim_manager* manager) {
+    if (manager == nullptr) {
+        return MEMSIM_INVALID_ARGUMENT;
+    }
+    try {
+        std::string problem;
+        return manager->manager.check_invariants(problem) ? MEMSIM_OK : MEMSIM_INTERNAL_ERROR;
+    } catch (...) {
+        return MEMSIM_INTERNAL_ERROR;
+    }
+}
+
+memsim_snapshot* memsim_snapshot_create(const memsim_manager* manager) {
+    if (manager == nullptr) {
+        return nullptr;
+    }
+    try {
+        memsim_snapshot* snapshot = new memsim_snapshot();
+        const auto& blocks = manager->manager.blocks();
+        snapshot->blocks.reserve(blocks.size());
+        for (const auto& block : blocks) {
+            memsim_block copy{block.start, block.size, 0, block.is_free ? 0 : 1, 0};
+            if (!block.is_free) {
+                std::from_chars(block.process_name.data(), block.process_name.data() + block.process_name.size(),
+                                copy.id);
+            }
+            snapshot->blocks.push_back(copy);
+        }
+        return snapshot;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+size_t memsim_snapshot_size(const memsim_snapshot* snapshot) {
+    return snapshot == nullptr ? 0 : snapshot->blocks.size();
+}
+
+int32_t memsim_snapshot_next(memsim_snapshot* snapshot, memsim_block* block) {
+    if (snapshot == nullptr || block == nullptr || snapshot->next >= snapshot->blocks.size()) {
+        return 0;
+    }
+    *block = snapshot->blocks[snapshot->next++];
+    return 1;
+}
+
+void memsim_snapshot_destroy(memsim_snapshot* snapshot) {
+    delete snapshot;
+}
+
+} // extern "C"
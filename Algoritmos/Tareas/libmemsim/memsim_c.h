@@ -0,0 +1,140 @@
+/* API en C de la biblioteca memsim (libmemsim.so): el gestor de Tarea 2 sin
+ * mensajes ni entrada interactiva, para usarlo desde C, Python (ctypes/cffi) o Rust.
+ *
+ * - Ninguna función imprime ni deja escapar excepciones: los errores se devuelven
+ *   como memsim_status (o NULL en las funciones que crean objetos).
+ * - Los procesos se identifican con un entero de 64 bits elegido por el llamador.
+ * - Un gestor no es seguro entre hilos; gestores distintos son independientes.
+ * - Las operaciones en lote cuestan una llamada y un despacho del algoritmo por lote
+ *   y las liberaciones fusionan los huecos en una sola pasada, con el mismo resultado
+ *   que en secuencia.
+ *
+ * La ABI solo crece: las estructuras que el llamador pasa llevan su tamano
+ * (struct_size) y los campos nuevos se agregan al final. */
+#ifndef MEMSIM_C_H
+#define MEMSIM_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  ifdef MEMSIM_BUILDING_LIBRARY
+#    define MEMSIM_API __declspec(dllexport)
+#  else
+#    define MEMSIM_API __declspec(dllimport)
+#  endif
+#else
+#  define MEMSIM_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEMSIM_ABI_VERSION 1
+
+/* Algoritmos, con la misma numeración que ALG */
+enum {
+    MEMSIM_FIRST_FIT = 1,
+    MEMSIM_BEST_FIT = 2,
+    MEMSIM_WORST_FIT = 3,
+    MEMSIM_NEXT_FIT = 4,
+    MEMSIM_TLSF = 5,
+    MEMSIM_ADAPTIVE = 6
+};
+
+/* Resultados; los cinco primeros son los de las operaciones A/L del simulador */
+typedef enum memsim_status {
+    MEMSIM_OK = 0,
+    MEMSIM_INVALID_SIZE = 1,
+    MEMSIM_DUPLICATE = 2,
+    MEMSIM_NO_MEMORY = 3,
+    MEMSIM_NOT_FOUND = 4,
+    MEMSIM_INVALID_ARGUMENT = 5,
+    MEMSIM_INTERNAL_ERROR = 6   /* sin memoria en el proceso anfitrión o invariante roto */
+} memsim_status;
+
+typedef struct memsim_manager memsim_manager;
+typedef struct memsim_snapshot memsim_snapshot;
+
+/* Operación de un lote. Entrada: id (y size al asignar). Salida: status, start y, al
+ * liberar, size del bloque liberado. */
+typedef struct memsim_op {
+    uint64_t id;
+    int64_t size;
+    int64_t start;      /* -1 si no hubo bloque */
+    int32_t status;     /* memsim_status */
+    int32_t reserved;
+} memsim_op;
+
+/* Contadores del gestor. Asigne struct_size = sizeof(memsim_stats) antes de llamar. */
+typedef struct memsim_stats {
+    uint32_t struct_size;
+    int32_t algorithm;          /* MEMSIM_FIRST_FIT .. MEMSIM_ADAPTIVE */
+    int64_t total_memory;
+    int64_t used_memory;        /* incluye cabeceras y relleno de la forma de bloques */
+    int64_t free_memory;
+    int64_t requested_memory;   /* unidades pedidas por los procesos vivos */
+    int64_t header_memory;      /* cabeceras de los bloques ocupados */
+    int64_t free_blocks;
+    int64_t used_blocks;
+    int64_t largest_free_block;
+    int64_t operations;         /* A y L atendidos, con o sin éxito */
+    int64_t failed_allocations;
+} memsim_stats;
+
+/* Bloque de una instantánea; id solo tiene sentido si used != 0 */
+typedef struct memsim_block {
+    int64_t start;
+    int64_t size;
+    uint64_t id;
+    int32_t used;
+    int32_t reserved;
+} memsim_block;
+
+MEMSIM_API uint32_t memsim_abi_version(void);
+
+/* Nombre corto de un resultado ("ok", "no_memory", ...); nunca NULL */
+MEMSIM_API const char* memsim_status_name(int32_t status);
+
+/* Gestor de `total_memory` unidades (1 a 2^62) con `algorithm`; NULL si los
+ * argumentos no sirven o no hay memoria */
+MEMSIM_API memsim_manager* memsim_create(int64_t total_memory, int32_t algorithm);
+MEMSIM_API void memsim_destroy(memsim_manager* manager);
+
+MEMSIM_API memsim_status memsim_set_algorithm(memsim_manager* manager, int32_t algorithm);
+
+/* Forma de los bloques (alineación, corte mínimo, cabecera); solo sin procesos vivos */
+MEMSIM_API memsim_status memsim_set_layout(memsim_manager* manager, int32_t alignment, int32_t min_split,
+                                           int32_t header);
+
+/* Asigna `size` unidades al proceso `id`; `start` (puede ser NULL) recibe el inicio */
+MEMSIM_API memsim_status memsim_alloc(memsim_manager* manager, uint64_t id, int64_t size, int64_t* start);
+
+/* Libera el bloque del proceso `id`; `start` y `size` (pueden ser NULL) lo describen */
+MEMSIM_API memsim_status memsim_free(memsim_manager* manager, uint64_t id, int64_t* start, int64_t* size);
+
+/* Lotes: atienden ops[0..count) en orden y devuelven cuántas terminaron en MEMSIM_OK.
+ * Con argumentos inválidos devuelven 0 y marcan cada operación MEMSIM_INVALID_ARGUMENT
+ * si `ops` no es NULL. */
+MEMSIM_API size_t memsim_alloc_batch(memsim_manager* manager, memsim_op* ops, size_t count);
+MEMSIM_API size_t memsim_free_batch(memsim_manager* manager, memsim_op* ops, size_t count);
+
+MEMSIM_API memsim_status memsim_get_stats(const memsim_manager* manager, memsim_stats* stats);
+
+/* Verifica los invariantes del gestor (bloques contiguos, índices y contadores) */
+MEMSIM_API memsim_status memsim_check(const memsim_manager* manager);
+
+/* Copia de los bloques en orden de dirección; el gestor puede seguir cambiando */
+MEMSIM_API memsim_snapshot* memsim_snapshot_create(const memsim_manager* manager);
+MEMSIM_API size_t memsim_snapshot_size(const memsim_snapshot* snapshot);
+
+/* Escribe el siguiente bloque en `block` y devuelve 1; 0 al terminar */
+MEMSIM_API int32_t memsim_snapshot_next(memsim_snapshot* snapshot, memsim_block* block);
+MEMSIM_API void memsim_snapshot_destroy(memsim_snapshot* snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMSIM_C_H */
@@ -0,0 +1,195 @@
+// Tabla hash de direcciones para los índices del gestor (inicio de bloque -> valor) con
+// costo acotado en cada operación. std::unordered_map rehace la tabla entera al crecer,
+// un paso O(n) que aparece como la peor latencia de un A o L; aquí, al superar una
+// entrada por cubeta se reserva una tabla del doble y las cubetas de la anterior se
+// trasladan de a MIGRATE_STEP en cada inserción o borrado, como el rehash incremental
+// de Redis.
+#ifndef MEMSIM_ADDRESS_MAP_HPP
+#define MEMSIM_ADDRESS_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace memsim {
+
+// Las claves son direcciones (long long, como Address) y cada clave está a lo sumo una
+// vez: insert supone que no está. Las entradas viven en tramos de ENTRIES_PER_CHUNK
+// que no se mueven al crecer y las borradas se reutilizan, así que en régimen estable
+// no se pide memoria. Reservar la tabla nueva cuesta solo llenarla de cubetas vacías.
+template <class Value>
+class AddressMap {
+private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+    static constexpr size_t CHUNK_LOG2 = 10;
+    static constexpr size_t ENTRIES_PER_CHUNK = size_t{1} << CHUNK_LOG2;
+    static constexpr size_t MIN_BUCKETS = 16;
+    static constexpr size_t MIGRATE_STEP = 4; // cubetas trasladadas por operación
+    
+    struct Entry {
+        long long key;
+        Value value;
+        size_t next; // siguiente entrada de la misma cubeta
+    };
+    
+    std::vector<std::vector<Entry>> chunks;
+    std::vector<size_t> unused;      // entradas borradas, listas para reutilizar
+    size_t allocated = 0;            // entradas usadas alguna vez en los tramos
+    std::vector<size_t> buckets;     // tabla vigente (potencia de 2): primera entrada de cada cubeta
+    std::vector<size_t> old_buckets; // tabla anterior mientras se traslada
+    size_t migrated = 0;             // cubetas de old_buckets ya trasladadas
+    size_t count = 0;
+    
+    Entry& entry_at(size_t entry) {
+        return chunks[entry >> CHUNK_LOG2][entry & (ENTRIES_PER_CHUNK - 1)];
+    }
+    
+    const Entry& entry_at(size_t entry) const {
+        return chunks[entry >> CHUNK_LOG2][entry & (ENTRIES_PER_CHUNK - 1)];
+    }
+    
+    // Cubeta de `key` en una tabla de `bucket_count` cubetas (hash de Fibonacci)
+    static size_t slot(long long key, size_t bucket_count) {
+        uint64_t hash = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash ^ (hash >> 32)) & (bucket_count - 1);
+    }
+    
+    // Entrada de `key` en la cadena que empieza en `entry`, o NONE
+    size_t search(size_t entry, long long key) const {
+        while (entry != NONE && entry_at(entry).key != key) {
+            entry = entry_at(entry).next;
+        }
+        return entry;
+    }
+    
+    // Cadena de old_buckets donde estaría `key`, si todavía no se trasladó
+    size_t* old_chain(long long key) {
+        if (old_buckets.empty()) {
+            return nullptr;
+        }
+        size_t bucket = slot(key, old_buckets.size());
+        return bucket < migrated ? nullptr : &old_buckets[bucket];
+    }
+    
+    // Trasladar hasta `steps` cubetas de la tabla anterior a la vigente
+    void migrate(size_t steps) {
+        for (; steps > 0 && migrated < old_buckets.size(); steps--) {
+            for (size_t entry = old_buckets[migrated]; entry != NONE;) {
+                Entry& moved = entry_at(entry);
+                size_t next = moved.next;
+                size_t& head = buckets[slot(moved.key, buckets.size())];
+                moved.next = head;
+                head = entry;
+                entry = next;
+            }
+            migrated++;
+        }
+        if (migrated == old_buckets.size()) {
+            old_buckets.clear();
+            migrated = 0;
+        }
+    }
+    
+    // Con una entrada por cubeta se pasa a una tabla del doble. El traslado anterior
+    // siempre terminó: empezó con la mitad de entradas y avanza en cada inserción.
+    void grow() {
+        migrate(old_buckets.size());
+        old_buckets.swap(buckets);
+        buckets.assign(old_buckets.empty() ? MIN_BUCKETS : old_buckets.size() * 2, NONE);
+    }
+
+public:
+    size_t size() const {
+        return count;
+    }
+    
+    // Reservar cubetas para `capacity` entradas; solo tiene efecto con la tabla vacía
+    void reserve(size_t capacity) {
+        if (count > 0) {
+            return;
+        }
+        size_t bucket_count = MIN_BUCKETS;
+        while (bucket_count < capacity) {
+            bucket_count *= 2;
+        }
+        if (bucket_count > buckets.size()) {
+            buckets.assign(bucket_count, NONE);
+            old_buckets.clear();
+            migrated = 0;
+        }
+        chunks.reserve(capacity / ENTRIES_PER_CHUNK + 1);
+        unused.reserve(capacity);
+    }
+    
+    // Vaciar conservando las cubetas y los tramos
+    void clear() {
+        buckets.assign(buckets.size(), NONE);
+        old_buckets.clear();
+        migrated = 0;
+        unused.clear();
+        allocated = 0;
+        count = 0;
+    }
+    
+    Value* find(long long key) {
+        return const_cast<Value*>(static_cast<const AddressMap*>(this)->find(key));
+    }
+    
+    const Value* find(long long key) const {
+        size_t entry = buckets.empty() ? NONE : search(buckets[slot(key, buckets.size())], key);
+        if (entry == NONE && !old_buckets.empty()) {
+            size_t bucket = slot(key, old_buckets.size());
+            entry = bucket < migrated ? NONE : search(old_buckets[bucket], key);
+        }
+        return entry == NONE ? nullptr : &entry_at(entry).value;
+    }
+    
+    // Agregar `key` (que no debe estar) con `value`
+    void insert(long long key, const Value& value) {
+        migrate(MIGRATE_STEP);
+        if (count >= buckets.size()) {
+            grow();
+        }
+        size_t entry;
+        if (!unused.empty()) {
+            entry = unused.back();
+            unused.pop_back();
+        } else {
+            if (allocated == chunks.size() * ENTRIES_PER_CHUNK) {
+                chunks.emplace_back(ENTRIES_PER_CHUNK);
+            }
+            entry = allocated++;
+        }
+        size_t& head = buckets[slot(key, buckets.size())];
+        entry_at(entry) = {key, value, head};
+        head = entry;
+        count++;
+    }
+    
+    // Quitar `key`; devuelve false si no estaba
+    bool erase(long long key) {
+        migrate(MIGRATE_STEP);
+        size_t* link = buckets.empty() ? nullptr : &buckets[slot(key, buckets.size())];
+        while (link != nullptr && *link != NONE && entry_at(*link).key != key) {
+            link = &entry_at(*link).next;
+        }
+        if (link == nullptr || *link == NONE) {
+            link = old_chain(key);
+            while (link != nullptr && *link != NONE && entry_at(*link).key != key) {
+                link = &entry_at(*link).next;
+            }
+        }
+        if (link == nullptr || *link == NONE) {
+            return false;
+        }
+        size_t entry = *link;
+        *link = entry_at(entry).next;
+        unused.push_back(entry);
+        count--;
+        return true;
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_ADDRESS_MAP_HPP
@@ -0,0 +1,73 @@
+// Contador de reservas en el heap: reemplaza operator new/delete globales para que
+// la verificación --check-allocs sepa cuántas reservas hace cada operación y
+// --big-heap, cuántos bytes ocupa el simulador como máximo. No forma parte de
+// memsim.hpp; debe incluirse en una sola unidad de traducción del programa.
+#ifndef MEMSIM_ALLOC_COUNTER_HPP
+#define MEMSIM_ALLOC_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace memsim {
+
+inline std::atomic<long long> heap_allocation_count{0};
+inline std::atomic<long long> heap_live_bytes{0};
+inline std::atomic<long long> heap_peak_bytes{0};
+
+// Cada reserva lleva delante su tamano para descontarlo al liberar
+constexpr std::size_t HEAP_PREFIX = alignof(std::max_align_t);
+
+// Reservas hechas desde el inicio del programa (todas las variantes de operator new)
+inline long long heap_allocations() {
+    return heap_allocation_count.load(std::memory_order_relaxed);
+}
+
+// Bytes pedidos al heap y aún no liberados
+inline long long heap_bytes_in_use() {
+    return heap_live_bytes.load(std::memory_order_relaxed);
+}
+
+// Máximo de bytes en uso desde el último reset_heap_peak()
+inline long long heap_bytes_peak() {
+    return heap_peak_bytes.load(std::memory_order_relaxed);
+}
+
+inline void reset_heap_peak() {
+    heap_peak_bytes.store(heap_bytes_in_use(), std::memory_order_relaxed);
+}
+
+} // namespace memsim
+
+// Las variantes de arreglo y nothrow de la biblioteca estándar delegan en esta
+void* operator new(std::size_t size) {
+    memsim::heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void* block = std::malloc(memsim::HEAP_PREFIX + size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    long long live = memsim::heap_live_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) +
+                     static_cast<long long>(size);
+    long long peak = memsim::heap_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !memsim::heap_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return static_cast<char*>(block) + memsim::HEAP_PREFIX;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    void* block = static_cast<char*>(pointer) - memsim::HEAP_PREFIX;
+    memsim::heap_live_bytes.fetch_sub(static_cast<long long>(*static_cast<std::size_t*>(block)),
+                                      std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+#endif // MEMSIM_ALLOC_COUNTER_HPP
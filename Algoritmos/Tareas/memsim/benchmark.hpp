@@ -0,0 +1,357 @@
+// Benchmark del despacho del algoritmo: compara el costo por operación de asignar
+// con un switch en cada llamada, con un único despacho por reproducción y con la
+// política fija en compilación (la búsqueda pura, sin ningún despacho). También el
+// reporte de latencia por operación de cada algoritmo, con sus peores casos, y la
+// evaluación del algoritmo adaptativo frente a cada política fija.
+#ifndef MEMSIM_BENCHMARK_HPP
+#define MEMSIM_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "memory_manager.hpp"
+#include "pipeline.hpp"
+
+namespace memsim {
+
+// Operación A/L ya analizada; los nombres se construyen antes de medir
+struct ReplayOp {
+    char op;
+    Address size;
+    std::string process_name;
+};
+
+// Carga sintética: 55% asignaciones de 1 a `max_size` unidades y 45% liberaciones
+// de un proceso vivo elegido al azar
+inline std::vector<ReplayOp> synthetic_replay_ops(int count, int max_size, uint64_t seed) {
+    std::vector<ReplayOp> ops;
+    std::vector<int> live;
+    XorShift64 rng(seed);
+    ops.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (!live.empty() && rng.below(100) < 45) {
+            size_t victim = static_cast<size_t>(rng.below(static_cast<int>(live.size())));
+            std::swap(live[victim], live.back());
+            ops.push_back({'L', 0, "P" + std::to_string(live.back())});
+            live.pop_back();
+        } else {
+            ops.push_back({'A', 1 + rng.below(max_size), "P" + std::to_string(i)});
+            live.push_back(i);
+        }
+    }
+    return ops;
+}
+
+// Carga en régimen estable: asigna mientras la demanda viva no pase de `live_target`
+// unidades y, cuando la pasa, libera un proceso vivo al azar; así los fallos vienen de
+// la fragmentación y no de la falta de memoria. Con `phase_length` > 0 la distribución
+// de tamanos cambia cada `phase_length` operaciones: pequenos (1 a max/8), grandes
+// (max/2 a max) y bimodal (90% de 1 a 16, 10% grandes); con 0, uniforme de 1 a max.
+inline std::vector<ReplayOp> steady_replay_ops(int count, Address live_target, int max_size, int phase_length,
+                                               uint64_t seed) {
+    std::vector<ReplayOp> ops;
+    std::vector<std::pair<int, Address>> live; // (proceso, tamano)
+    Address live_units = 0;
+    XorShift64 rng(seed);
+    ops.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (live_units > live_target) {
+            size_t victim = static_cast<size_t>(rng.below(static_cast<int>(live.size())));
+            std::swap(live[victim], live.back());
+            ops.push_back({'L', 0, "P" + std::to_string(live.back().first)});
+            live_units -= live.back().second;
+            live.pop_back();
+            continue;
+        }
+        Address size;
+        int large_min = std::max(1, max_size / 2);
+        switch (phase_length > 0 ? i / phase_length % 3 : -1) {
+            case 0: size = 1 + rng.below(std::max(1, max_size / 8)); break;
+            case 1: size = large_min + rng.below(max_size - large_min + 1); break;
+            case 2: size = rng.below(10) > 0 ? 1 + rng.below(16) : large_min + rng.below(max_size - large_min + 1); break;
+            default: size = 1 + rng.below(max_size); break;
+        }
+        ops.push_back({'A', size, "P" + std::to_string(i)});
+        live.push_back({i, size});
+        live_units += size;
+    }
+    return ops;
+}
+
+// Comandos A/L de una traza (el resto de los comandos se ignora)
+inline std::vector<ReplayOp> load_replay_ops(std::istream& input) {
+    std::vector<ReplayOp> ops;
+    std::string line;
+    ParsedCommand parsed;
+    int line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) continue;
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            ops.push_back({'A', parsed.size, parsed.process_name});
+        } else if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+            ops.push_back({'L', 0, parsed.process_name});
+        }
+    }
+    return ops;
+}
+
+// Reproduce `ops` asignando con `allocate(nombre, tamano, inicio)` y devuelve una
+// suma de control de los inicios y resultados para comparar los caminos entre sí
+template <class Manager, class Allocate>
+long long replay_ops(Manager& manager, const std::vector<ReplayOp>& ops, Allocate&& allocate) {
+    long long checksum = 0;
+    Address start, size;
+    for (const auto& op : ops) {
+        OpStatus status = op.op == 'A' ? allocate(op.process_name, op.size, start)
+                                       : manager.try_deallocate(op.process_name, start, size);
+        checksum = checksum * 31 + start * 8 + static_cast<int>(status);
+    }
+    return checksum;
+}
+
+// Mide `run` (que recibe un gestor nuevo) `rounds` veces y devuelve el mejor tiempo
+template <class Run>
+double best_time(int rounds, long long& checksum, Run&& run) {
+    double best = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        auto started = std::chrono::steady_clock::now();
+        checksum = run();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (round == 0 || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+// Ejecuta el benchmark y devuelve false si algún camino no produce las mismas
+// asignaciones que el despacho por operación
+template <class FreeIndex>
+bool run_dispatch_benchmark(Address total_memory, AllocationAlgorithm algorithm,
+                            const std::vector<ReplayOp>& ops, int rounds) {
+    using Dynamic = DynamicMemoryManager<FreeIndex>;
+    long long reference = 0, single = 0, fixed = 0;
+    
+    // 1) switch (algorithm) en cada try_allocate
+    double per_op = best_time(rounds, reference, [&]() {
+        Dynamic manager(total_memory, algorithm);
+        return replay_ops(manager, ops, [&](const std::string& name, Address size, Address& start) {
+            return manager.try_allocate(name, size, start);
+        });
+    });
+    
+    // 2) un único dispatch; el bucle queda especializado para la política
+    double once = best_time(rounds, single, [&]() {
+        Dynamic manager(total_memory, algorithm);
+        return manager.dispatch([&](auto& placement) {
+            return replay_ops(manager, ops, [&](const std::string& name, Address size, Address& start) {
+                return manager.try_allocate_with(placement, name, size, start);
+            });
+        });
+    });
+    
+    // 3) BasicMemoryManager con la política como parámetro de plantilla
+    double compiled = best_time(rounds, fixed, [&]() {
+        Dynamic selector(1, algorithm);
+        return selector.dispatch([&](auto& selected) {
+            using Placement = std::decay_t<decltype(selected)>;
+            BasicMemoryManager<Placement, FreeIndex> manager(total_memory);
+            return replay_ops(manager, ops, [&](const std::string& name, Address size, Address& start) {
+                return manager.try_allocate(name, size, start);
+            });
+        });
+    });
+    
+    size_t count = std::max<size_t>(ops.size(), 1);
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "BENCHMARK DE DESPACHO - Algoritmo: " << algorithm_display_name(algorithm)
+             << " | Memoria: " << total_memory << " | Operaciones: " << ops.size()
+             << " | Rondas: " << rounds << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(40) << "Camino" << std::setw(12) << "ns/op"
+             << std::setw(12) << "Relativo" << "Verificacion\n";
+    std::cout << std::string(78, '-') << "\n";
+    
+    struct Row { const char* name; double seconds; long long checksum; };
+    const Row rows[] = {
+        {"Switch por operacion (try_allocate)", per_op, reference},
+        {"Despacho unico por reproduccion", once, single},
+        {"Politica fija (BasicMemoryManager)", compiled, fixed}};
+    bool all_ok = true;
+    for (const auto& row : rows) {
+        bool ok = row.checksum == reference;
+        all_ok = all_ok && ok;
+        std::cout << std::left << std::setw(40) << row.name << std::fixed << std::setprecision(1)
+                 << std::setw(12) << (row.seconds * 1e9 / count) << std::setprecision(2)
+                 << std::setw(12) << (per_op > 0.0 ? row.seconds / per_op : 1.0);
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << (ok ? "OK" : "FALLO") << "\n";
+    }
+    std::cout << std::string(78, '=') << "\n";
+    return all_ok;
+}
+
+// Latencia de un algoritmo al reproducir una carga. Los percentiles son nanosegundos de
+// reloj por operación A/L; `max_probes` (bloques examinados en la peor búsqueda) no
+// depende del ruido del reloj y muestra si el peor caso crece con la memoria.
+struct LatencyReport {
+    AllocationAlgorithm algorithm;
+    long long p50_ns = 0;
+    long long p99_ns = 0;
+    long long p999_ns = 0;
+    long long max_ns = 0;
+    uint32_t max_probes = 0;
+    long long failures = 0;
+};
+
+// Reproduce `ops` `rounds` veces con un gestor nuevo y toma para cada operación su menor
+// tiempo entre rondas: el trabajo es idéntico en todas, así que el mínimo descarta las
+// interrupciones del sistema sin esconder las operaciones realmente lentas.
+template <class FreeIndex>
+LatencyReport measure_latency(Address total_memory, AllocationAlgorithm algorithm, const std::vector<ReplayOp>& ops,
+                              int rounds) {
+    using Clock = std::chrono::steady_clock;
+    LatencyReport report{algorithm};
+    std::vector<long long> samples(ops.size(), 0);
+    for (int round = 0; round < rounds; round++) {
+        DynamicMemoryManager<FreeIndex> manager(total_memory, algorithm);
+        long long failures = 0;
+        manager.dispatch([&](auto& placement) {
+            Address start, size;
+            for (size_t i = 0; i < ops.size(); i++) {
+                const ReplayOp& op = ops[i];
+                Clock::time_point started = Clock::now();
+                if (op.op == 'A') {
+                    if (manager.try_allocate_with(placement, op.process_name, op.size, start) == OpStatus::NO_MEMORY) {
+                        failures++;
+                    }
+                } else {
+                    manager.try_deallocate(op.process_name, start, size);
+                }
+                long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count();
+                samples[i] = round == 0 ? ns : std::min(samples[i], ns);
+                if (op.op == 'A') {
+                    report.max_probes = std::max(report.max_probes, placement.probes);
+                }
+            }
+        });
+        report.failures = failures;
+    }
+    
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double fraction) {
+        size_t index = std::min(samples.size() - 1, static_cast<size_t>(fraction * static_cast<double>(samples.size())));
+        return samples[index];
+    };
+    if (!samples.empty()) {
+        report.p50_ns = percentile(0.50);
+        report.p99_ns = percentile(0.99);
+        report.p999_ns = percentile(0.999);
+        report.max_ns = samples.back();
+    }
+    return report;
+}
+
+// Mide y muestra la latencia de cada algoritmo sobre la misma carga
+template <class FreeIndex>
+void run_latency_report(Address total_memory, const std::vector<ReplayOp>& ops, int rounds) {
+    std::vector<LatencyReport> reports;
+    for (size_t i = 0; i < ALGORITHM_NAMES.size(); i++) {
+        reports.push_back(measure_latency<FreeIndex>(total_memory, static_cast<AllocationAlgorithm>(i), ops, rounds));
+    }
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "LATENCIA POR OPERACION - Memoria: " << total_memory << " | Operaciones: " << ops.size()
+             << " | Rondas: " << rounds << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(14) << "Algoritmo" << std::right << std::setw(10) << "p50 ns"
+             << std::setw(10) << "p99 ns" << std::setw(11) << "p99.9 ns" << std::setw(10) << "max ns"
+             << std::setw(13) << "Max sondas" << std::setw(10) << "Fallos" << "\n";
+    std::cout << std::string(78, '-') << "\n";
+    for (const auto& report : reports) {
+        std::cout << std::left << std::setw(14) << algorithm_display_name(report.algorithm) << std::right
+                 << std::setw(10) << report.p50_ns << std::setw(10) << report.p99_ns << std::setw(11)
+                 << report.p999_ns << std::setw(10) << report.max_ns << std::setw(13) << report.max_probes
+                 << std::setw(10) << report.failures << "\n";
+    }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << "Max sondas: bloques examinados por la peor busqueda (TLSF consulta solo los mapas de bits)\n";
+    std::cout << "ns: incluye abrir o cerrar el bloque en la lista enlazada por direccion, O(1) con cualquier algoritmo\n";
+    std::cout << std::string(78, '=') << "\n";
+}
+
+// Resultado de un algoritmo sobre una carga para comparar el adaptativo con las
+// políticas fijas. La fragmentación externa (1 - mayor hueco / memoria libre) se
+// muestrea tras cada operación A/L.
+struct PolicyScore {
+    AllocationAlgorithm algorithm;
+    long long searches = 0;         // A que llegaron a buscar hueco
+    long long failures = 0;
+    long long probes = 0;
+    double mean_fragmentation = 0.0;
+    double final_fragmentation = 0.0;
+    double seconds = 0.0;
+    size_t switches = 0;            // cambios de política (solo el adaptativo)
+    
+    double probes_per_search() const {
+        return searches > 0 ? static_cast<double>(probes) / searches : 0.0;
+    }
+    
+    double failure_rate() const {
+        return searches > 0 ? static_cast<double>(failures) / searches : 0.0;
+    }
+    
+    // El costo que el adaptativo minimiza, con sus mismos pesos
+    double cost() const {
+        return probes_per_search() + AdaptiveFit::FAILURE_COST * failure_rate() +
+               AdaptiveFit::FRAGMENTATION_COST * mean_fragmentation;
+    }
+};
+
+// Reproduce `ops` con cada algoritmo (un único despacho por algoritmo)
+template <class FreeIndex>
+std::vector<PolicyScore> evaluate_policies(Address total_memory, const std::vector<ReplayOp>& ops) {
+    std::vector<PolicyScore> scores;
+    for (size_t i = 0; i < ALGORITHM_NAMES.size(); i++) {
+        PolicyScore score{static_cast<AllocationAlgorithm>(i)};
+        DynamicMemoryManager<FreeIndex> manager(total_memory, score.algorithm);
+        double fragmentation = 0.0;
+        auto started = std::chrono::steady_clock::now();
+        manager.dispatch([&](auto& placement) {
+            Address start, size;
+            for (const auto& op : ops) {
+                if (op.op == 'A') {
+                    OpStatus status = manager.try_allocate_with(placement, op.process_name, op.size, start);
+                    if (status == OpStatus::OK || status == OpStatus::NO_MEMORY) {
+                        score.searches++;
+                        score.failures += status == OpStatus::NO_MEMORY ? 1 : 0;
+                        score.probes += placement.probes;
+                    }
+                } else {
+                    manager.try_deallocate(op.process_name, start, size);
+                }
+                Address free_memory = manager.get_counters().free_memory;
+                fragmentation = free_memory > 0 ? 1.0 - static_cast<double>(manager.get_largest_free_block()) /
+                                                            static_cast<double>(free_memory)
+                                                : 0.0;
+                score.mean_fragmentation += fragmentation;
+            }
+        });
+        score.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        score.mean_fragmentation /= static_cast<double>(std::max<size_t>(ops.size(), 1));
+        score.final_fragmentation = fragmentation;
+        score.switches = manager.get_adaptive().switches.size();
+        scores.push_back(score);
+    }
+    return scores;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_BENCHMARK_HPP
@@ -0,0 +1,965 @@
+// Ramas del estado del asignador para explorar alternativas ("¿y si este A usara Best
+// Fit?", "¿y si P7 se liberara antes?"). Los bloques, el índice de libres y el mapa de
+// procesos viven en árboles persistentes: cada operación copia solo el camino que
+// toca y comparte el resto con las demás versiones, así que crear una rama cuesta O(1)
+// y cada A/L posterior agrega O(log n) nodos, sin copiar la lista de bloques.
+#ifndef MEMSIM_BRANCHING_HPP
+#define MEMSIM_BRANCHING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "memory_manager.hpp"
+#include "pipeline.hpp"
+#include "pool.hpp"
+
+namespace memsim {
+
+// Medida nula para los árboles que no necesitan agregados por subárbol
+struct NoMeasure {
+    template <class Value>
+    Address operator()(const Value&) const {
+        return 0;
+    }
+};
+
+// Treap persistente (copia de caminos). Los nodos son inmutables una vez enlazados y
+// llevan un contador de referencias: una versión es solo su raíz, copiarla suma una
+// referencia y modificarla crea nodos nuevos para el camino desde la raíz. Cada nodo
+// guarda el máximo de `Measure` en su subárbol, para buscar el primero que alcanza un
+// valor sin recorrer. Todas las versiones de un árbol comparten una arena de nodos.
+template <class Key, class Value, class Measure = NoMeasure>
+class PersistentTreap {
+public:
+    struct Node {
+        Key key;
+        Value value;
+        uint64_t priority;
+        Address measure; // máximo de Measure(value) en el subárbol
+        const Node* left;
+        const Node* right;
+        mutable uint32_t references;
+    };
+    
+    // Nodos de todas las versiones: salen de un pool y se cuentan los vivos
+    class Arena {
+    private:
+        NodePool pool;
+        XorShift64 rng{1};
+        std::vector<const Node*> pending; // pila de release (conserva su capacidad)
+        long long live = 0;
+        long long created = 0;
+        
+        friend class PersistentTreap;
+    
+    public:
+        long long live_nodes() const {
+            return live;
+        }
+        
+        long long created_nodes() const {
+            return created;
+        }
+    };
+
+private:
+    std::shared_ptr<Arena> arena;
+    const Node* root = nullptr;
+    size_t count = 0;
+    
+    static void retain(const Node* node) {
+        if (node != nullptr) {
+            node->references++;
+        }
+    }
+    
+    // Suelta una referencia; los nodos que quedan sin ninguna vuelven al pool
+    void release(const Node* node) {
+        std::vector<const Node*>& pending = arena->pending;
+        while (true) {
+            if (node != nullptr && --node->references == 0) {
+                pending.push_back(node->left);
+                pending.push_back(node->right);
+                node->~Node();
+                arena->pool.deallocate(const_cast<Node*>(node), sizeof(Node));
+                arena->live--;
+            }
+            if (pending.empty()) {
+                return;
+            }
+            node = pending.back();
+            pending.pop_back();
+        }
+    }
+    
+    // Nodo nuevo que se queda con una referencia a cada hijo (ya contada por el llamador)
+    const Node* make(const Key& key, const Value& value, uint64_t priority, const Node* left, const Node* right) {
+        Address measure = Measure()(value);
+        if (left != nullptr) {
+            measure = std::max(measure, left->measure);
+        }
+        if (right != nullptr) {
+            measure = std::max(measure, right->measure);
+        }
+        arena->live++;
+        arena->created++;
+        return new (arena->pool.allocate(sizeof(Node))) Node{key, value, priority, measure, left, right, 1};
+    }
+    
+    const Node* copy_with(const Node* node, const Node* left, const Node* right) {
+        return make(node->key, node->value, node->priority, left, right);
+    }
+    
+    // Las funciones siguientes reciben nodos prestados y devuelven raíces propias
+    
+    // Parte en claves < key y claves >= key
+    std::pair<const Node*, const Node*> split(const Node* node, const Key& key) {
+        if (node == nullptr) {
+            return {nullptr, nullptr};
+        }
+        if (node->key < key) {
+            auto [left, right] = split(node->right, key);
+            retain(node->left);
+            return {copy_with(node, node->left, left), right};
+        }
+        auto [left, right] = split(node->left, key);
+        retain(node->right);
+        return {left, copy_with(node, right, node->right)};
+    }
+    
+    // Une dos árboles con todas las claves de `a` menores que las de `b`
+    const Node* merge(const Node* a, const Node* b) {
+        if (a == nullptr || b == nullptr) {
+            const Node* node = a != nullptr ? a : b;
+            retain(node);
+            return node;
+        }
+        if (a->priority > b->priority) {
+            retain(a->left);
+            return copy_with(a, a->left, merge(a->right, b));
+        }
+        retain(b->right);
+        return copy_with(b, merge(a, b->left), b->right);
+    }
+    
+    const Node* insert(const Node* node, const Key& key, const Value& value, uint64_t priority) {
+        if (node == nullptr) {
+            return make(key, value, priority, nullptr, nullptr);
+        }
+        if (priority > node->priority) {
+            auto [left, right] = split(node, key);
+            return make(key, value, priority, left, right);
+        }
+        if (key < node->key) {
+            retain(node->right);
+            return copy_with(node, insert(node->left, key, value, priority), node->right);
+        }
+        retain(node->left);
+        return copy_with(node, node->left, insert(node->right, key, value, priority));
+    }
+    
+    // Reemplaza el valor de `key`, que debe existir
+    const Node* assign(const Node* node, const Key& key, const Value& value) {
+        if (key < node->key) {
+            retain(node->right);
+            return copy_with(node, assign(node->left, key, value), node->right);
+        }
+        if (node->key < key) {
+            retain(node->left);
+            return copy_with(node, node->left, assign(node->right, key, value));
+        }
+        retain(node->left);
+        retain(node->right);
+        return make(node->key, value, node->priority, node->left, node->right);
+    }
+    
+    // Quita `key`, que debe existir
+    const Node* erase(const Node* node, const Key& key) {
+        if (key < node->key) {
+            retain(node->right);
+            return copy_with(node, erase(node->left, key), node->right);
+        }
+        if (node->key < key) {
+            retain(node->left);
+            return copy_with(node, node->left, erase(node->right, key));
+        }
+        return merge(node->left, node->right);
+    }
+    
+    // Reemplaza la raíz por la nueva versión y suelta la anterior
+    void replace_root(const Node* node) {
+        release(root);
+        root = node;
+    }
+    
+    static const Node* find_reaching(const Node* node, Address at_least, const Key* from) {
+        if (node == nullptr || node->measure < at_least) {
+            return nullptr;
+        }
+        if (from != nullptr && node->key < *from) {
+            return find_reaching(node->right, at_least, from);
+        }
+        if (const Node* found = find_reaching(node->left, at_least, from)) {
+            return found;
+        }
+        if (Measure()(node->value) >= at_least) {
+            return node;
+        }
+        return find_reaching(node->right, at_least, nullptr);
+    }
+    
+    template <class Function>
+    static void visit(const Node* node, Function& function) {
+        std::vector<const Node*> stack;
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            function(node->key, node->value);
+            node = node->right;
+        }
+    }
+    
+    // Orden de las claves, prioridades de montículo y medidas; devuelve los nodos
+    static bool check(const Node* node, const Key* low, const Key* high, size_t& nodes) {
+        if (node == nullptr) {
+            return true;
+        }
+        nodes++;
+        Address measure = Measure()(node->value);
+        for (const Node* child : {node->left, node->right}) {
+            if (child != nullptr) {
+                if (child->priority > node->priority) {
+                    return false;
+                }
+                measure = std::max(measure, child->measure);
+            }
+        }
+        if ((low != nullptr && !(*low < node->key)) || (high != nullptr && !(node->key < *high)) ||
+            measure != node->measure) {
+            return false;
+        }
+        return check(node->left, low, &node->key, nodes) && check(node->right, &node->key, high, nodes);
+    }
+
+public:
+    explicit PersistentTreap(std::shared_ptr<Arena> nodes) : arena(std::move(nodes)) {}
+    
+    // Copiar una versión cuesta O(1): comparte la raíz
+    PersistentTreap(const PersistentTreap& other) : arena(other.arena), root(other.root), count(other.count) {
+        retain(root);
+    }
+    
+    PersistentTreap& operator=(const PersistentTreap& other) {
+        retain(other.root);
+        release(root);
+        arena = other.arena;
+        root = other.root;
+        count = other.count;
+        return *this;
+    }
+    
+    ~PersistentTreap() {
+        release(root);
+    }
+    
+    size_t size() const {
+        return count;
+    }
+    
+    bool empty() const {
+        return root == nullptr;
+    }
+    
+    // Nodo con la clave `key`, o nullptr
+    template <class K>
+    const Node* find(const K& key) const {
+        const Node* node = root;
+        while (node != nullptr) {
+            if (key < node->key) {
+                node = node->left;
+            } else if (node->key < key) {
+                node = node->right;
+            } else {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+    
+    // Primer nodo con clave >= key, o nullptr
+    const Node* lower_bound(const Key& key) const {
+        const Node* found = nullptr;
+        for (const Node* node = root; node != nullptr;) {
+            if (node->key < key) {
+                node = node->right;
+            } else {
+                found = node;
+                node = node->left;
+            }
+        }
+        return found;
+    }
+    
+    // Último nodo con clave <= key, o nullptr
+    const Node* floor(const Key& key) const {
+        const Node* found = nullptr;
+        for (const Node* node = root; node != nullptr;) {
+            if (key < node->key) {
+                node = node->left;
+            } else {
+                found = node;
+                node = node->right;
+            }
+        }
+        return found;
+    }
+    
+    const Node* last() const {
+        const Node* node = root;
+        while (node != nullptr && node->right != nullptr) {
+            node = node->right;
+        }
+        return node;
+    }
+    
+    // Máximo de Measure en todo el árbol
+    Address max_measure() const {
+        return root == nullptr ? 0 : root->measure;
+    }
+    
+    // Primer nodo (en orden de clave, desde `from` si no es nullptr) cuyo valor mide al
+    // menos `at_least`. Los subárboles que no alcanzan se saltan enteros.
+    const Node* first_reaching(Address at_least, const Key* from = nullptr) const {
+        return find_reaching(root, at_least, from);
+    }
+    
+    void insert(const Key& key, const Value& value) {
+        replace_root(insert(root, key, value, arena->rng.next()));
+        count++;
+    }
+    
+    void assign(const Key& key, const Value& value) {
+        replace_root(assign(root, key, value));
+    }
+    
+    void erase(const Key& key) {
+        replace_root(erase(root, key));
+        count--;
+    }
+    
+    void clear() {
+        replace_root(nullptr);
+        count = 0;
+    }
+    
+    // Recorre en orden de clave llamando function(clave, valor)
+    template <class Function>
+    void for_each(Function&& function) const {
+        visit(root, function);
+    }
+    
+    bool check(std::string& problem) const {
+        size_t nodes = 0;
+        if (!check(root, nullptr, nullptr, nodes)) {
+            problem = "arbol persistente con orden, prioridad o medida incorrectos";
+            return false;
+        }
+        if (nodes != count) {
+            problem = "arbol persistente con " + std::to_string(nodes) + " nodos y " + std::to_string(count) +
+                      " elementos registrados";
+            return false;
+        }
+        return true;
+    }
+};
+
+// Bloque de una rama; los libres llevan su orden de entrada a las listas de TLSF
+struct BranchBlock {
+    Address size;
+    bool is_free;
+    Address requested = 0;
+    long long list_order = 0;
+    std::string process_name;
+};
+
+// Medida de los bloques: el tamano si está libre, para buscar el primero que quepa
+struct FreeSpan {
+    Address operator()(const BranchBlock& block) const {
+        return block.is_free ? block.size : 0;
+    }
+};
+
+using BranchBlockTree = PersistentTreap<Address, BranchBlock, FreeSpan>;
+using BranchSizeTree = PersistentTreap<std::pair<Address, Address>, char>;   // (tamano, inicio)
+using BranchListTree = PersistentTreap<std::pair<int, long long>, Address>; // (lista, -orden) -> inicio
+using BranchProcessTree = PersistentTreap<std::string, Address>;
+
+// Estado completo de una rama; copiarlo es O(1)
+struct BranchState {
+    BranchBlockTree blocks;       // inicio -> bloque
+    BranchSizeTree free_by_size;  // Best Fit y Worst Fit
+    BranchListTree lists;         // listas segregadas de TLSF (solo con TLSF)
+    BranchProcessTree processes;  // proceso -> inicio
+    MemoryCounters counters;
+    AllocationAlgorithm algorithm = AllocationAlgorithm::FIRST_FIT;
+    bool lists_active = false;
+    long long list_order = 0;     // entradas a las listas hasta ahora
+    Address rover = 0;            // Next Fit
+};
+
+// Conjunto de ramas con nombre y la rama vigente. Reproduce las decisiones de
+// DynamicMemoryManager con la misma forma de bloques (sin listas rápidas): A/L sobre la
+// rama vigente, ALG por rama, y BRANCH/SWITCH/DROP para crear, cambiar y borrar ramas.
+class BranchExplorer {
+public:
+    using Branches = std::map<std::string, BranchState, std::less<>>;
+    
+    static constexpr std::string_view MAIN_BRANCH = "main";
+
+private:
+    Address total_memory;
+    BlockLayout layout;
+    std::shared_ptr<BranchBlockTree::Arena> block_nodes = std::make_shared<BranchBlockTree::Arena>();
+    std::shared_ptr<BranchSizeTree::Arena> size_nodes = std::make_shared<BranchSizeTree::Arena>();
+    std::shared_ptr<BranchListTree::Arena> list_nodes = std::make_shared<BranchListTree::Arena>();
+    std::shared_ptr<BranchProcessTree::Arena> process_nodes = std::make_shared<BranchProcessTree::Arena>();
+    Branches branches;
+    Branches::iterator current;
+    
+    static int list_of(Address size) {
+        int fl, sl;
+        SegregatedFreeLists::mapping(size, fl, sl);
+        return fl * SegregatedFreeLists::SL_COUNT + sl;
+    }
+    
+    // Alta y baja de un bloque libre en los índices; devuelve su orden en las listas
+    static long long add_free(BranchState& state, Address start, Address size) {
+        state.free_by_size.insert({size, start}, 0);
+        long long order = 0;
+        if (state.lists_active) {
+            order = ++state.list_order;
+            state.lists.insert({list_of(size), -order}, start);
+        }
+        state.counters.free_memory += size;
+        state.counters.free_blocks++;
+        return order;
+    }
+    
+    static void remove_free(BranchState& state, Address start, const BranchBlock& block) {
+        state.free_by_size.erase({block.size, start});
+        if (state.lists_active) {
+            state.lists.erase({list_of(block.size), -block.list_order});
+        }
+        state.counters.free_memory -= block.size;
+        state.counters.free_blocks--;
+    }
+    
+    // Las listas de TLSF se llevan solo con TLSF; al activarlas se cargan en orden de
+    // dirección, como SegregatedFreeLists (cuesta O(n) una vez por rama)
+    static void track_lists(BranchState& state, bool enabled) {
+        if (state.lists_active == enabled) {
+            return;
+        }
+        state.lists_active = enabled;
+        state.lists.clear();
+        if (!enabled) {
+            return;
+        }
+        std::vector<std::pair<Address, BranchBlock>> free_blocks;
+        state.blocks.for_each([&](Address start, const BranchBlock& block) {
+            if (block.is_free) {
+                free_blocks.emplace_back(start, block);
+            }
+        });
+        for (auto& [start, block] : free_blocks) {
+            block.list_order = ++state.list_order;
+            state.lists.insert({list_of(block.size), -block.list_order}, start);
+            state.blocks.assign(start, block);
+        }
+    }
+    
+    // Inicio del hueco que elige el algoritmo de la rama, o -1
+    static Address select(const BranchState& state, Address size) {
+        Address largest = state.blocks.max_measure();
+        switch (state.algorithm) {
+            case AllocationAlgorithm::BEST_FIT: {
+                auto node = state.free_by_size.lower_bound({size, LLONG_MIN});
+                return node == nullptr ? -1 : node->key.second;
+            }
+            case AllocationAlgorithm::WORST_FIT:
+                return largest < size ? -1 : state.free_by_size.lower_bound({largest, LLONG_MIN})->key.second;
+            case AllocationAlgorithm::NEXT_FIT: {
+                if (largest < size) {
+                    return -1;
+                }
+                // Desde el bloque que contiene la posición y, si no hay, desde el principio
+                Address from = state.blocks.floor(state.rover)->key;
+                auto node = state.blocks.first_reaching(size, &from);
+                return (node != nullptr ? node : state.blocks.first_reaching(size))->key;
+            }
+            case AllocationAlgorithm::TLSF: {
+                int fl, sl;
+                if (!SegregatedFreeLists::search_mapping(size, fl, sl)) {
+                    return -1;
+                }
+                auto node = state.lists.lower_bound({fl * SegregatedFreeLists::SL_COUNT + sl, LLONG_MIN});
+                return node == nullptr ? -1 : node->value;
+            }
+            case AllocationAlgorithm::FIRST_FIT:
+            case AllocationAlgorithm::ADAPTIVE: // las ramas no lo admiten (ALG 1 a 5)
+                break;
+        }
+        auto node = state.blocks.first_reaching(size);
+        return node == nullptr ? -1 : node->key;
+    }
+
+public:
+    explicit BranchExplorer(Address size, AllocationAlgorithm algorithm = AllocationAlgorithm::FIRST_FIT,
+                            const BlockLayout& block_layout = BlockLayout())
+        : total_memory(size), layout(block_layout) {
+        BranchState state{BranchBlockTree(block_nodes), BranchSizeTree(size_nodes), BranchListTree(list_nodes),
+                          BranchProcessTree(process_nodes), MemoryCounters(), algorithm};
+        state.blocks.insert(0, BranchBlock{total_memory, true, 0, 0, {}});
+        add_free(state, 0, total_memory);
+        track_lists(state, algorithm == AllocationAlgorithm::TLSF);
+        current = branches.emplace(std::string(MAIN_BRANCH), std::move(state)).first;
+    }
+    
+    BranchExplorer(const BranchExplorer&) = delete;
+    BranchExplorer& operator=(const BranchExplorer&) = delete;
+    
+    Address get_total_memory() const {
+        return total_memory;
+    }
+    
+    const Branches& get_branches() const {
+        return branches;
+    }
+    
+    const std::string& current_branch() const {
+        return current->first;
+    }
+    
+    const BranchState& state() const {
+        return current->second;
+    }
+    
+    // Nodos vivos entre todas las ramas (los compartidos cuentan una vez)
+    long long live_nodes() const {
+        return block_nodes->live_nodes() + size_nodes->live_nodes() + list_nodes->live_nodes() +
+               process_nodes->live_nodes();
+    }
+    
+    long long created_nodes() const {
+        return block_nodes->created_nodes() + size_nodes->created_nodes() + list_nodes->created_nodes() +
+               process_nodes->created_nodes();
+    }
+    
+    void set_algorithm(AllocationAlgorithm algorithm) {
+        current->second.algorithm = algorithm;
+        track_lists(current->second, algorithm == AllocationAlgorithm::TLSF);
+    }
+    
+    // Nueva rama con una copia del estado vigente; la rama vigente no cambia. Devuelve
+    // false si el nombre ya existe.
+    bool branch(std::string_view name) {
+        if (branches.find(name) != branches.end()) {
+            return false;
+        }
+        branches.emplace(std::string(name), current->second);
+        return true;
+    }
+    
+    // Pasar a otra rama; devuelve false si no existe
+    bool switch_to(std::string_view name) {
+        auto it = branches.find(name);
+        if (it == branches.end()) {
+            return false;
+        }
+        current = it;
+        return true;
+    }
+    
+    // Borrar una rama que no sea la vigente; sus nodos no compartidos vuelven al pool
+    bool drop(std::string_view name) {
+        auto it = branches.find(name);
+        if (it == branches.end() || it == current) {
+            return false;
+        }
+        branches.erase(it);
+        return true;
+    }
+    
+    // A sobre la rama vigente, con las mismas reglas que BlockStore::allocate_with_policy
+    OpStatus try_allocate(std::string_view process_name, Address size, Address& start) {
+        BranchState& state = current->second;
+        state.counters.operations++;
+        start = -1;
+        if (size <= 0) {
+            return OpStatus::INVALID_SIZE;
+        }
+        if (state.processes.find(process_name) != nullptr) {
+            return OpStatus::DUPLICATE;
+        }
+        
+        Address block_size = layout.block_size(size);
+        Address hole = select(state, block_size);
+        if (hole < 0) {
+            state.counters.failed_allocations++;
+            return OpStatus::NO_MEMORY;
+        }
+        
+        BranchBlock free_block = state.blocks.find(hole)->value;
+        Address remaining = free_block.size - block_size;
+        if (remaining > 0 && remaining < layout.min_split) {
+            block_size = free_block.size; // astilla menor que min_split: se entrega al proceso
+            remaining = 0;
+        }
+        remove_free(state, hole, free_block);
+        if (remaining > 0) {
+            long long order = add_free(state, hole + block_size, remaining);
+            state.blocks.insert(hole + block_size, BranchBlock{remaining, true, 0, order, {}});
+        }
+        state.blocks.assign(hole, BranchBlock{block_size, false, size, 0, std::string(process_name)});
+        state.processes.insert(std::string(process_name), hole);
+        state.counters.used_memory += block_size;
+        state.counters.requested_memory += size;
+        state.counters.header_memory += layout.header;
+        if (state.algorithm == AllocationAlgorithm::NEXT_FIT) {
+            state.rover = hole + block_size;
+        }
+        start = hole;
+        return OpStatus::OK;
+    }
+    
+    // L sobre la rama vigente: libera y fusiona con los vecinos libres
+    OpStatus try_deallocate(std::string_view process_name, Address& start, Address& size) {
+        BranchState& state = current->second;
+        state.counters.operations++;
+        start = -1;
+        size = 0;
+        auto process = state.processes.find(process_name);
+        if (process == nullptr) {
+            return OpStatus::NOT_FOUND;
+        }
+        start = process->value;
+        state.processes.erase(process->key);
+        
+        BranchBlock block = state.blocks.find(start)->value;
+        size = block.size;
+        state.counters.used_memory -= block.size;
+        state.counters.requested_memory -= block.requested;
+        state.counters.header_memory -= layout.header;
+        
+        Address hole_start = start;
+        Address hole_size = block.size;
+        auto next = state.blocks.lower_bound(start + 1);
+        if (next != nullptr && next->value.is_free) {
+            Address next_start = next->key;
+            remove_free(state, next_start, next->value);
+            hole_size += next->value.size;
+            state.blocks.erase(next_start);
+        }
+        auto previous = start > 0 ? state.blocks.floor(start - 1) : nullptr;
+        if (previous != nullptr && previous->value.is_free) {
+            hole_start = previous->key;
+            remove_free(state, hole_start, previous->value);
+            hole_size += previous->value.size;
+            state.blocks.erase(start);
+        }
+        long long order = add_free(state, hole_start, hole_size);
+        state.blocks.assign(hole_start, BranchBlock{hole_size, true, 0, order, {}});
+        return OpStatus::OK;
+    }
+    
+    // Bloques de una rama en el formato de BlockStore::blocks()
+    static std::vector<MemoryBlock> blocks_of(const BranchState& state) {
+        std::vector<MemoryBlock> blocks;
+        blocks.reserve(state.blocks.size());
+        state.blocks.for_each([&](Address start, const BranchBlock& block) {
+            blocks.emplace_back(start, block.size, block.process_name, block.is_free);
+            blocks.back().requested = block.requested;
+        });
+        return blocks;
+    }
+    
+    // Verifica una rama recorriéndola entera: árboles bien formados, bloques contiguos
+    // sin dos libres seguidos, índices y contadores coherentes con los bloques
+    bool check_invariants(const BranchState& state, std::string& problem) const {
+        if (!state.blocks.check(problem) || !state.free_by_size.check(problem) || !state.lists.check(problem) ||
+            !state.processes.check(problem)) {
+            return false;
+        }
+        Address expected = 0;
+        Address used = 0, free_memory = 0;
+        size_t free_blocks = 0, processes = 0;
+        bool previous_free = false;
+        state.blocks.for_each([&](Address start, const BranchBlock& block) {
+            if (!problem.empty()) {
+                return;
+            }
+            if (start != expected || block.size <= 0) {
+                problem = "bloque en " + std::to_string(start) + " no continua al anterior";
+            } else if (block.is_free) {
+                if (previous_free) {
+                    problem = "dos bloques libres contiguos en " + std::to_string(start);
+                } else if (state.free_by_size.find(std::make_pair(block.size, start)) == nullptr ||
+                           (state.lists_active &&
+                            state.lists.find(std::make_pair(list_of(block.size), -block.list_order)) == nullptr)) {
+                    problem = "bloque libre en " + std::to_string(start) + " fuera del indice";
+                }
+                free_blocks++;
+                free_memory += block.size;
+            } else {
+                auto process = state.processes.find(block.process_name);
+                if (process == nullptr || process->value != start) {
+                    problem = "proceso " + block.process_name + " sin ubicacion correcta";
+                }
+                processes++;
+                used += block.size;
+            }
+            previous_free = block.is_free;
+            expected = start + block.size;
+        });
+        if (problem.empty() && expected != total_memory) {
+            problem = "los bloques cubren " + std::to_string(expected) + " de " + std::to_string(total_memory);
+        }
+        if (problem.empty() && (free_blocks != state.free_by_size.size() || processes != state.processes.size() ||
+                                (state.lists_active && free_blocks != state.lists.size()))) {
+            problem = "indices con elementos de mas";
+        }
+        if (problem.empty() && (used != state.counters.used_memory || free_memory != state.counters.free_memory ||
+                                static_cast<long long>(free_blocks) != state.counters.free_blocks)) {
+            problem = "contadores distintos de los bloques";
+        }
+        return problem.empty();
+    }
+};
+
+// Resultado de reproducir una traza con ramas
+struct BranchRun {
+    long long lines = 0;
+    long long allocations = 0;     // A atendidos
+    long long failed = 0;          // A sin hueco
+    long long releases = 0;        // L atendidos
+    long long rejected = 0;        // tamano inválido, proceso repetido o inexistente
+    long long branch_commands = 0; // BRANCH, SWITCH, DROP y ALG válidos
+    long long invalid_commands = 0;
+    long long other_commands = 0;
+    double seconds = 0.0;
+};
+
+// Reproduce A, L, ALG n (1 a 5) y BRANCH/SWITCH/DROP <rama> de la traza sobre la rama
+// vigente. Un BRANCH con nombre repetido, un SWITCH o DROP a una rama inexistente (o
+// DROP de la vigente) cuentan como inválidos y no cambian nada.
+inline BranchRun replay_branch_trace(std::istream& trace, BranchExplorer& explorer) {
+    BranchRun run;
+    std::string line;
+    ParsedCommand parsed;
+    int line_number = 0;
+    auto started = std::chrono::steady_clock::now();
+    while (std::getline(trace, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) {
+            continue;
+        }
+        run.lines++;
+        
+        Address start, size;
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            OpStatus status = explorer.try_allocate(parsed.process_name, parsed.size, start);
+            run.allocations += status == OpStatus::OK ? 1 : 0;
+            run.failed += status == OpStatus::NO_MEMORY ? 1 : 0;
+            run.rejected += status != OpStatus::OK && status != OpStatus::NO_MEMORY ? 1 : 0;
+            continue;
+        }
+        if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+            bool ok = explorer.try_deallocate(parsed.process_name, start, size) == OpStatus::OK;
+            run.releases += ok ? 1 : 0;
+            run.rejected += ok ? 0 : 1;
+            continue;
+        }
+        
+        std::string_view rest(parsed.line);
+        std::string command(next_token(rest));
+        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+        std::string_view argument = next_token(rest);
+        bool ok = false;
+        if (command == "BRANCH" || command == "SWITCH" || command == "DROP") {
+            ok = !argument.empty() && (command == "BRANCH"   ? explorer.branch(argument)
+                                       : command == "SWITCH" ? explorer.switch_to(argument)
+                                                             : explorer.drop(argument));
+        } else if (command == "ALG") {
+            int number;
+            ok = parse_int(argument, number) && number >= 1 && number <= 5;
+            if (ok) {
+                explorer.set_algorithm(static_cast<AllocationAlgorithm>(number - 1));
+            }
+        } else {
+            run.other_commands++;
+            continue;
+        }
+        run.branch_commands += ok ? 1 : 0;
+        run.invalid_commands += ok ? 0 : 1;
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return run;
+}
+
+// Resultado de la verificación con ramas sintéticas
+struct BranchCheck {
+    long long warm_operations = 0;
+    size_t warm_blocks = 0;          // bloques del estado de partida
+    int branches = 0;
+    int operations_per_branch = 0;
+    double fork_seconds = 0.0;       // crear todas las ramas
+    double copy_seconds = 0.0;       // copiar el gestor una vez por rama (la alternativa O(n))
+    long long fork_nodes = 0;        // nodos creados al ramificar (debe ser 0)
+    double nodes_per_operation = 0.0; // nodos nuevos por A/L dentro de las ramas
+    long long live_nodes_full = 0;   // con todas las ramas
+    long long live_nodes_dropped = 0; // tras borrar la mitad
+    long long compared = 0;          // operaciones comparadas con el gestor
+    bool ok = true;
+    std::string problem;
+};
+
+// Calienta la rama principal y una copia de DynamicMemoryManager con `warm_operations`
+// A/L al azar (55% A), y luego abre `branches` ramas desde ese estado, cada una con el
+// algoritmo i % 5 y `operations_per_branch` A/L propios. Cada rama se compara paso a
+// paso con una copia del gestor (resultado, inicio y al final la lista de bloques) y se
+// verifica entera. Mide cuántos nodos agrega cada operación y lo que cuesta la copia.
+template <class Manager>
+BranchCheck run_branch_check(Manager& manager, const BlockLayout& layout, long long warm_operations, int branches,
+                             int operations_per_branch, int max_size, uint64_t seed) {
+    BranchCheck check;
+    check.warm_operations = warm_operations;
+    check.branches = branches;
+    check.operations_per_branch = operations_per_branch;
+    BranchExplorer explorer(manager.get_total_memory(), manager.get_algorithm(), layout);
+    XorShift64 rng(seed);
+    std::vector<std::string> live;
+    long long next_name = 0;
+    
+    // Una operación al azar sobre la rama vigente y `reference`; false ante una diferencia
+    auto step = [&](auto& reference, std::vector<std::string>& names) {
+        Address start, size, expected_start, expected_size;
+        OpStatus status, expected;
+        if (names.empty() || rng.below(100) < 55) {
+            std::string name = "P" + std::to_string(next_name++);
+            Address request = 1 + rng.below(max_size);
+            status = explorer.try_allocate(name, request, start);
+            expected = reference.try_allocate(name, request, expected_start);
+            if (status == OpStatus::OK) {
+                names.push_back(std::move(name));
+            }
+        } else {
+            size_t index = static_cast<size_t>(rng.below(static_cast<int>(names.size())));
+            std::swap(names[index], names.back());
+            status = explorer.try_deallocate(names.back(), start, size);
+            expected = reference.try_deallocate(names.back(), expected_start, expected_size);
+            names.pop_back();
+        }
+        check.compared++;
+        if (status != expected || (status == OpStatus::OK && start != expected_start)) {
+            check.problem = "la rama " + explorer.current_branch() + " dio " + std::string(op_status_name(status)) +
+                            " en " + std::to_string(start) + " y el gestor " + std::string(op_status_name(expected)) +
+                            " en " + std::to_string(expected_start);
+            return false;
+        }
+        return true;
+    };
+    
+    auto same_blocks = [&](const BlockList& expected) {
+        std::vector<MemoryBlock> blocks = BranchExplorer::blocks_of(explorer.state());
+        bool same = blocks.size() == expected.size();
+        auto other = expected.begin();
+        for (size_t i = 0; same && i < blocks.size(); i++, ++other) {
+            same = blocks[i].start == other->start && blocks[i].size == other->size &&
+                   blocks[i].is_free == other->is_free && blocks[i].process_name == other->process_name;
+        }
+        if (!same) {
+            check.problem = "la rama " + explorer.current_branch() + " termina con bloques distintos a los del gestor";
+        }
+        return same && explorer.check_invariants(explorer.state(), check.problem);
+    };
+    
+    for (long long i = 0; i < warm_operations; i++) {
+        if (!step(manager, live)) {
+            check.ok = false;
+            return check;
+        }
+    }
+    if (!same_blocks(manager.blocks())) {
+        check.ok = false;
+        return check;
+    }
+    check.warm_blocks = manager.blocks().size();
+    
+    long long grown = 0;
+    for (int b = 0; b < branches; b++) {
+        std::string name = "r" + std::to_string(b);
+        long long created = explorer.created_nodes();
+        auto forked = std::chrono::steady_clock::now();
+        explorer.branch(name);
+        check.fork_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - forked).count();
+        check.fork_nodes += explorer.created_nodes() - created;
+        
+        auto copied = std::chrono::steady_clock::now();
+        Manager reference(manager);
+        check.copy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - copied).count();
+        
+        explorer.switch_to(name);
+        AllocationAlgorithm algorithm = static_cast<AllocationAlgorithm>(b % 5);
+        explorer.set_algorithm(algorithm);
+        reference.set_algorithm(algorithm);
+        std::vector<std::string> names = live;
+        long long before = explorer.live_nodes();
+        for (int i = 0; i < operations_per_branch; i++) {
+            if (!step(reference, names)) {
+                check.ok = false;
+                return check;
+            }
+        }
+        grown += explorer.live_nodes() - before;
+        if (!same_blocks(reference.blocks())) {
+            check.ok = false;
+            return check;
+        }
+        explorer.switch_to(BranchExplorer::MAIN_BRANCH);
+    }
+    check.nodes_per_operation = branches > 0 ? static_cast<double>(grown) / (static_cast<double>(branches) *
+                                                                           operations_per_branch) : 0.0;
+    
+    check.live_nodes_full = explorer.live_nodes();
+    for (int b = 0; b < branches; b += 2) {
+        explorer.drop("r" + std::to_string(b));
+    }
+    check.live_nodes_dropped = explorer.live_nodes();
+    for (const auto& [name, state] : explorer.get_branches()) {
+        if (!explorer.check_invariants(state, check.problem)) {
+            check.problem = "rama " + name + ": " + check.problem;
+            check.ok = false;
+            return check;
+        }
+    }
+    return check;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_BRANCHING_HPP
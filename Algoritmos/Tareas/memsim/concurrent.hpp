@@ -0,0 +1,714 @@
+// Modo concurrente: varios hilos emiten A/L contra un gestor compartido con
+// distintas estrategias de sincronización, y cada corrida se verifica en serie.
+#ifndef MEMSIM_CONCURRENT_HPP
+#define MEMSIM_CONCURRENT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "memory_manager.hpp"
+
+namespace memsim {
+
+// Gestor sin presentación que usan todas las estrategias y la verificación serial
+using ConcurrentManager = DynamicMemoryManager<>;
+
+// Estrategias de sincronización disponibles en el modo concurrente
+enum class LockStrategy {
+    GLOBAL_MUTEX,   // un mutex para todo el gestor
+    STRIPED,        // un mutex por franja de direcciones
+    LOCK_FREE_SMALL,// mutex global + listas libres sin bloqueo para tamanos pequenos
+    ARENAS          // una arena por hilo (o por núcleo) con robo entre arenas
+};
+
+constexpr const char* lock_strategy_name(LockStrategy strategy) {
+    switch (strategy) {
+        case LockStrategy::GLOBAL_MUTEX: return "global";
+        case LockStrategy::STRIPED: return "striped";
+        case LockStrategy::LOCK_FREE_SMALL: return "lockfree";
+        case LockStrategy::ARENAS: return "arenas";
+    }
+    return "desconocida";
+}
+
+// Registro de una operación concurrente. `sequence` se obtiene dentro de la sección
+// crítica (o justo antes/después del CAS en la caché sin bloqueo), así que ordenar por
+// él da una linealización válida de la ejecución.
+struct ConcurrentOpRecord {
+    uint64_t sequence;
+    int thread;
+    int index;      // número de operación dentro del hilo (forma el nombre T<hilo>-<index>)
+    char op;        // 'A' = asignar, 'F' = liberar por dirección, 'D' = devolver al gestor un
+                    // bloque de la caché al terminar la corrida
+    Address size;
+    Address start;  // dirección global resultante (-1 si falló)
+    int region;     // franja que atendió la operación, -1 = caché sin bloqueo / sin franja
+    OpStatus status;
+};
+
+// Generador xorshift64 para cargas de trabajo reproducibles por hilo
+struct XorShift64 {
+    uint64_t state;
+    
+    explicit XorShift64(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ULL + 1) {}
+    
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    
+    int below(int bound) {
+        return static_cast<int>(next() % static_cast<uint64_t>(bound));
+    }
+};
+
+struct ConcurrentRunResult;
+
+// Interfaz común de los asignadores concurrentes
+class ConcurrentAllocator {
+public:
+    virtual ~ConcurrentAllocator() = default;
+    virtual Address allocate(int thread, const std::string& process_name, Address size,
+                             ConcurrentOpRecord& record) = 0;
+    virtual void release(Address start, Address size, ConcurrentOpRecord& record) = 0;
+    // Devolver al gestor los bloques retenidos fuera de él (la caché sin bloqueo) cuando
+    // ya no quedan hilos, con un registro 'D' por bloque
+    virtual void drain(std::vector<ConcurrentOpRecord>&) {}
+    // Estadísticas propias de la estrategia, al terminar la corrida
+    virtual void collect(ConcurrentRunResult&) const {}
+};
+
+// Estrategia 1: un único gestor protegido por un mutex global
+class GlobalLockAllocator : public ConcurrentAllocator {
+private:
+    ConcurrentManager manager;
+    std::mutex mutex;
+    std::atomic<uint64_t>& sequence;
+    
+public:
+    GlobalLockAllocator(Address total_memory, AllocationAlgorithm algorithm, std::atomic<uint64_t>& seq)
+        : manager(total_memory, algorithm), sequence(seq) {}
+    
+    Address allocate(int, const std::string& process_name, Address size, ConcurrentOpRecord& record) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        record.status = manager.try_allocate(process_name, size, record.start);
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        record.region = 0;
+        return record.start;
+    }
+    
+    void release(Address start, Address, ConcurrentOpRecord& record) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        record.status = manager.try_release_at(start, record.size);
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        record.region = 0;
+    }
+};
+
+// Estrategia 2: la memoria se divide en franjas contiguas de direcciones, cada una con
+// su propio gestor y mutex. La búsqueda recorre las franjas en orden de
+// dirección (mismo criterio del algoritmo, salvo que un bloque no cruza franjas) y
+// bloquea solo la franja que examina; la liberación localiza la franja por dirección.
+class StripedLockAllocator : public ConcurrentAllocator {
+private:
+    struct Stripe {
+        std::mutex mutex;
+        ConcurrentManager manager;
+        Address base;
+        
+        Stripe(Address base_address, Address size, AllocationAlgorithm algorithm)
+            : manager(size, algorithm), base(base_address) {}
+    };
+    
+    std::vector<std::unique_ptr<Stripe>> stripes;
+    Address stripe_size;
+    std::atomic<uint64_t>& sequence;
+    
+public:
+    StripedLockAllocator(Address total_memory, AllocationAlgorithm algorithm, int count, std::atomic<uint64_t>& seq)
+        : stripe_size(total_memory / count), sequence(seq) {
+        for (int i = 0; i < count; i++) {
+            Address size = (i == count - 1) ? total_memory - stripe_size * i : stripe_size;
+            stripes.push_back(std::make_unique<Stripe>(stripe_size * i, size, algorithm));
+        }
+    }
+    
+    static std::vector<Address> stripe_sizes(Address total_memory, int count) {
+        std::vector<Address> sizes(count, total_memory / count);
+        sizes.back() = total_memory - (total_memory / count) * (count - 1);
+        return sizes;
+    }
+    
+    Address allocate(int, const std::string& process_name, Address size, ConcurrentOpRecord& record) override {
+        int count = static_cast<int>(stripes.size());
+        for (int index = 0; index < count; index++) {
+            Stripe& stripe = *stripes[index];
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            Address local_start;
+            OpStatus status = stripe.manager.try_allocate(process_name, size, local_start);
+            if (status == OpStatus::OK) {
+                record.status = status;
+                record.start = stripe.base + local_start;
+                record.region = index;
+                record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+                return record.start;
+            }
+        }
+        record.status = OpStatus::NO_MEMORY;
+        record.start = -1;
+        record.region = -1;
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    
+    void release(Address start, Address, ConcurrentOpRecord& record) override {
+        int index = static_cast<int>(std::min<Address>(start / stripe_size, static_cast<Address>(stripes.size()) - 1));
+        Stripe& stripe = *stripes[index];
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        record.status = stripe.manager.try_release_at(start - stripe.base, record.size);
+        record.region = index;
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// Pilas de Treiber con nodos preasignados para guardar bloques libres por clase de
+// tamano exacto. La cabeza empaqueta índice (32 bits) y etiqueta (32 bits) para
+// evitar el problema ABA; los nodos nunca se liberan, solo se reciclan.
+class LockFreeSizeClassCache {
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+    
+    struct Node {
+        Address start = 0;
+        std::atomic<uint32_t> next{NIL};
+    };
+    
+    std::unique_ptr<Node[]> nodes;
+    std::unique_ptr<std::atomic<uint64_t>[]> heads; // [0] = nodos sin usar, [tamano] = clase
+    int max_size;
+    
+    static uint64_t pack(uint32_t index, uint64_t head) {
+        return (((head >> 32) + 1) << 32) | index;
+    }
+    
+    void push(std::atomic<uint64_t>& head, uint32_t index) {
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        do {
+            nodes[index].next.store(static_cast<uint32_t>(old_head), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old_head, pack(index, old_head),
+                                             std::memory_order_release, std::memory_order_acquire));
+    }
+    
+    uint32_t pop(std::atomic<uint64_t>& head) {
+        uint64_t old_head = head.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t index = static_cast<uint32_t>(old_head);
+            if (index == NIL) {
+                return NIL;
+            }
+            uint32_t next = nodes[index].next.load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old_head, pack(next, old_head),
+                                           std::memory_order_acquire, std::memory_order_acquire)) {
+                return index;
+            }
+        }
+    }
+    
+public:
+    LockFreeSizeClassCache(int largest_class, uint32_t capacity)
+        : nodes(new Node[capacity]), heads(new std::atomic<uint64_t>[largest_class + 1]), max_size(largest_class) {
+        for (int i = 0; i <= largest_class; i++) {
+            heads[i].store(NIL, std::memory_order_relaxed);
+        }
+        for (uint32_t i = 0; i < capacity; i++) {
+            push(heads[0], i);
+        }
+    }
+    
+    int largest_class() const {
+        return max_size;
+    }
+    
+    // Guardar un bloque liberado; falla si no quedan nodos
+    bool put(Address start, Address size) {
+        uint32_t index = pop(heads[0]);
+        if (index == NIL) {
+            return false;
+        }
+        nodes[index].start = start;
+        push(heads[size], index);
+        return true;
+    }
+    
+    // Tomar un bloque del tamano exacto pedido
+    bool take(Address size, Address& start) {
+        uint32_t index = pop(heads[size]);
+        if (index == NIL) {
+            return false;
+        }
+        start = nodes[index].start;
+        push(heads[0], index);
+        return true;
+    }
+};
+
+// Estrategia 3: los bloques pequenos liberados quedan en la caché sin bloqueo y se
+// reutilizan sin tocar el mutex; el resto pasa por el gestor con mutex global.
+// Para la caché, `sequence` se toma antes del push y después del pop, de modo que la
+// liberación de un bloque siempre queda ordenada antes de su reutilización.
+class LockFreeSmallAllocator : public ConcurrentAllocator {
+private:
+    GlobalLockAllocator backing;
+    LockFreeSizeClassCache cache;
+    std::atomic<uint64_t>& sequence;
+    
+public:
+    static constexpr int SMALL_CLASS_LIMIT = 32;
+    
+    LockFreeSmallAllocator(Address total_memory, AllocationAlgorithm algorithm, std::atomic<uint64_t>& seq)
+        : backing(total_memory, algorithm, seq),
+          cache(SMALL_CLASS_LIMIT, static_cast<uint32_t>(std::min<Address>(total_memory, 1 << 22))),
+          sequence(seq) {}
+    
+    Address allocate(int thread, const std::string& process_name, Address size, ConcurrentOpRecord& record) override {
+        if (size > 0 && size <= cache.largest_class() && cache.take(size, record.start)) {
+            record.status = OpStatus::OK;
+            record.region = -1;
+            record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+            return record.start;
+        }
+        return backing.allocate(thread, process_name, size, record);
+    }
+    
+    void release(Address start, Address size, ConcurrentOpRecord& record) override {
+        if (size <= cache.largest_class()) {
+            record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+            if (cache.put(start, size)) {
+                record.status = OpStatus::OK;
+                record.region = -1;
+                return;
+            }
+        }
+        backing.release(start, size, record);
+    }
+    
+    // Al terminar, los bloques aparcados siguen ocupados para el gestor: se liberan en él
+    void drain(std::vector<ConcurrentOpRecord>& drained) override {
+        int index = 0;
+        for (int size = 1; size <= cache.largest_class(); size++) {
+            Address start;
+            while (cache.take(size, start)) {
+                ConcurrentOpRecord record{0, -1, index++, 'D', size, start, -1, OpStatus::OK};
+                backing.release(start, size, record);
+                drained.push_back(record);
+            }
+        }
+    }
+};
+
+// Estadísticas de una arena al terminar una corrida
+struct ArenaStats {
+    Address base = 0;
+    Address size = 0;
+    long long used_memory = 0;
+    long long peak_used = 0;
+    long long local_allocations = 0;  // atendidas por la arena del propio hilo
+    long long stolen_from = 0;        // atendidas para hilos de otras arenas
+    long long steals = 0;             // solicitudes de su hilo atendidas por otra arena
+    long long largest_free_block = 0;
+    long long free_blocks = 0;
+};
+
+// Resultado de una corrida del modo concurrente
+struct ConcurrentRunResult {
+    int threads = 0;
+    long long operations = 0;
+    long long failed_allocations = 0;
+    long long cache_hits = 0;
+    long long steals = 0;
+    std::vector<ArenaStats> arenas;
+    double seconds = 0.0;
+    long long safety_violations = 0;   // solapamientos o liberaciones inválidas
+    long long replay_mismatches = 0;   // diferencias contra la reproducción serial
+};
+
+// Estrategia 4: la memoria se reparte en arenas, una por hilo o por núcleo, cada una
+// con su propio gestor y mutex. Un hilo asigna en su arena y solo si esta no
+// puede atender la solicitud roba espacio de las demás (en orden circular).
+class ArenaAllocator : public ConcurrentAllocator {
+private:
+    struct Arena {
+        std::mutex mutex;
+        ConcurrentManager manager;
+        Address base;
+        Address size;
+        long long peak_used = 0;
+        long long local_allocations = 0;
+        long long stolen_from = 0;
+        std::atomic<long long> steals{0};
+        
+        Arena(Address base_address, Address arena_size, AllocationAlgorithm algorithm)
+            : manager(arena_size, algorithm), base(base_address), size(arena_size) {}
+    };
+    
+    std::vector<std::unique_ptr<Arena>> arenas;
+    Address arena_size;
+    std::atomic<uint64_t>& sequence;
+    
+    // Intentar asignar en una arena (con su mutex tomado por el llamador)
+    bool try_arena(Arena& arena, int index, const std::string& process_name, Address size,
+                   ConcurrentOpRecord& record) {
+        Address local_start;
+        if (arena.manager.try_allocate(process_name, size, local_start) != OpStatus::OK) {
+            return false;
+        }
+        arena.peak_used = std::max(arena.peak_used, arena.manager.get_counters().used_memory);
+        record.status = OpStatus::OK;
+        record.start = arena.base + local_start;
+        record.region = index;
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+public:
+    ArenaAllocator(Address total_memory, AllocationAlgorithm algorithm, int count, std::atomic<uint64_t>& seq)
+        : arena_size(total_memory / count), sequence(seq) {
+        std::vector<Address> sizes = StripedLockAllocator::stripe_sizes(total_memory, count);
+        for (int i = 0; i < count; i++) {
+            arenas.push_back(std::make_unique<Arena>(arena_size * i, sizes[i], algorithm));
+        }
+    }
+    
+    Address allocate(int thread, const std::string& process_name, Address size, ConcurrentOpRecord& record) override {
+        int count = static_cast<int>(arenas.size());
+        int home = thread % count;
+        {
+            Arena& arena = *arenas[home];
+            std::lock_guard<std::mutex> lock(arena.mutex);
+            if (try_arena(arena, home, process_name, size, record)) {
+                arena.local_allocations++;
+                return record.start;
+            }
+        }
+        
+        // La arena local no alcanza: robar de las demás
+        for (int i = 1; i < count; i++) {
+            int victim = (home + i) % count;
+            Arena& arena = *arenas[victim];
+            std::lock_guard<std::mutex> lock(arena.mutex);
+            if (try_arena(arena, victim, process_name, size, record)) {
+                arena.stolen_from++;
+                arenas[home]->steals.fetch_add(1, std::memory_order_relaxed);
+                return record.start;
+            }
+        }
+        
+        record.status = OpStatus::NO_MEMORY;
+        record.start = -1;
+        record.region = -1;
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+    
+    void release(Address start, Address, ConcurrentOpRecord& record) override {
+        int index = static_cast<int>(std::min<Address>(start / arena_size, static_cast<Address>(arenas.size()) - 1));
+        Arena& arena = *arenas[index];
+        std::lock_guard<std::mutex> lock(arena.mutex);
+        record.status = arena.manager.try_release_at(start - arena.base, record.size);
+        record.region = index;
+        record.sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    void collect(ConcurrentRunResult& result) const override;
+};
+
+inline void ArenaAllocator::collect(ConcurrentRunResult& result) const {
+    for (const auto& arena : arenas) {
+        ArenaStats stats;
+        stats.base = arena->base;
+        stats.size = arena->size;
+        stats.used_memory = arena->manager.get_counters().used_memory;
+        stats.peak_used = arena->peak_used;
+        stats.local_allocations = arena->local_allocations;
+        stats.stolen_from = arena->stolen_from;
+        stats.steals = arena->steals.load(std::memory_order_relaxed);
+        stats.largest_free_block = arena->manager.get_largest_free_block();
+        stats.free_blocks = arena->manager.get_counters().free_blocks;
+        result.steals += stats.steals;
+        result.arenas.push_back(stats);
+    }
+}
+
+// Verifica la ejecución contra una reproducción serial en orden de `sequence`:
+// 1) seguridad: ninguna asignación solapa otra viva y cada liberación corresponde a
+//    un bloque vivo; 2) cada franja (o el gestor global) reproducida en serie con un
+//    gestor nuevo produce exactamente las mismas direcciones y resultados; 3) las
+//    operaciones de la caché sin bloqueo se reproducen sobre un modelo de la caché:
+//    cada acierto entrega un bloque aparcado de ese tamano, ningún bloque se aparca
+//    dos veces y al final los bloques devueltos ('D') son justo los que quedaban.
+inline void verify_concurrent_run(std::vector<ConcurrentOpRecord>& log, Address total_memory,
+                                  AllocationAlgorithm algorithm, const std::vector<Address>& region_sizes,
+                                  ConcurrentRunResult& result) {
+    std::sort(log.begin(), log.end(), [](const ConcurrentOpRecord& a, const ConcurrentOpRecord& b) {
+        return a.sequence < b.sequence;
+    });
+    
+    std::map<Address, Address> live; // inicio -> fin
+    for (const auto& record : log) {
+        if (record.status != OpStatus::OK || record.op == 'D') continue;
+        if (record.op == 'A') {
+            Address end = record.start + record.size;
+            auto next = live.lower_bound(record.start);
+            bool overlaps = (next != live.end() && next->first < end) ||
+                            (next != live.begin() && std::prev(next)->second > record.start);
+            if (overlaps || record.start < 0 || end > total_memory) {
+                result.safety_violations++;
+            }
+            live[record.start] = end;
+        } else {
+            auto it = live.find(record.start);
+            if (it == live.end() || it->second - it->first != record.size) {
+                result.safety_violations++;
+            } else {
+                live.erase(it);
+            }
+        }
+    }
+    
+    std::vector<ConcurrentManager> replicas;
+    std::vector<Address> bases;
+    replicas.reserve(region_sizes.size());
+    Address base = 0;
+    for (Address size : region_sizes) {
+        replicas.emplace_back(size, algorithm);
+        bases.push_back(base);
+        base += size;
+    }
+    
+    std::map<Address, Address> cached; // caché modelada: inicio -> tamano
+    auto uncache = [&](const ConcurrentOpRecord& record) {
+        auto it = cached.find(record.start);
+        if (it == cached.end() || it->second != record.size) {
+            result.replay_mismatches++;
+        } else {
+            cached.erase(it);
+        }
+    };
+    for (const auto& record : log) {
+        if (record.region < 0) {
+            // Sin franja: acierto o aparcamiento en la caché, o asignación fallida
+            if (record.status == OpStatus::OK && record.op == 'A') {
+                uncache(record);
+            } else if (record.status == OpStatus::OK && record.op == 'F' &&
+                       !cached.emplace(record.start, record.size).second) {
+                result.replay_mismatches++;
+            }
+            continue;
+        }
+        if (record.op == 'D') {
+            uncache(record);
+        }
+        ConcurrentManager& replica = replicas[record.region];
+        Address region_base = bases[record.region];
+        if (record.op == 'A') {
+            Address start;
+            std::string name = "T" + std::to_string(record.thread) + "-" + std::to_string(record.index);
+            OpStatus status = replica.try_allocate(name, record.size, start);
+            Address expected = record.status == OpStatus::OK ? record.start - region_base : -1;
+            if (status != record.status || start != expected) {
+                result.replay_mismatches++;
+            }
+        } else {
+            Address size;
+            OpStatus status = replica.try_release_at(record.start - region_base, size);
+            if (status != record.status || size != record.size) {
+                result.replay_mismatches++;
+            }
+        }
+    }
+    result.replay_mismatches += static_cast<long long>(cached.size()); // aparcados sin devolver
+}
+
+// Ejecuta `threads` hilos con `ops_per_thread` operaciones aleatorias cada uno
+// `regions` es la cantidad de franjas (striped) o de arenas (arenas)
+inline ConcurrentRunResult run_concurrent_workload(LockStrategy strategy, Address total_memory, AllocationAlgorithm algorithm,
+                                                   int threads, int ops_per_thread, int regions, int max_request) {
+    std::atomic<uint64_t> sequence{0};
+    std::unique_ptr<ConcurrentAllocator> allocator;
+    std::vector<Address> region_sizes = {total_memory};
+    
+    switch (strategy) {
+        case LockStrategy::GLOBAL_MUTEX:
+            allocator = std::make_unique<GlobalLockAllocator>(total_memory, algorithm, sequence);
+            break;
+        case LockStrategy::STRIPED:
+            allocator = std::make_unique<StripedLockAllocator>(total_memory, algorithm, regions, sequence);
+            region_sizes = StripedLockAllocator::stripe_sizes(total_memory, regions);
+            break;
+        case LockStrategy::LOCK_FREE_SMALL:
+            allocator = std::make_unique<LockFreeSmallAllocator>(total_memory, algorithm, sequence);
+            break;
+        case LockStrategy::ARENAS:
+            allocator = std::make_unique<ArenaAllocator>(total_memory, algorithm, regions, sequence);
+            region_sizes = StripedLockAllocator::stripe_sizes(total_memory, regions);
+            break;
+    }
+    
+    std::vector<std::vector<ConcurrentOpRecord>> logs(threads);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            XorShift64 rng(static_cast<uint64_t>(t) + 1);
+            std::vector<std::pair<Address, Address>> owned; // (inicio, tamano) de los bloques vivos del hilo
+            std::vector<ConcurrentOpRecord>& log = logs[t];
+            log.reserve(ops_per_thread);
+            std::string name;
+            
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            
+            for (int i = 0; i < ops_per_thread; i++) {
+                ConcurrentOpRecord record{0, t, i, 'A', 0, -1, -1, OpStatus::OK};
+                if (!owned.empty() && rng.below(100) < 50) {
+                    size_t victim = static_cast<size_t>(rng.below(static_cast<int>(owned.size())));
+                    std::swap(owned[victim], owned.back());
+                    record.op = 'F';
+                    record.start = owned.back().first;
+                    record.size = owned.back().second;
+                    owned.pop_back();
+                    allocator->release(record.start, record.size, record);
+                } else {
+                    // 80% de solicitudes pequenas, 20% hasta `max_request`
+                    record.size = rng.below(100) < 80 ? 1 + rng.below(LockFreeSmallAllocator::SMALL_CLASS_LIMIT)
+                                                      : 1 + rng.below(max_request);
+                    name = "T" + std::to_string(t) + "-" + std::to_string(i);
+                    if (allocator->allocate(t, name, record.size, record) >= 0) {
+                        owned.emplace_back(record.start, record.size);
+                    }
+                }
+                log.push_back(record);
+            }
+        });
+    }
+    
+    auto started = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto finished = std::chrono::steady_clock::now();
+    
+    ConcurrentRunResult result;
+    result.threads = threads;
+    result.seconds = std::chrono::duration<double>(finished - started).count();
+    
+    std::vector<ConcurrentOpRecord> merged;
+    merged.reserve(static_cast<size_t>(threads) * ops_per_thread);
+    for (const auto& log : logs) {
+        for (const auto& record : log) {
+            result.operations++;
+            if (record.op == 'A' && record.status != OpStatus::OK) result.failed_allocations++;
+            if (record.op == 'A' && record.status == OpStatus::OK && record.region < 0) result.cache_hits++;
+        }
+        merged.insert(merged.end(), log.begin(), log.end());
+    }
+    allocator->drain(merged);
+    
+    allocator->collect(result);
+    verify_concurrent_run(merged, total_memory, algorithm, region_sizes, result);
+    return result;
+}
+
+// Reporte por arena: utilización, robos y fragmentación que deja el reparto
+inline void show_arena_report(const ConcurrentRunResult& result) {
+    std::cout << "\nArenas con " << result.threads << " hilos:\n";
+    std::cout << std::left << std::setw(7) << "Arena" << std::setw(10) << "Inicio" << std::setw(10) << "Tamano"
+             << std::setw(10) << "Uso %" << std::setw(10) << "Pico %" << std::setw(10) << "Locales"
+             << std::setw(10) << "Robadas" << std::setw(8) << "Robos" << "Libre mayor\n";
+    for (size_t i = 0; i < result.arenas.size(); i++) {
+        const ArenaStats& arena = result.arenas[i];
+        std::cout << std::left << std::setw(7) << i << std::setw(10) << arena.base << std::setw(10) << arena.size
+                 << std::setw(10) << std::fixed << std::setprecision(1) << (100.0 * arena.used_memory / arena.size)
+                 << std::setw(10) << (100.0 * arena.peak_used / arena.size);
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setw(10) << arena.local_allocations << std::setw(10) << arena.stolen_from
+                 << std::setw(8) << arena.steals << arena.largest_free_block << "\n";
+    }
+}
+
+// Mide el rendimiento de una estrategia de 1 hasta `max_threads` hilos (potencias de 2)
+// y devuelve false si alguna corrida no coincide con su reproducción serial.
+// `regions` = franjas para striped; arenas para arenas (0 = una por hilo).
+inline bool run_concurrency_benchmark(LockStrategy strategy, Address total_memory, AllocationAlgorithm algorithm,
+                                      int max_threads, int ops_per_thread, int regions, int max_request) {
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "MODO CONCURRENTE - Estrategia: " << lock_strategy_name(strategy)
+             << " | Memoria: " << total_memory << " | Operaciones por hilo: " << ops_per_thread;
+    if (strategy == LockStrategy::STRIPED) std::cout << " | Franjas: " << regions;
+    if (strategy == LockStrategy::ARENAS) {
+        std::cout << " | Arenas: ";
+        if (regions > 0) std::cout << regions;
+        else std::cout << "una por hilo";
+    }
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(8) << "Hilos" << std::setw(14) << "Ops/seg"
+             << std::setw(10) << "Escala" << std::setw(10) << "Fallos" << std::setw(12) << "Cache hits"
+             << std::setw(8) << "Robos" << "Verificacion\n";
+    std::cout << std::string(78, '-') << "\n";
+    
+    bool all_ok = true;
+    double baseline = 0.0;
+    ConcurrentRunResult last;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        int region_count = regions;
+        if (strategy == LockStrategy::ARENAS && regions <= 0) {
+            region_count = threads;
+        }
+        ConcurrentRunResult result = run_concurrent_workload(strategy, total_memory, algorithm, threads,
+                                                             ops_per_thread, region_count, max_request);
+        double throughput = result.operations / std::max(result.seconds, 1e-9);
+        if (threads == 1) baseline = throughput;
+        bool ok = result.safety_violations == 0 && result.replay_mismatches == 0;
+        all_ok = all_ok && ok;
+        
+        std::cout << std::left << std::setw(8) << threads
+                 << std::setw(14) << static_cast<long long>(throughput)
+                 << std::setw(10) << std::fixed << std::setprecision(2) << (throughput / baseline)
+                 << std::setw(10) << result.failed_allocations
+                 << std::setw(12) << result.cache_hits
+                 << std::setw(8) << result.steals;
+        std::cout.unsetf(std::ios::floatfield);
+        if (ok) {
+            std::cout << "OK (linealizable)\n";
+        } else {
+            std::cout << "FALLO (" << result.safety_violations << " violaciones, "
+                     << result.replay_mismatches << " diferencias)\n";
+        }
+        last = std::move(result);
+    }
+    
+    if (!last.arenas.empty()) {
+        show_arena_report(last);
+    }
+    std::cout << std::string(78, '=') << "\n";
+    return all_ok;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_CONCURRENT_HPP
@@ -0,0 +1,219 @@
+// Registro binario de las decisiones del gestor y verificador que reproduce una
+// traza comparando cada decisión con las registradas. Sirve para contrastar el
+// índice por tamano con el recorrido lineal de referencia a velocidad completa.
+#ifndef MEMSIM_DECISION_LOG_HPP
+#define MEMSIM_DECISION_LOG_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "memory_manager.hpp"
+#include "output.hpp"
+#include "pipeline.hpp"
+
+namespace memsim {
+
+// Cabecera del archivo: "MSDL", versión, bytes por registro, memoria total (i64),
+// algoritmo inicial, la forma de los bloques y las listas rápidas (u32 cada uno, en el
+// orden de bytes de la máquina).
+// Luego siguen registros DecisionRecord de 40 bytes hasta el final del archivo.
+struct DecisionLogHeader {
+    char magic[4] = {'M', 'S', 'D', 'L'};
+    uint32_t version = 4;
+    uint32_t record_size = sizeof(DecisionRecord);
+    uint32_t algorithm = 0;
+    int64_t total_memory = 0;
+    int32_t alignment = 1;
+    int32_t min_split = 1;
+    int32_t header = 0;
+    int32_t quick_max_size = 0;
+    int32_t quick_depth = 8;
+    int32_t quick_max_cached_percent = 25;
+};
+
+static_assert(sizeof(DecisionLogHeader) == 48, "la cabecera no debe tener relleno implicito");
+
+// Escribe cada decisión en el archivo a través del buffer de StreamWriter
+class DecisionLogWriter : public DecisionSink {
+private:
+    std::ofstream file;
+    StreamWriter writer;
+
+public:
+    DecisionLogWriter(const std::string& filename, Address total_memory, AllocationAlgorithm algorithm,
+                      const BlockLayout& layout = {}, const QuickListConfig& quick = {})
+        : file(filename, std::ios::binary), writer(file) {
+        DecisionLogHeader header;
+        header.total_memory = total_memory;
+        header.algorithm = static_cast<uint32_t>(algorithm);
+        header.alignment = layout.alignment;
+        header.min_split = layout.min_split;
+        header.header = layout.header;
+        header.quick_max_size = quick.max_size;
+        header.quick_depth = quick.depth;
+        header.quick_max_cached_percent = quick.max_cached_percent;
+        writer.raw(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+    }
+    
+    bool is_open() const {
+        return file.is_open();
+    }
+    
+    void on_decision(const DecisionRecord& record) override {
+        writer.raw(std::string_view(reinterpret_cast<const char*>(&record), sizeof(record)));
+    }
+    
+    void flush() {
+        writer.flush();
+        file.flush();
+    }
+};
+
+// Diferencia entre la decisión registrada y la obtenida al reproducir
+struct DecisionMismatch {
+    int line_number;      // línea de la traza que produjo la decisión
+    DecisionRecord expected;
+    DecisionRecord actual;
+    bool missing;         // el registro terminó antes que la reproducción
+};
+
+// Compara cada decisión con la siguiente del registro. Las sondas no cuentan como
+// diferencia (el índice y el recorrido lineal examinan cantidades distintas); solo se
+// suman para comparar el trabajo de búsqueda de ambas implementaciones.
+class DecisionVerifier : public DecisionSink {
+private:
+    static constexpr size_t MAX_REPORTED = 10;
+    
+    std::ifstream file;
+    DecisionLogHeader log_header;
+    bool header_ok = false;
+
+public:
+    int current_line = 0;         // la fija quien reproduce la traza
+    long long compared = 0;
+    long long mismatches = 0;
+    long long extra_records = 0;  // registros que la reproducción no alcanzó a producir
+    long long logged_probes = 0;
+    long long replayed_probes = 0;
+    std::vector<DecisionMismatch> first_mismatches;
+    
+    explicit DecisionVerifier(const std::string& filename) : file(filename, std::ios::binary) {
+        DecisionLogHeader expected;
+        header_ok = file.read(reinterpret_cast<char*>(&log_header), sizeof(log_header)) &&
+                    std::memcmp(log_header.magic, expected.magic, 4) == 0 &&
+                    log_header.version == expected.version && log_header.record_size == expected.record_size;
+    }
+    
+    bool valid() const {
+        return header_ok;
+    }
+    
+    const DecisionLogHeader& header() const {
+        return log_header;
+    }
+    
+    void on_decision(const DecisionRecord& actual) override {
+        DecisionRecord expected{};
+        bool missing = !file.read(reinterpret_cast<char*>(&expected), sizeof(expected));
+        compared++;
+        replayed_probes += actual.probes;
+        if (!missing) {
+            logged_probes += expected.probes;
+        }
+        
+        bool same = !missing && expected.sequence == actual.sequence && expected.op == actual.op &&
+                    expected.status == actual.status && expected.algorithm == actual.algorithm &&
+                    expected.size == actual.size && expected.start == actual.start &&
+                    expected.hole_size == actual.hole_size;
+        if (!same) {
+            mismatches++;
+            if (first_mismatches.size() < MAX_REPORTED) {
+                first_mismatches.push_back({current_line, expected, actual, missing});
+            }
+        }
+    }
+    
+    // Contar los registros que quedaron sin comparar al terminar la reproducción
+    void finish() {
+        DecisionRecord rest;
+        while (file.read(reinterpret_cast<char*>(&rest), sizeof(rest))) {
+            extra_records++;
+        }
+    }
+    
+    bool passed() const {
+        return header_ok && mismatches == 0 && extra_records == 0;
+    }
+};
+
+// Reproduce los comandos A, L, R, AB, LB y ALG de la traza sobre un gestor con el índice
+// `FreeIndex`, la memoria, el algoritmo inicial, la forma de bloques y las listas
+// rápidas del registro; el resto de los comandos se ignora.
+// Devuelve los segundos que tomó la reproducción.
+template <class FreeIndex>
+double verify_decisions(std::istream& trace, DecisionVerifier& verifier) {
+    DynamicMemoryManager<FreeIndex> manager(verifier.header().total_memory,
+                                            static_cast<AllocationAlgorithm>(verifier.header().algorithm));
+    manager.set_layout({verifier.header().alignment, verifier.header().min_split, verifier.header().header});
+    manager.set_quick_lists({verifier.header().quick_max_size, verifier.header().quick_depth,
+                             verifier.header().quick_max_cached_percent});
+    manager.set_decision_sink(&verifier);
+    
+    std::string line;
+    ParsedCommand parsed;
+    int line_number = 0;
+    Address start, size;
+    std::vector<BatchRequest> requests;
+    std::vector<std::string_view> names;
+    std::vector<BatchResult> results;
+    auto started = std::chrono::steady_clock::now();
+    while (std::getline(trace, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) {
+            continue;
+        }
+        verifier.current_line = line_number;
+        
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            manager.try_allocate(parsed.process_name, parsed.size, start);
+        } else if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+            manager.try_deallocate(parsed.process_name, start, size);
+        } else {
+            std::string_view rest(parsed.line);
+            std::string command(next_token(rest));
+            std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+            int number;
+            Address new_size;
+            if (command == "ALG" && parse_int(next_token(rest), number) && number >= 1 && number <= 6) {
+                manager.set_algorithm(static_cast<AllocationAlgorithm>(number - 1));
+            } else if (command == "R") {
+                std::string_view process_name = next_token(rest);
+                if (!process_name.empty() && parse_int(next_token(rest), new_size)) {
+                    manager.try_resize(process_name, new_size, start, size);
+                }
+            } else if (command == "AB") {
+                if (parse_batch_allocation(rest, requests)) {
+                    manager.try_allocate_batch(requests, results);
+                }
+            } else if (command == "LB") {
+                if (parse_batch_release(rest, names)) {
+                    manager.try_deallocate_batch(names, results);
+                }
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    verifier.finish();
+    return seconds;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_DECISION_LOG_HPP
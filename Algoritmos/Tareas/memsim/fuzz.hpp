@@ -0,0 +1,305 @@
+// Prueba diferencial aleatoria de los gestores: la misma secuencia de A/L/R se aplica al
+// gestor de referencia (recorrido lineal) y a los demás (índice por tamano, política
+// fija en compilación); tras cada operación se comparan los resultados y cada tanto se
+// verifican los invariantes de todos. Sirve de red de seguridad al optimizar la asignación.
+#ifndef MEMSIM_FUZZ_HPP
+#define MEMSIM_FUZZ_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "memory_manager.hpp"
+
+namespace memsim {
+
+struct FuzzConfig {
+    long long operations = 1000000; // operaciones por corrida
+    Address total_memory = 4096;
+    int max_size = 256;             // tamano máximo de cada A
+    int names = 256;                // nombres de proceso posibles (se repiten a propósito)
+    int check_every = 64;           // verificación completa cada tantas operaciones
+    uint64_t seed = 1;
+    BlockLayout layout;             // forma de los bloques en todos los gestores
+    QuickListConfig quick;          // listas rápidas en todos los gestores
+};
+
+// Resultado de una corrida: se detiene en la primera diferencia o invariante roto
+struct FuzzResult {
+    std::string label;
+    long long operations = 0;
+    long long checks = 0;           // verificaciones completas (por gestor)
+    double seconds = 0.0;
+    bool failed = false;
+    long long failed_operation = 0;
+    std::string backend;            // gestor donde apareció el problema
+    std::string problem;
+};
+
+// Genera la secuencia: 45% A con tamano en [1, max_size] (1% no positivo), 10% R con
+// un tamano nuevo en el mismo rango y 45% L, con nombres al azar de un conjunto
+// acotado, de modo que también aparecen procesos duplicados y operaciones sobre
+// procesos inexistentes. Un 2% son lotes (AB o LB) de hasta 16 procesos, y si
+// `algorithms` es positivo cada tanto cambia a uno de los primeros `algorithms`
+// algoritmos de AllocationAlgorithm.
+class FuzzSequence {
+private:
+    XorShift64 rng;
+    const FuzzConfig& config;
+    int algorithms;
+    std::vector<std::string> names;
+    
+    int random_size() {
+        return rng.below(100) == 0 ? -rng.below(2) : 1 + rng.below(config.max_size);
+    }
+
+public:
+    struct Op {
+        char op;                    // 'A', 'L', 'R' o 'S' (cambio de algoritmo)
+        Address size;
+        const std::string* name;
+        AllocationAlgorithm algorithm;
+        bool batch = false;         // A o L en lote: los procesos están en batch_*
+    };
+    
+    std::vector<BatchRequest> batch_requests;
+    std::vector<std::string_view> batch_names;
+    
+    FuzzSequence(const FuzzConfig& fuzz_config, int switched_algorithms)
+        : rng(fuzz_config.seed), config(fuzz_config), algorithms(switched_algorithms) {
+        for (int i = 0; i < config.names; i++) {
+            names.push_back("P" + std::to_string(i));
+        }
+    }
+    
+    Op next() {
+        if (algorithms > 0 && rng.below(1000) == 0) {
+            return {'S', 0, nullptr, static_cast<AllocationAlgorithm>(rng.below(algorithms))};
+        }
+        if (rng.below(50) == 0) {
+            size_t count = static_cast<size_t>(1 + rng.below(16));
+            bool release = rng.below(2) == 0;
+            batch_requests.resize(count);
+            batch_names.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                batch_requests[i].process_name = names[static_cast<size_t>(rng.below(config.names))];
+                batch_requests[i].size = random_size();
+                batch_names[i] = batch_requests[i].process_name;
+            }
+            return {release ? 'L' : 'A', 0, nullptr, AllocationAlgorithm::FIRST_FIT, true};
+        }
+        const std::string* name = &names[static_cast<size_t>(rng.below(config.names))];
+        int kind = rng.below(100);
+        if (kind < 45) {
+            return {'L', 0, name, AllocationAlgorithm::FIRST_FIT};
+        }
+        int size = random_size();
+        return {kind < 55 ? 'R' : 'A', size, name, AllocationAlgorithm::FIRST_FIT};
+    }
+};
+
+// Gestor bajo prueba con su nombre para el reporte
+template <class Manager>
+struct FuzzBackend {
+    const char* name;
+    Manager& manager;
+};
+
+// Aplica la secuencia a `reference` y a cada backend. Tras cada operación compara el
+// resultado y los contadores con la referencia; los invariantes se verifican por
+// completo en todos los gestores cada `check_every` operaciones y al final, de modo
+// que un fallo se detecta a lo sumo `check_every` operaciones después (con
+// --check-every=1 se localiza la operación exacta).
+// Los lotes se aplican uno por uno en la referencia y con try_*_batch en los
+// backends, así que también se comparan con la ejecución en secuencia.
+// `set_algorithm(alg)` se llama en los cambios de algoritmo, que solo generan las
+// corridas con gestores dinámicos (`algorithms` > 0).
+template <class Reference, class SetAlgorithm, class... Managers>
+FuzzResult run_fuzz(const FuzzConfig& config, std::string label, int algorithms, Reference& reference,
+                    SetAlgorithm&& set_algorithm, FuzzBackend<Managers>... backends) {
+    FuzzResult result;
+    result.label = std::move(label);
+    FuzzSequence sequence(config, algorithms);
+    
+    auto fail = [&](const char* backend, std::string problem) {
+        result.failed = true;
+        result.failed_operation = result.operations;
+        result.backend = backend;
+        result.problem = std::move(problem);
+    };
+    std::string problem;
+    auto check = [&](const char* name, const auto& manager) {
+        result.checks++;
+        if (!result.failed && !manager.check_invariants(problem)) {
+            fail(name, "invariante: " + problem);
+        }
+    };
+    // Los contadores incrementales deben coincidir con los de la referencia
+    auto same_counters = [&](const auto& backend) {
+        const MemoryCounters& expected = reference.get_counters();
+        const MemoryCounters& actual = backend.manager.get_counters();
+        if (!result.failed && (actual.used_memory != expected.used_memory || actual.free_blocks != expected.free_blocks ||
+                               actual.cached_memory != expected.cached_memory ||
+                               backend.manager.get_largest_free_block() != reference.get_largest_free_block())) {
+            fail(backend.name, "contadores distintos de la referencia (usada " + std::to_string(actual.used_memory) +
+                                   " frente a " + std::to_string(expected.used_memory) + ", aparcada " +
+                                   std::to_string(actual.cached_memory) + " frente a " +
+                                   std::to_string(expected.cached_memory) + ")");
+        }
+    };
+    
+    std::vector<BatchResult> expected_batch, batch;
+    auto started = std::chrono::steady_clock::now();
+    while (result.operations < config.operations && !result.failed) {
+        FuzzSequence::Op op = sequence.next();
+        result.operations++;
+        
+        if (op.op == 'S') {
+            set_algorithm(op.algorithm);
+        } else if (op.batch) {
+            expected_batch.clear();
+            for (const auto& request : sequence.batch_requests) {
+                BatchResult expected{OpStatus::OK, -1, request.size};
+                expected.status = op.op == 'A'
+                                      ? reference.try_allocate(request.process_name, request.size, expected.start)
+                                      : reference.try_deallocate(request.process_name, expected.start, expected.size);
+                expected_batch.push_back(expected);
+            }
+            auto compare = [&](const auto& backend) {
+                if (op.op == 'A') {
+                    backend.manager.try_allocate_batch(sequence.batch_requests, batch);
+                } else {
+                    backend.manager.try_deallocate_batch(sequence.batch_names, batch);
+                }
+                for (size_t i = 0; i < batch.size() && !result.failed; i++) {
+                    const BatchResult& expected = expected_batch[i];
+                    if (batch[i].status != expected.status || batch[i].start != expected.start ||
+                        (op.op == 'L' && batch[i].size != expected.size)) {
+                        fail(backend.name, std::string(op.op == 'A' ? "AB " : "LB ") +
+                                               sequence.batch_requests[i].process_name + ": " +
+                                               std::string(op_status_name(batch[i].status)) + " en " +
+                                               std::to_string(batch[i].start) + ", referencia " +
+                                               std::string(op_status_name(expected.status)) + " en " +
+                                               std::to_string(expected.start));
+                    }
+                }
+            };
+            (compare(backends), ...);
+        } else if (op.op == 'A') {
+            Address expected_start;
+            OpStatus expected = reference.try_allocate(*op.name, op.size, expected_start);
+            auto compare = [&](const auto& backend) {
+                Address start;
+                OpStatus status = backend.manager.try_allocate(*op.name, op.size, start);
+                if (!result.failed && (status != expected || start != expected_start)) {
+                    fail(backend.name, "A " + *op.name + " " + std::to_string(op.size) + ": " +
+                                           std::string(op_status_name(status)) + " en " + std::to_string(start) +
+                                           ", referencia " + std::string(op_status_name(expected)) + " en " +
+                                           std::to_string(expected_start));
+                }
+            };
+            (compare(backends), ...);
+        } else if (op.op == 'R') {
+            Address expected_start, expected_moved;
+            OpStatus expected = reference.try_resize(*op.name, op.size, expected_start, expected_moved);
+            auto compare = [&](const auto& backend) {
+                Address start, moved;
+                OpStatus status = backend.manager.try_resize(*op.name, op.size, start, moved);
+                if (!result.failed && (status != expected || start != expected_start || moved != expected_moved)) {
+                    fail(backend.name, "R " + *op.name + " " + std::to_string(op.size) + ": " +
+                                           std::string(op_status_name(status)) + " en " + std::to_string(start) +
+                                           ", referencia " + std::string(op_status_name(expected)) + " en " +
+                                           std::to_string(expected_start));
+                }
+            };
+            (compare(backends), ...);
+        } else {
+            Address expected_start, expected_size;
+            OpStatus expected = reference.try_deallocate(*op.name, expected_start, expected_size);
+            auto compare = [&](const auto& backend) {
+                Address start, size;
+                OpStatus status = backend.manager.try_deallocate(*op.name, start, size);
+                if (!result.failed && (status != expected || start != expected_start || size != expected_size)) {
+                    fail(backend.name, "L " + *op.name + ": " + std::string(op_status_name(status)) + " en " +
+                                           std::to_string(start) + ", referencia " +
+                                           std::string(op_status_name(expected)) + " en " +
+                                           std::to_string(expected_start));
+                }
+            };
+            (compare(backends), ...);
+        }
+        
+        (same_counters(backends), ...);
+        if (result.operations % config.check_every == 0 || result.operations == config.operations) {
+            check("referencia", reference);
+            (check(backends.name, backends.manager), ...);
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+// Una corrida por política con la referencia DynamicMemoryManager<LinearScanIndex>
+// frente al índice por tamano y a las políticas fijas en compilación, y tres corridas
+// que cambian de algoritmo en medio (solo gestores dinámicos). ADAPTIVE cuenta sondas
+// distintas según el índice y puede elegir otra política, así que la corrida lineal
+// frente a ordenado cambia entre los cinco algoritmos fijos y las dos que incluyen
+// ADAPTIVE comparan gestores con el mismo índice (secuencia frente a lotes).
+inline std::vector<FuzzResult> run_fuzz_suite(const FuzzConfig& config) {
+    std::vector<FuzzResult> results;
+    auto fixed = [&](auto placement) {
+        using Placement = decltype(placement);
+        DynamicMemoryManager<LinearScanIndex> reference(config.total_memory, Placement::algorithm);
+        DynamicMemoryManager<SizeOrderedIndex> ordered(config.total_memory, Placement::algorithm);
+        BasicMemoryManager<Placement, LinearScanIndex> basic_linear(config.total_memory);
+        BasicMemoryManager<Placement, SizeOrderedIndex> basic_ordered(config.total_memory);
+        reference.set_layout(config.layout);
+        ordered.set_layout(config.layout);
+        basic_linear.set_layout(config.layout);
+        basic_ordered.set_layout(config.layout);
+        reference.set_quick_lists(config.quick);
+        ordered.set_quick_lists(config.quick);
+        basic_linear.set_quick_lists(config.quick);
+        basic_ordered.set_quick_lists(config.quick);
+        results.push_back(run_fuzz(config, std::string(algorithm_display_name(Placement::algorithm)), 0,
+                                   reference, [](AllocationAlgorithm) {},
+                                   FuzzBackend<decltype(ordered)>{"dinamico/ordenado", ordered},
+                                   FuzzBackend<decltype(basic_linear)>{"fijo/lineal", basic_linear},
+                                   FuzzBackend<decltype(basic_ordered)>{"fijo/ordenado", basic_ordered}));
+    };
+    fixed(FirstFit{});
+    fixed(BestFit{});
+    fixed(WorstFit{});
+    fixed(NextFit{});
+    fixed(TlsfFit{});
+    
+    constexpr int FIXED_ALGORITHMS = static_cast<int>(AllocationAlgorithm::ADAPTIVE);
+    auto switching = [&](auto reference_index, auto backend_index, const char* label, const char* backend_name,
+                         int algorithms) {
+        DynamicMemoryManager<decltype(reference_index)> reference(config.total_memory);
+        DynamicMemoryManager<decltype(backend_index)> backend(config.total_memory);
+        reference.set_layout(config.layout);
+        backend.set_layout(config.layout);
+        reference.set_quick_lists(config.quick);
+        backend.set_quick_lists(config.quick);
+        results.push_back(run_fuzz(config, label, algorithms, reference,
+                                   [&](AllocationAlgorithm algorithm) {
+                                       reference.set_algorithm(algorithm);
+                                       backend.set_algorithm(algorithm);
+                                   },
+                                   FuzzBackend<decltype(backend)>{backend_name, backend}));
+    };
+    switching(LinearScanIndex{}, SizeOrderedIndex{}, "Cambios ALG", "dinamico/ordenado", FIXED_ALGORITHMS);
+    switching(LinearScanIndex{}, LinearScanIndex{}, "ADAPT. lineal", "dinamico/lineal", FIXED_ALGORITHMS + 1);
+    switching(SizeOrderedIndex{}, SizeOrderedIndex{}, "ADAPT. ordenado", "dinamico/ordenado", FIXED_ALGORITHMS + 1);
+    return results;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_FUZZ_HPP
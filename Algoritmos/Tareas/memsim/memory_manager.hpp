@@ -0,0 +1,2134 @@
+// Núcleo del simulador: lista de bloques, contadores incrementales, índices de
+// bloques libres y políticas de colocación. No imprime nada; la presentación
+// (comandos M, S, FR, mensajes de A/L) la pone cada ejecutable.
+#ifndef MEMSIM_MEMORY_MANAGER_HPP
+#define MEMSIM_MEMORY_MANAGER_HPP
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "address_map.hpp"
+#include "pool.hpp"
+
+namespace memsim {
+
+// Direcciones y tamanos en unidades de memoria. Son de 64 bits para modelar memorias
+// de terabytes; ninguna estructura del gestor crece con el tamano total, solo con la
+// cantidad de bloques.
+using Address = long long;
+
+// Mayor memoria total admitida: deja margen para sumar tamanos sin desbordar
+constexpr Address MAX_TOTAL_MEMORY = 1LL << 62;
+
+// Enumeración para los algoritmos de asignación
+enum class AllocationAlgorithm {
+    FIRST_FIT,
+    BEST_FIT,
+    WORST_FIT,
+    NEXT_FIT,
+    TLSF,
+    ADAPTIVE  // elige First, Best o Worst Fit según lo observado (AdaptiveFit)
+};
+
+// Nombres legibles de cada algoritmo, en el orden de AllocationAlgorithm. Son vistas
+// a literales: consultarlos no construye ningún std::string.
+constexpr std::array<std::string_view, 6> ALGORITHM_NAMES = {"First Fit", "Best Fit", "Worst Fit", "Next Fit",
+                                                             "TLSF", "Adaptativo"};
+
+constexpr std::string_view algorithm_display_name(AllocationAlgorithm algorithm) {
+    return ALGORITHM_NAMES[static_cast<size_t>(algorithm)];
+}
+
+// Resultado de una operación de asignación o liberación
+enum class OpStatus {
+    OK,
+    INVALID_SIZE,
+    DUPLICATE,
+    NO_MEMORY,
+    NOT_FOUND
+};
+
+// Nombres de cada resultado en los registros estructurados, en el orden de OpStatus
+constexpr std::array<std::string_view, 5> OP_STATUS_NAMES = {"ok", "invalid_size", "duplicate", "no_memory", "not_found"};
+
+constexpr std::string_view op_status_name(OpStatus status) {
+    return OP_STATUS_NAMES[static_cast<size_t>(status)];
+}
+
+// Estructura para representar un bloque de memoria
+struct MemoryBlock {
+    Address start;
+    Address size;
+    std::string process_name;
+    bool is_free;
+    Address requested = 0; // unidades pedidas; el resto del bloque es cabecera, relleno o sobrante
+    bool cached = false; // aparcado en una lista rápida: ni libre ni de un proceso
+    
+    MemoryBlock(Address s, Address sz, std::string_view name = {}, bool free = true)
+        : start(s), size(sz), process_name(name), is_free(free) {}
+};
+
+// Contadores incrementales del estado de la memoria. Se actualizan en cada
+// asignación, liberación y fusión, de modo que consultarlos es O(1).
+struct MemoryCounters {
+    long long used_memory = 0;
+    long long free_memory = 0;
+    long long free_blocks = 0;
+    long long failed_allocations = 0;
+    long long operations = 0;
+    long long requested_memory = 0; // unidades pedidas por los procesos vivos
+    long long header_memory = 0;    // cabeceras de los bloques ocupados
+    long long resizes = 0;          // comandos R atendidos
+    long long moves = 0;            // R que tuvieron que mover el bloque
+    long long moved_memory = 0;     // unidades copiadas por esos movimientos
+    long long cached_memory = 0;    // unidades aparcadas en las listas rápidas
+    long long cached_blocks = 0;
+    long long quick_hits = 0;       // A atendidos desde una lista rápida
+    long long quick_misses = 0;     // A de un tamano con lista que la encontraron vacía
+    long long quick_flushes = 0;    // consolidaciones diferidas
+    long long quick_flushed_blocks = 0; // bloques devueltos al espacio libre por ellas
+};
+
+// Forma de los bloques ocupados. Cada asignación ocupa la solicitud más la cabecera,
+// redondeada a `alignment`; si el sobrante del hueco queda por debajo de `min_split`
+// se entrega entero al proceso en vez de dejar una astilla libre. Los valores por
+// defecto reproducen el modelo exacto: el bloque mide lo pedido y todo sobrante se corta.
+struct BlockLayout {
+    int alignment = 1;
+    int min_split = 1;
+    int header = 0;
+    
+    bool is_exact() const {
+        return alignment == 1 && min_split <= 1 && header == 0;
+    }
+    
+    // Tamano del bloque para una solicitud de `requested` unidades. Las solicitudes
+    // mayores que MAX_TOTAL_MEMORY se acotan antes de sumar: de todos modos no caben.
+    Address block_size(Address requested) const {
+        Address size = std::min(requested, MAX_TOTAL_MEMORY) + header;
+        return (size + alignment - 1) / alignment * alignment;
+    }
+};
+
+// Listas rápidas por tamano (al estilo de tcache/fastbins): un bloque liberado de hasta
+// `max_size` unidades se aparca sin fusionar en la lista LIFO de su tamano, y el
+// siguiente A con ese tamano de bloque lo recibe sin búsqueda. Los aparcados vuelven
+// al espacio libre (consolidación diferida) cuando superarían `max_cached_percent` de
+// la memoria o cuando una asignación no encuentra hueco. max_size = 0 las desactiva.
+struct QuickListConfig {
+    int max_size = 0;
+    int depth = 8;               // bloques por lista; el resto se libera normalmente
+    int max_cached_percent = 25;
+    
+    bool enabled() const {
+        return max_size > 0;
+    }
+};
+
+// Nodo devuelto por las políticas cuando ningún bloque sirve (y enlace vacío de BlockList)
+constexpr size_t NO_BLOCK = static_cast<size_t>(-1);
+
+// Decisión del gestor en una operación A/L, en registros fijos de 40 bytes para el
+// registro binario de decisiones (decision_log.hpp)
+struct DecisionRecord {
+    uint32_t sequence;  // número de operación del gestor
+    uint8_t op;         // 'A', 'L' o 'R'
+    uint8_t status;     // OpStatus
+    uint8_t algorithm;  // AllocationAlgorithm de la asignación; NO_ALGORITHM en L
+    uint8_t reserved;
+    int64_t size;       // tamano pedido (A) o liberado (L)
+    int64_t start;      // inicio del bloque asignado o liberado; -1 si no hubo
+    int64_t hole_size;  // A: hueco del que se cortó el bloque; L: hueco libre tras fusionar;
+                        // R: unidades movidas (0 si se redimensionó en el lugar)
+    uint32_t probes;    // bloques o consultas al índice que examinó la política
+    uint32_t padding;   // siempre 0, para que el registro no tenga relleno sin inicializar
+    
+    static constexpr uint8_t NO_ALGORITHM = 0xFF;
+};
+static_assert(sizeof(DecisionRecord) == 40, "DecisionRecord debe medir 40 bytes");
+
+// Solicitud y resultado de las operaciones en lote (comandos AB y LB). En LB `size` es
+// el tamano del bloque liberado, como en try_deallocate.
+struct BatchRequest {
+    std::string process_name;
+    Address size;
+};
+
+struct BatchResult {
+    OpStatus status;
+    Address start;
+    Address size;
+};
+
+// Destino de las decisiones: el gestor lo llama tras cada A/L si hay uno asignado
+class DecisionSink {
+public:
+    virtual ~DecisionSink() = default;
+    virtual void on_decision(const DecisionRecord& record) = 0;
+};
+
+// Lista de bloques enlazada por dirección, como las etiquetas de frontera de un
+// asignador real: cada bloque conoce a sus vecinos físicos, así que partir un hueco o
+// fusionarlo con un vecino cuesta O(1) sin desplazar al resto. Los nodos viven en tramos
+// de NODES_PER_CHUNK, así que crecer nunca copia más de un tramo; los borrados se
+// reutilizan y un nodo vivo nunca cambia de número. Un mapa hash inicio -> nodo los
+// localiza en O(1). Se recorre en orden de dirección; los bloques cubren [0, total)
+// sin huecos.
+class BlockList {
+private:
+    struct Node {
+        MemoryBlock block;
+        size_t previous;
+        size_t next;
+    };
+    
+    static constexpr size_t CHUNK_LOG2 = 10;
+    static constexpr size_t NODES_PER_CHUNK = size_t{1} << CHUNK_LOG2;
+    
+    std::vector<std::vector<Node>> chunks; // cada tramo reserva NODES_PER_CHUNK nodos
+    std::vector<size_t> unused;            // nodos borrados, listos para reutilizar
+    size_t allocated = 0;                  // nodos creados en los tramos
+    size_t head = NO_BLOCK;
+    size_t tail = NO_BLOCK;
+    size_t count = 0;
+    AddressMap<size_t> by_start; // inicio de bloque -> nodo
+    mutable size_t finger = NO_BLOCK; // último resultado de containing; siempre un nodo vivo
+    
+    Node& node_at(size_t node) {
+        return chunks[node >> CHUNK_LOG2][node & (NODES_PER_CHUNK - 1)];
+    }
+    
+    const Node& node_at(size_t node) const {
+        return chunks[node >> CHUNK_LOG2][node & (NODES_PER_CHUNK - 1)];
+    }
+
+public:
+    // Recorrido en orden de dirección
+    class const_iterator {
+    private:
+        const BlockList* list;
+        size_t node;
+    
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = MemoryBlock;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const MemoryBlock*;
+        using reference = const MemoryBlock&;
+        
+        const_iterator(const BlockList* owner, size_t position) : list(owner), node(position) {}
+        
+        reference operator*() const {
+            return (*list)[node];
+        }
+        
+        pointer operator->() const {
+            return &(*list)[node];
+        }
+        
+        const_iterator& operator++() {
+            node = list->next(node);
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            node = list->next(node);
+            return previous;
+        }
+        
+        bool operator==(const const_iterator& other) const {
+            return node == other.node;
+        }
+        
+        bool operator!=(const const_iterator& other) const {
+            return node != other.node;
+        }
+    };
+    
+    void reserve(size_t capacity) {
+        chunks.reserve(capacity / NODES_PER_CHUNK + 1);
+        unused.reserve(capacity);
+        by_start.reserve(capacity);
+    }
+    
+    // Nodos disponibles sin crear otro tramo
+    size_t capacity() const {
+        return chunks.size() * NODES_PER_CHUNK;
+    }
+    
+    size_t size() const {
+        return count;
+    }
+    
+    const_iterator begin() const {
+        return const_iterator(this, head);
+    }
+    
+    const_iterator end() const {
+        return const_iterator(this, NO_BLOCK);
+    }
+    
+    MemoryBlock& operator[](size_t node) {
+        return node_at(node).block;
+    }
+    
+    const MemoryBlock& operator[](size_t node) const {
+        return node_at(node).block;
+    }
+    
+    // Primer y último bloque, y vecinos físicos de un nodo (NO_BLOCK en los extremos)
+    size_t first() const {
+        return head;
+    }
+    
+    size_t last() const {
+        return tail;
+    }
+    
+    size_t next(size_t node) const {
+        return node_at(node).next;
+    }
+    
+    size_t previous(size_t node) const {
+        return node_at(node).previous;
+    }
+    
+    // Nodo del bloque que empieza en `start`, o NO_BLOCK
+    size_t find(Address start) const {
+        const size_t* node = by_start.find(start);
+        return node == nullptr ? NO_BLOCK : *node;
+    }
+    
+    // Nodo del bloque que contiene `address` (el último si está más allá del final). Es
+    // O(1) si `address` es un inicio o cae en el último bloque; si no, camina desde el
+    // resultado anterior, que las fusiones mueven al bloque que absorbió el suyo. Next
+    // Fit pregunta por el final de su última asignación, cerca de donde empezó su
+    // búsqueda anterior: el camino es del orden de lo que esa búsqueda ya recorrió.
+    size_t containing(Address address) const {
+        size_t node = find(address);
+        if (node == NO_BLOCK && address >= node_at(tail).block.start) {
+            node = tail;
+        }
+        if (node == NO_BLOCK) {
+            node = finger == NO_BLOCK ? head : finger;
+            while (address < node_at(node).block.start) {
+                node = node_at(node).previous;
+            }
+            while (node_at(node).block.start + node_at(node).block.size <= address) {
+                node = node_at(node).next;
+            }
+        }
+        finger = node;
+        return node;
+    }
+    
+    // Insertar un bloque libre de [start, start + size) a continuación de `node` (al
+    // comienzo con NO_BLOCK). Reutiliza un nodo borrado si hay, conservando la capacidad
+    // de su nombre. Devuelve el nodo nuevo; puede invalidar referencias a los bloques.
+    size_t insert_after(size_t node, Address start, Address size) {
+        size_t added;
+        if (unused.empty()) {
+            if (allocated == capacity()) {
+                chunks.emplace_back();
+                chunks.back().reserve(NODES_PER_CHUNK);
+            }
+            added = allocated++;
+            chunks.back().push_back({MemoryBlock(start, size), NO_BLOCK, NO_BLOCK});
+        } else {
+            added = unused.back();
+            unused.pop_back();
+            MemoryBlock& block = node_at(added).block;
+            block.start = start;
+            block.size = size;
+            block.process_name.clear();
+            block.is_free = true;
+            block.requested = 0;
+            block.cached = false;
+        }
+        
+        size_t following = node == NO_BLOCK ? head : node_at(node).next;
+        node_at(added).previous = node;
+        node_at(added).next = following;
+        (node == NO_BLOCK ? head : node_at(node).next) = added;
+        (following == NO_BLOCK ? tail : node_at(following).previous) = added;
+        by_start.insert(start, added);
+        count++;
+        return added;
+    }
+    
+    // Quitar el bloque de `node` de la lista; su nodo queda para reutilizar
+    void erase(size_t node) {
+        size_t previous = node_at(node).previous;
+        size_t following = node_at(node).next;
+        (previous == NO_BLOCK ? head : node_at(previous).next) = following;
+        (following == NO_BLOCK ? tail : node_at(following).previous) = previous;
+        by_start.erase(node_at(node).block.start);
+        unused.push_back(node);
+        count--;
+        if (finger == node) {
+            finger = previous == NO_BLOCK ? following : previous;
+        }
+    }
+    
+    // Mover el inicio del bloque de `node` (su vecino anterior ganó o cedió unidades)
+    void move_start(size_t node, Address start) {
+        by_start.erase(node_at(node).block.start);
+        node_at(node).block.start = start;
+        by_start.insert(start, node);
+    }
+    
+    // Para la verificación de invariantes: enlaces recíprocos en ambos sentidos y cada
+    // bloque en el mapa de inicios con su nodo
+    bool check(std::string& problem) const {
+        size_t visited = 0;
+        size_t previous = NO_BLOCK;
+        for (size_t node = head; node != NO_BLOCK; node = node_at(node).next) {
+            if (node_at(node).previous != previous || ++visited > count || find(node_at(node).block.start) != node) {
+                problem = "la lista de bloques esta mal enlazada en " + std::to_string(node_at(node).block.start);
+                return false;
+            }
+            previous = node;
+        }
+        if (previous != tail || visited != count || by_start.size() != count) {
+            problem = "la lista de bloques enlaza " + std::to_string(visited) + " de " + std::to_string(count) +
+                      " bloques y el mapa de inicios tiene " + std::to_string(by_start.size());
+            return false;
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// ÍNDICES DE BLOQUES LIBRES
+// ============================================================================
+
+// Listas libres segregadas de TLSF (two-level segregated fit). El primer nivel separa
+// los tamanos por potencia de 2 y el segundo divide cada potencia en SL_COUNT tramos
+// lineales; dos mapas de bits indican qué listas tienen bloques. Buscar, insertar y
+// quitar cuestan O(1): un fls/ffs por nivel y enlaces dobles por inicio de bloque.
+// Solo se mantienen mientras estén activas (con el algoritmo TLSF en uso), y entonces
+// reemplazan a las estructuras ordenadas del índice.
+class SegregatedFreeLists {
+public:
+    static constexpr int SL_LOG2 = 4;
+    static constexpr int SL_COUNT = 1 << SL_LOG2;
+    static constexpr int FL_COUNT = 64 - SL_LOG2; // alcanza hasta MAX_TOTAL_MEMORY
+
+private:
+    struct Link {
+        Address previous;
+        Address next;
+        Address size;
+    };
+    
+    bool active = false;
+    uint64_t first_level = 0;                      // bit fl: hay bloques en alguna lista de fl
+    std::array<uint32_t, FL_COUNT> second_level{}; // bit sl de fl: la lista (fl, sl) no está vacía
+    std::array<std::array<Address, SL_COUNT>, FL_COUNT> heads;
+    AddressMap<Link> links; // inicio de bloque libre -> enlaces de su lista
+    
+    // Mayor tamano, o una cota superior si `largest_stale` (se quitó un bloque de ese
+    // tamano); largest() lo recalcula al consultarlo
+    mutable Address largest_size = 0;
+    mutable bool largest_stale = false;
+    
+    // Bit más alto y más bajo encendidos (v != 0)
+    static int fls(uint64_t v) {
+        return 63 - __builtin_clzll(v);
+    }
+    
+    static int ffs(uint64_t v) {
+        return __builtin_ctzll(v);
+    }
+
+public:
+    // Lista (fl, sl) a la que pertenece un bloque de `size` unidades. Bajo SL_COUNT
+    // cada tamano tiene su propia lista en fl = 0.
+    static void mapping(Address size, int& fl, int& sl) {
+        if (size < SL_COUNT) {
+            fl = 0;
+            sl = static_cast<int>(size);
+        } else {
+            int bit = fls(static_cast<uint64_t>(size));
+            fl = bit - SL_LOG2 + 1;
+            sl = static_cast<int>(size >> (bit - SL_LOG2)) - SL_COUNT;
+        }
+    }
+    
+    // Primera lista donde buscar `size`: se redondea al comienzo del tramo siguiente,
+    // de modo que cualquier bloque de esa lista o de una posterior alcanza. Devuelve
+    // false si el tamano redondeado excede MAX_TOTAL_MEMORY.
+    static bool search_mapping(Address size, int& fl, int& sl) {
+        Address rounded = size;
+        if (size >= SL_COUNT) {
+            rounded += (1LL << (fls(static_cast<uint64_t>(size)) - SL_LOG2)) - 1;
+        }
+        if (rounded > MAX_TOTAL_MEMORY) {
+            return false;
+        }
+        mapping(rounded, fl, sl);
+        return true;
+    }
+    
+    SegregatedFreeLists() {
+        clear();
+    }
+    
+    bool enabled() const {
+        return active;
+    }
+    
+    void clear() {
+        first_level = 0;
+        second_level.fill(0);
+        for (auto& row : heads) {
+            row.fill(-1);
+        }
+        links.clear();
+        largest_size = 0;
+        largest_stale = false;
+    }
+    
+    // Activar (vacías) o desactivar las listas; quien las activa inserta los bloques
+    void set_enabled(bool enabled, size_t expected_blocks) {
+        clear();
+        active = enabled;
+        if (enabled) {
+            links.reserve(std::max<size_t>(expected_blocks, 16));
+        }
+    }
+    
+    // El bloque entra al frente de su lista
+    void insert(Address start, Address size) {
+        if (!active) {
+            return;
+        }
+        int fl, sl;
+        mapping(size, fl, sl);
+        Address& head = heads[static_cast<size_t>(fl)][static_cast<size_t>(sl)];
+        links.insert(start, Link{-1, head, size});
+        if (head >= 0) {
+            links.find(head)->previous = start;
+        }
+        head = start;
+        first_level |= 1ull << fl;
+        second_level[static_cast<size_t>(fl)] |= 1u << sl;
+        if (size >= largest_size) {
+            largest_size = size;
+            largest_stale = false;
+        }
+    }
+    
+    void erase(Address start, Address size) {
+        if (!active) {
+            return;
+        }
+        Link link = *links.find(start);
+        links.erase(start);
+        int fl, sl;
+        mapping(size, fl, sl);
+        if (link.next >= 0) {
+            links.find(link.next)->previous = link.previous;
+        }
+        if (link.previous >= 0) {
+            links.find(link.previous)->next = link.next;
+        } else {
+            heads[static_cast<size_t>(fl)][static_cast<size_t>(sl)] = link.next;
+            if (link.next < 0) {
+                second_level[static_cast<size_t>(fl)] &= ~(1u << sl);
+                if (second_level[static_cast<size_t>(fl)] == 0) {
+                    first_level &= ~(1ull << fl);
+                }
+            }
+        }
+        largest_stale = largest_stale || size == largest_size;
+    }
+    
+    // Inicio de un bloque libre de al menos `size` unidades, o -1. `size` se redondea al
+    // comienzo del tramo siguiente, así que sirve la cabeza de la primera lista no vacía
+    // desde ahí sin recorrer nada (good fit: puede pasar por alto un bloque del propio
+    // tramo de `size` que sí alcanzaba).
+    Address find(Address size) const {
+        int fl, sl;
+        if (!search_mapping(size, fl, sl)) {
+            return -1;
+        }
+        uint32_t sl_map = second_level[static_cast<size_t>(fl)] & (~0u << sl);
+        if (sl_map == 0) {
+            uint64_t fl_map = first_level & (~0ull << (fl + 1));
+            if (fl_map == 0) {
+                return -1;
+            }
+            fl = ffs(fl_map);
+            sl_map = second_level[static_cast<size_t>(fl)];
+        }
+        return heads[static_cast<size_t>(fl)][static_cast<size_t>(ffs(sl_map))];
+    }
+    
+    // Tamano del mayor bloque libre. Está en la lista no vacía más alta, cuyos bloques
+    // difieren en menos de 1/SL_COUNT; solo se recorre esa lista cuando se quitó el
+    // mayor conocido, y nunca dentro de una asignación o liberación.
+    Address largest() const {
+        if (first_level == 0) {
+            return 0;
+        }
+        if (largest_stale) {
+            int fl = fls(first_level);
+            int sl = fls(second_level[static_cast<size_t>(fl)]);
+            largest_size = 0;
+            for (Address start = heads[static_cast<size_t>(fl)][static_cast<size_t>(sl)]; start >= 0;) {
+                const Link* link = links.find(start);
+                largest_size = std::max(largest_size, link->size);
+                start = link->next;
+            }
+            largest_stale = false;
+        }
+        return largest_size;
+    }
+    
+    size_t count() const {
+        return links.size();
+    }
+    
+    // Consulta para la verificación de invariantes
+    bool contains(Address start, Address size) const {
+        const Link* link = links.find(start);
+        return link != nullptr && link->size == size;
+    }
+    
+    // Recorre todas las listas: cada bloque está en la de su tamano con enlaces
+    // coherentes y los mapas de bits reflejan exactamente las listas no vacías
+    bool check(std::string& problem) const {
+        size_t listed = 0;
+        uint64_t expected_first = 0;
+        for (int fl = 0; fl < FL_COUNT; fl++) {
+            uint32_t expected_second = 0;
+            for (int sl = 0; sl < SL_COUNT; sl++) {
+                Address previous = -1;
+                for (Address start = heads[static_cast<size_t>(fl)][static_cast<size_t>(sl)]; start >= 0;) {
+                    const Link* link = links.find(start);
+                    int block_fl = -1, block_sl = -1;
+                    if (link != nullptr) {
+                        mapping(link->size, block_fl, block_sl);
+                    }
+                    if (link == nullptr || link->previous != previous || block_fl != fl || block_sl != sl ||
+                        ++listed > links.size()) {
+                        problem = "la lista segregada (" + std::to_string(fl) + ", " + std::to_string(sl) +
+                                  ") esta mal enlazada en " + std::to_string(start);
+                        return false;
+                    }
+                    expected_second |= 1u << sl;
+                    previous = start;
+                    start = link->next;
+                }
+            }
+            if (second_level[static_cast<size_t>(fl)] != expected_second) {
+                problem = "el mapa de bits del nivel " + std::to_string(fl) + " no coincide con sus listas";
+                return false;
+            }
+            if (expected_second != 0) {
+                expected_first |= 1ull << fl;
+            }
+        }
+        if (first_level != expected_first || listed != links.size()) {
+            problem = "las listas segregadas enlazan " + std::to_string(listed) + " de " +
+                      std::to_string(links.size()) + " bloques o el mapa de primer nivel no coincide";
+            return false;
+        }
+        return true;
+    }
+};
+
+// Sin estructura auxiliar: las políticas recorren la lista de bloques. Solo lleva
+// la cantidad de bloques libres de cada tamano para conocer el mayor en O(log n); con
+// las listas segregadas activas las lleva ellas y el mapa queda vacío.
+class LinearScanIndex {
+private:
+    // tamano de bloque libre -> cantidad de bloques; los nodos salen de un pool
+    std::map<Address, long long, std::less<Address>, PoolAllocator<std::pair<const Address, long long>>> size_counts;
+    SegregatedFreeLists lists;
+    Address units = 0;
+
+public:
+    static constexpr bool ordered_by_size = false;
+    
+    void insert(Address start, Address size) {
+        if (lists.enabled()) {
+            lists.insert(start, size);
+        } else {
+            size_counts[size]++;
+        }
+        units += size;
+    }
+    
+    void erase(Address start, Address size) {
+        if (lists.enabled()) {
+            lists.erase(start, size);
+        } else {
+            auto it = size_counts.find(size);
+            if (--it->second == 0) {
+                size_counts.erase(it);
+            }
+        }
+        units -= size;
+    }
+    
+    // Vaciar el índice y activar o desactivar las listas de TLSF; quien lo llama vuelve
+    // a insertar los bloques libres
+    void set_segregated(bool enabled, size_t expected_blocks) {
+        size_counts.clear();
+        units = 0;
+        lists.set_enabled(enabled, expected_blocks);
+    }
+    
+    const SegregatedFreeLists& segregated() const {
+        return lists;
+    }
+    
+    Address largest() const {
+        if (lists.enabled()) {
+            return lists.largest();
+        }
+        return size_counts.empty() ? 0 : size_counts.rbegin()->first;
+    }
+    
+    // Unidades libres en total (para la fragmentación externa)
+    Address free_units() const {
+        return units;
+    }
+    
+    // Consultas para la verificación de invariantes (recorren el mapa)
+    size_t count() const {
+        if (lists.enabled()) {
+            return lists.count();
+        }
+        size_t total = 0;
+        for (const auto& entry : size_counts) {
+            total += static_cast<size_t>(entry.second);
+        }
+        return total;
+    }
+    
+    bool contains(Address start, Address size) const {
+        return lists.enabled() ? lists.contains(start, size) : size_counts.find(size) != size_counts.end();
+    }
+};
+
+// Bloques libres ordenados por (tamano, inicio): Best Fit y Worst Fit se resuelven
+// en O(log n) y con el mismo desempate que el recorrido lineal (el de menor inicio).
+// Una copia por dirección deja que First Fit recorra solo los bloques libres. Con TLSF
+// en uso solo se llevan las listas segregadas, así que asignar y liberar no tocan los
+// árboles; al volver a otro algoritmo se reconstruyen (set_segregated).
+class SizeOrderedIndex {
+private:
+    using FreeSet = std::set<std::pair<Address, Address>, std::less<std::pair<Address, Address>>,
+                             PoolAllocator<std::pair<Address, Address>>>;
+    
+    // (tamano, inicio) y (inicio, tamano); los nodos salen de un pool y se reutilizan
+    FreeSet free_blocks;
+    FreeSet by_address;
+    SegregatedFreeLists lists;
+    Address units = 0;
+
+public:
+    static constexpr bool ordered_by_size = true;
+    
+    void insert(Address start, Address size) {
+        if (lists.enabled()) {
+            lists.insert(start, size);
+        } else {
+            free_blocks.emplace(size, start);
+            by_address.emplace(start, size);
+        }
+        units += size;
+    }
+    
+    void erase(Address start, Address size) {
+        if (lists.enabled()) {
+            lists.erase(start, size);
+        } else {
+            free_blocks.erase({size, start});
+            by_address.erase({start, size});
+        }
+        units -= size;
+    }
+    
+    void set_segregated(bool enabled, size_t expected_blocks) {
+        free_blocks.clear();
+        by_address.clear();
+        units = 0;
+        lists.set_enabled(enabled, expected_blocks);
+    }
+    
+    const SegregatedFreeLists& segregated() const {
+        return lists;
+    }
+    
+    Address largest() const {
+        if (lists.enabled()) {
+            return lists.largest();
+        }
+        return free_blocks.empty() ? 0 : free_blocks.rbegin()->first;
+    }
+    
+    Address free_units() const {
+        return units;
+    }
+    
+    size_t count() const {
+        return lists.enabled() ? lists.count() : free_blocks.size();
+    }
+    
+    bool contains(Address start, Address size) const {
+        if (lists.enabled()) {
+            return lists.contains(start, size);
+        }
+        return free_blocks.count({size, start}) > 0 && by_address.count({start, size}) > 0;
+    }
+    
+    // Inicio del primer bloque libre (por dirección) con tamano >= size, o -1;
+    // `probes` cuenta los bloques libres examinados
+    Address first_fit(Address size, uint32_t& probes) const {
+        probes = 0;
+        for (const auto& [start, block_size] : by_address) {
+            probes++;
+            if (block_size >= size) {
+                return start;
+            }
+        }
+        return -1;
+    }
+    
+    // Inicio del menor bloque con tamano >= size, o -1
+    Address best_fit(Address size) const {
+        auto it = free_blocks.lower_bound({size, LLONG_MIN});
+        return it == free_blocks.end() ? -1 : it->second;
+    }
+    
+    // Inicio del mayor bloque si alcanza para `size`, o -1
+    Address worst_fit(Address size) const {
+        Address largest_size = largest();
+        if (largest_size < size) {
+            return -1;
+        }
+        return free_blocks.lower_bound({largest_size, LLONG_MIN})->second;
+    }
+};
+
+// ============================================================================
+// POLÍTICAS DE COLOCACIÓN
+// ============================================================================
+// Cada política elige el nodo del bloque libre donde se asigna (select) y
+// recibe aviso de la asignación realizada (placed). Al ser tipos concretos, el
+// compilador especializa e incrusta el bucle de búsqueda en cada gestor. `probes`
+// guarda cuántos bloques examinó la última búsqueda (una consulta al índice cuenta 1).
+
+// Algoritmo First Fit - el primer bloque libre que quepa
+struct FirstFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::FIRST_FIT;
+    uint32_t probes = 0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        probes = 1;
+        if (index.largest() < size) {
+            return NO_BLOCK;
+        }
+        if constexpr (FreeIndex::ordered_by_size) {
+            Address start = index.first_fit(size, probes);
+            return start < 0 ? NO_BLOCK : blocks.find(start);
+        } else {
+            uint32_t examined = 0;
+            for (size_t node = blocks.first(); node != NO_BLOCK; node = blocks.next(node)) {
+                examined++;
+                if (blocks[node].is_free && blocks[node].size >= size) {
+                    probes = examined;
+                    return node;
+                }
+            }
+            probes = examined;
+            return NO_BLOCK;
+        }
+    }
+    
+    void placed(Address, Address) {}
+};
+
+// Algoritmo Best Fit - encuentra el bloque libre más pequeño que quepa
+struct BestFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::BEST_FIT;
+    uint32_t probes = 0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        if constexpr (FreeIndex::ordered_by_size) {
+            probes = 1;
+            Address start = index.best_fit(size);
+            return start < 0 ? NO_BLOCK : blocks.find(start);
+        } else {
+            probes = static_cast<uint32_t>(blocks.size());
+            size_t best = NO_BLOCK;
+            Address best_size = LLONG_MAX;
+            for (size_t node = blocks.first(); node != NO_BLOCK; node = blocks.next(node)) {
+                if (blocks[node].is_free && blocks[node].size >= size && blocks[node].size < best_size) {
+                    best = node;
+                    best_size = blocks[node].size;
+                }
+            }
+            return best;
+        }
+    }
+    
+    void placed(Address, Address) {}
+};
+
+// Algoritmo Worst Fit - encuentra el bloque libre más grande
+struct WorstFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::WORST_FIT;
+    uint32_t probes = 0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        if constexpr (FreeIndex::ordered_by_size) {
+            probes = 1;
+            Address start = index.worst_fit(size);
+            return start < 0 ? NO_BLOCK : blocks.find(start);
+        } else {
+            probes = static_cast<uint32_t>(blocks.size());
+            size_t worst = NO_BLOCK;
+            Address worst_size = -1;
+            for (size_t node = blocks.first(); node != NO_BLOCK; node = blocks.next(node)) {
+                if (blocks[node].is_free && blocks[node].size >= size && blocks[node].size > worst_size) {
+                    worst = node;
+                    worst_size = blocks[node].size;
+                }
+            }
+            return worst;
+        }
+    }
+    
+    void placed(Address, Address) {}
+};
+
+// Algoritmo Next Fit - como First Fit, pero la búsqueda continúa (en forma
+// circular) desde donde terminó la última asignación
+struct NextFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::NEXT_FIT;
+    Address rover = 0; // dirección donde empieza la próxima búsqueda
+    uint32_t probes = 0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        probes = 1;
+        if (index.largest() < size) {
+            return NO_BLOCK;
+        }
+        size_t node = blocks.containing(rover);
+        for (size_t n = 0; n < blocks.size(); n++) {
+            if (blocks[node].is_free && blocks[node].size >= size) {
+                probes = static_cast<uint32_t>(n + 1);
+                return node;
+            }
+            node = blocks.next(node) == NO_BLOCK ? blocks.first() : blocks.next(node);
+        }
+        probes = static_cast<uint32_t>(blocks.size());
+        return NO_BLOCK;
+    }
+    
+    void placed(Address start, Address size) {
+        rover = start + size;
+    }
+};
+
+// Algoritmo TLSF - la cabeza de la primera lista segregada que garantiza el tamano.
+// La búsqueda no depende de cuántos bloques haya: mientras TLSF está en uso ambos
+// índices llevan solo las listas segregadas.
+struct TlsfFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::TLSF;
+    uint32_t probes = 0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        probes = 1;
+        Address start = index.segregated().find(size);
+        return start < 0 ? NO_BLOCK : blocks.find(start);
+    }
+    
+    void placed(Address, Address) {}
+};
+
+// Cambio de política del algoritmo adaptativo, con lo medido en la ventana que lo decidió
+struct AdaptiveSwitch {
+    long long request;         // búsquedas hechas hasta el cambio
+    AllocationAlgorithm from;
+    AllocationAlgorithm to;
+    double probes;             // sondas por búsqueda en la ventana
+    double failure_rate;       // fracción de búsquedas sin hueco
+    double fragmentation;      // fragmentación externa media (1 - mayor hueco / libre)
+    bool exploring;            // prueba una política sin medición reciente
+};
+
+// Algoritmo adaptativo - delega en First, Best o Worst Fit. Cada WINDOW búsquedas mide
+// el costo medio de la política vigente: sondas, más FAILURE_COST por búsqueda sin
+// hueco, más FRAGMENTATION_COST por la fragmentación externa. Pasa a la de menor costo
+// medido si mejora la vigente en más de un 10%. Como el costo cambia con el estado de la
+// memoria, cada tanto prueba una ventana la que lleva más tiempo sin medirse: a las
+// EXPLORE_EVERY ventanas y, si la prueba no convence, al doble (hasta MAX_EXPLORE_EVERY).
+// Además elige por tamano: una solicitud de más de la mitad del mayor hueco va con Best
+// Fit, para no partir ese hueco si otro menor alcanza; esas búsquedas no son de la
+// política vigente y quedan fuera de la ventana. Cada cambio queda en `switches`.
+struct AdaptiveFit {
+    static constexpr AllocationAlgorithm algorithm = AllocationAlgorithm::ADAPTIVE;
+    static constexpr int WINDOW = 256;
+    static constexpr int EXPLORE_EVERY = 16;
+    static constexpr int MAX_EXPLORE_EVERY = 512;
+    static constexpr double FAILURE_COST = 256.0;
+    static constexpr double FRAGMENTATION_COST = 32.0;
+    static constexpr double HYSTERESIS = 0.9;
+    static constexpr std::array<AllocationAlgorithm, 3> CANDIDATES = {
+        AllocationAlgorithm::FIRST_FIT, AllocationAlgorithm::BEST_FIT, AllocationAlgorithm::WORST_FIT};
+    
+    uint32_t probes = 0;
+    FirstFit first_fit;
+    BestFit best_fit;
+    WorstFit worst_fit;
+    AllocationAlgorithm active = AllocationAlgorithm::FIRST_FIT;
+    std::array<double, 3> cost = {-1.0, -1.0, -1.0}; // costo medido por candidato; < 0 sin medir
+    std::array<long long, 3> measured_at{};          // ventana de la última medición
+    long long requests = 0;
+    long long windows = 0;
+    long long large_requests = 0;                    // con Best Fit por su tamano, fuera de la ventana
+    std::vector<AdaptiveSwitch> switches;
+    long long explore_every = EXPLORE_EVERY;         // ventanas entre exploraciones
+    long long explored_at = 0;                       // ventana de la última exploración
+    AllocationAlgorithm explored_from = AllocationAlgorithm::FIRST_FIT;
+    bool exploring = false;                          // la ventana en curso es una prueba
+    
+    // Ventana en curso
+    int window_requests = 0;
+    long long window_probes = 0;
+    int window_failures = 0;
+    double window_fragmentation = 0.0;
+    
+    template <class FreeIndex>
+    size_t select(const BlockList& blocks, const FreeIndex& index, Address size) {
+        Address largest = index.largest();
+        Address free_units = index.free_units();
+        AllocationAlgorithm choice = active;
+        if (size <= largest && size > largest / 2 && active != AllocationAlgorithm::BEST_FIT) {
+            choice = AllocationAlgorithm::BEST_FIT;
+            large_requests++;
+        }
+        
+        size_t node;
+        switch (choice) {
+            case AllocationAlgorithm::BEST_FIT:
+                node = best_fit.select(blocks, index, size);
+                probes = best_fit.probes;
+                break;
+            case AllocationAlgorithm::WORST_FIT:
+                node = worst_fit.select(blocks, index, size);
+                probes = worst_fit.probes;
+                break;
+            default:
+                node = first_fit.select(blocks, index, size);
+                probes = first_fit.probes;
+                break;
+        }
+        
+        requests++;
+        if (choice != active) {
+            return node;
+        }
+        window_requests++;
+        window_probes += probes;
+        window_failures += node == NO_BLOCK ? 1 : 0;
+        window_fragmentation += free_units > 0 ? 1.0 - static_cast<double>(largest) / static_cast<double>(free_units) : 0.0;
+        if (window_requests == WINDOW) {
+            close_window();
+        }
+        return node;
+    }
+    
+    void placed(Address, Address) {}
+    
+    // Registra el costo de la ventana y decide la política de la siguiente
+    void close_window() {
+        double count = static_cast<double>(window_requests);
+        double mean_probes = static_cast<double>(window_probes) / count;
+        double failure_rate = window_failures / count;
+        double fragmentation = window_fragmentation / count;
+        double observed = mean_probes + FAILURE_COST * failure_rate + FRAGMENTATION_COST * fragmentation;
+        size_t slot = static_cast<size_t>(active);
+        cost[slot] = cost[slot] < 0.0 ? observed : (cost[slot] + observed) / 2.0;
+        measured_at[slot] = windows++;
+        window_requests = 0;
+        window_probes = 0;
+        window_failures = 0;
+        window_fragmentation = 0.0;
+        
+        // Tras una prueba: si se vuelve a la política anterior, se espacian las pruebas
+        AllocationAlgorithm next = active;
+        bool was_exploring = exploring;
+        exploring = false;
+        for (AllocationAlgorithm candidate : CANDIDATES) {
+            double candidate_cost = cost[static_cast<size_t>(candidate)];
+            if (candidate_cost >= 0.0 && candidate_cost < cost[static_cast<size_t>(next)]) {
+                next = candidate;
+            }
+        }
+        if (!was_exploring && cost[static_cast<size_t>(next)] >= cost[slot] * HYSTERESIS) {
+            next = active;
+        }
+        if (was_exploring) {
+            explore_every = next == explored_from ? std::min<long long>(explore_every * 2, MAX_EXPLORE_EVERY)
+                                                  : EXPLORE_EVERY;
+        }
+        
+        for (AllocationAlgorithm candidate : CANDIDATES) {
+            if (cost[static_cast<size_t>(candidate)] < 0.0) {
+                explored_from = next;
+                next = candidate; // todavía sin medir: se prueba antes que nada
+                exploring = true;
+                break;
+            }
+        }
+        if (!exploring && windows - explored_at >= explore_every) {
+            AllocationAlgorithm stalest = next;
+            for (AllocationAlgorithm candidate : CANDIDATES) {
+                if (candidate != next && (stalest == next || measured_at[static_cast<size_t>(candidate)] <
+                                                                 measured_at[static_cast<size_t>(stalest)])) {
+                    stalest = candidate;
+                }
+            }
+            explored_from = next;
+            next = stalest;
+            exploring = true;
+        }
+        if (exploring) {
+            explored_at = windows;
+        }
+        if (next != active) {
+            switches.push_back({requests, active, next, mean_probes, failure_rate, fragmentation, exploring});
+            active = next;
+        }
+    }
+};
+
+// ============================================================================
+// GESTORES
+// ============================================================================
+
+// Nombre de proceso -> inicio de su bloque en O(1) esperado. La tabla hash se indexa
+// con un hash de 64 bits del nombre y no guarda nombres: el del bloque confirma cada
+// coincidencia. Si dos procesos vivos comparten hash (improbable), el segundo va a un
+// mapa ordenado aparte. Las entradas se reutilizan, así que A y L no piden memoria en
+// régimen estable.
+class ProcessTable {
+private:
+    AddressMap<Address> by_hash;
+    std::map<std::string, Address, std::less<>> colliding;
+    
+    static long long key(std::string_view name) {
+        return static_cast<long long>(std::hash<std::string_view>{}(name));
+    }
+    
+    // Entrada principal de `name`, si es de ese proceso
+    const Address* primary(const BlockList& blocks, std::string_view name) const {
+        const Address* start = by_hash.find(key(name));
+        return start != nullptr && blocks[blocks.find(*start)].process_name == name ? start : nullptr;
+    }
+
+public:
+    size_t size() const {
+        return by_hash.size() + colliding.size();
+    }
+    
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    // Inicio del bloque de `name`, o nullptr si no es un proceso vivo
+    const Address* find(const BlockList& blocks, std::string_view name) const {
+        const Address* start = primary(blocks, name);
+        if (start != nullptr || colliding.empty()) {
+            return start;
+        }
+        auto it = colliding.find(name);
+        return it == colliding.end() ? nullptr : &it->second;
+    }
+    
+    // Registrar `name` (que no debe estar) en `start`
+    void insert(std::string_view name, Address start) {
+        if (by_hash.find(key(name)) == nullptr) {
+            by_hash.insert(key(name), start);
+        } else {
+            colliding.emplace(std::string(name), start);
+        }
+    }
+    
+    // Quitar `name`; su bloque todavía debe llevar el nombre
+    void erase(const BlockList& blocks, std::string_view name) {
+        if (primary(blocks, name) != nullptr) {
+            by_hash.erase(key(name));
+        } else if (!colliding.empty()) {
+            auto it = colliding.find(name);
+            if (it != colliding.end()) {
+                colliding.erase(it);
+            }
+        }
+    }
+};
+
+// Estado común a todos los gestores: bloques enlazados por dirección, ubicación de
+// cada proceso, contadores e índice de libres. La asignación recibe la política.
+template <class FreeIndex>
+class BlockStore {
+protected:
+    // Capacidad inicial de la lista de bloques; luego crece sin encogerse nunca
+    static constexpr int INITIAL_BLOCK_CAPACITY = 1024;
+    
+    Address total_memory;
+    BlockList memory_blocks;
+    ProcessTable process_locations; // Para rastrear dónde están los procesos
+    MemoryCounters counters;
+    FreeIndex free_index;
+    BlockLayout layout;
+    QuickListConfig quick;
+    std::vector<std::vector<Address>> quick_lists; // inicios aparcados, indexados por tamano
+    DecisionSink* decision_sink = nullptr;
+    
+    // Hueco fusionado por coalesce_freed a la espera de entrar al índice, con el orden
+    // en que la liberación en secuencia lo habría insertado
+    struct PendingHole {
+        int order;
+        Address start;
+        Address size;
+    };
+    std::vector<PendingHole> pending_holes;
+    std::vector<size_t> freed_blocks; // nodos liberados sin fusionar, para coalesce_freed
+    std::vector<std::pair<Address, Address>> merged_starts; // inicio absorbido -> inicio de su hueco
+    
+    // Informar la decisión al destino registrado (solo si hay uno). La secuencia es la
+    // operación en curso salvo que se indique otra (los lotes informan al final).
+    void record_decision(char op, OpStatus status, uint8_t algorithm, Address size, Address start,
+                         Address hole_size, uint32_t probes, long long sequence = -1) {
+        decision_sink->on_decision({static_cast<uint32_t>(sequence < 0 ? counters.operations : sequence),
+                                    static_cast<uint8_t>(op), static_cast<uint8_t>(status), algorithm, 0, size,
+                                    start, hole_size, probes, 0});
+    }
+    
+    // Registrar la aparición o desaparición de un bloque libre en los contadores
+    void add_free_block(Address start, Address size) {
+        free_index.insert(start, size);
+        counters.free_memory += size;
+        counters.free_blocks++;
+    }
+    
+    void remove_free_block(Address start, Address size) {
+        free_index.erase(start, size);
+        counters.free_memory -= size;
+        counters.free_blocks--;
+    }
+    
+    // Activar o desactivar las listas segregadas de TLSF. El índice se rehace con los
+    // bloques libres en orden de dirección: en las listas al activarlas y en sus
+    // estructuras propias al desactivarlas. No cambia nada si ya estaban así.
+    void track_segregated(bool enabled) {
+        if (free_index.segregated().enabled() == enabled) {
+            return;
+        }
+        free_index.set_segregated(enabled, memory_blocks.capacity());
+        for (const MemoryBlock& block : memory_blocks) {
+            if (block.is_free && !block.cached) {
+                free_index.insert(block.start, block.size);
+            }
+        }
+    }
+    
+    // Función auxiliar para realizar la asignación en el bloque libre de `node`. `size`
+    // es el tamano del bloque según layout y `requested` lo que pidió el proceso. El
+    // nodo pasa a ser el del proceso y el sobrante se enlaza a continuación: O(1).
+    Address allocate_block(size_t node, std::string_view process_name, Address size, Address requested) {
+        MemoryBlock& hole = memory_blocks[node];
+        Address start_pos = hole.start;
+        Address remaining_size = hole.size - size;
+        if (remaining_size > 0 && remaining_size < layout.min_split) {
+            // Astilla menor que min_split: se entrega al proceso
+            size = hole.size;
+            remaining_size = 0;
+        }
+        
+        remove_free_block(start_pos, hole.size);
+        if (remaining_size > 0) {
+            add_free_block(start_pos + size, remaining_size);
+        }
+        counters.used_memory += size;
+        counters.requested_memory += requested;
+        counters.header_memory += layout.header;
+        
+        hole.size = size;
+        hole.process_name.assign(process_name.data(), process_name.size());
+        hole.is_free = false;
+        hole.requested = requested;
+        if (remaining_size > 0) {
+            // Si queda espacio, el resto sigue libre a continuación del bloque ocupado
+            memory_blocks.insert_after(node, start_pos + size, remaining_size);
+        }
+        
+        process_locations.insert(process_name, start_pos);
+        return start_pos;
+    }
+    
+    // Marcar un bloque ocupado como libre y fusionarlo con sus vecinos libres. Como
+    // nunca hay dos bloques libres contiguos, solo pueden fusionarse los dos vecinos.
+    // Devuelve el tamano del bloque libre resultante.
+    Address release_block(size_t node) {
+        MemoryBlock& block = memory_blocks[node];
+        block.is_free = true;
+        block.process_name.clear();
+        counters.used_memory -= block.size;
+        counters.requested_memory -= block.requested;
+        counters.header_memory -= layout.header;
+        block.requested = 0;
+        
+        Address start = block.start;
+        Address size = block.size;
+        
+        size_t next = memory_blocks.next(node);
+        if (next != NO_BLOCK && memory_blocks[next].is_free) {
+            remove_free_block(memory_blocks[next].start, memory_blocks[next].size);
+            size += memory_blocks[next].size;
+            memory_blocks.erase(next);
+        }
+        
+        size_t previous = memory_blocks.previous(node);
+        if (previous != NO_BLOCK && memory_blocks[previous].is_free) {
+            MemoryBlock& absorbing = memory_blocks[previous];
+            remove_free_block(absorbing.start, absorbing.size);
+            start = absorbing.start;
+            size += absorbing.size;
+            absorbing.size = size;
+            memory_blocks.erase(node);
+        } else {
+            block.size = size;
+        }
+        
+        add_free_block(start, size);
+        return size;
+    }
+    
+    // Aparcar el bloque ocupado de `node` en su lista rápida: deja de pertenecer al
+    // proceso, pero no se fusiona ni entra al índice de libres
+    void park_block(size_t node) {
+        MemoryBlock& block = memory_blocks[node];
+        counters.used_memory -= block.size;
+        counters.requested_memory -= block.requested;
+        counters.header_memory -= layout.header;
+        counters.cached_memory += block.size;
+        counters.cached_blocks++;
+        block.process_name.clear();
+        block.requested = 0;
+        block.cached = true;
+        quick_lists[static_cast<size_t>(block.size)].push_back(block.start);
+    }
+    
+    // Entregar el bloque aparcado más reciente de `block_size` unidades, si hay uno.
+    // Devuelve su inicio, o -1 si el tamano no tiene lista o la lista está vacía.
+    Address take_parked(std::string_view process_name, Address block_size, Address requested) {
+        if (!quick.enabled() || block_size > quick.max_size) {
+            return -1;
+        }
+        std::vector<Address>& list = quick_lists[static_cast<size_t>(block_size)];
+        if (list.empty()) {
+            counters.quick_misses++;
+            return -1;
+        }
+        
+        Address start = list.back();
+        list.pop_back();
+        MemoryBlock& block = memory_blocks[memory_blocks.find(start)];
+        block.cached = false;
+        block.process_name.assign(process_name.data(), process_name.size());
+        block.requested = requested;
+        counters.quick_hits++;
+        counters.cached_memory -= block_size;
+        counters.cached_blocks--;
+        counters.used_memory += block_size;
+        counters.requested_memory += requested;
+        counters.header_memory += layout.header;
+        process_locations.insert(process_name, start);
+        return start;
+    }
+    
+    // Vaciar las listas rápidas: cada aparcado queda libre sin fusionar, marcado con el
+    // orden `order` para coalesce_freed, y se agrega a freed_blocks
+    void unpark_all(int order) {
+        for (auto& list : quick_lists) {
+            for (Address start : list) {
+                size_t node = memory_blocks.find(start);
+                MemoryBlock& block = memory_blocks[node];
+                block.cached = false;
+                block.is_free = true;
+                block.requested = -(order + 1);
+                counters.cached_memory -= block.size;
+                counters.cached_blocks--;
+                counters.quick_flushed_blocks++;
+                freed_blocks.push_back(node);
+            }
+            list.clear();
+        }
+        counters.quick_flushes++;
+    }
+    
+    // Consolidación diferida: los aparcados vuelven al espacio libre con una sola
+    // pasada de fusión, la misma que usa LB
+    void flush_quick_lists() {
+        if (counters.cached_blocks == 0) {
+            return;
+        }
+        freed_blocks.clear();
+        unpark_all(0);
+        coalesce_freed();
+    }
+    
+    // Aparcar un bloque de `size` superaría el tope de memoria en las listas rápidas. El
+    // tope se calcula por partes para no multiplicar total_memory, que desbordaría.
+    bool quick_lists_full(Address size) const {
+        Address limit = total_memory / 100 * quick.max_cached_percent +
+                        total_memory % 100 * quick.max_cached_percent / 100;
+        return counters.cached_memory + size > limit;
+    }
+    
+    // Liberar el bloque ocupado de `node`: se aparca si su lista rápida tiene lugar y, si
+    // no, se fusiona como siempre. Con el tope superado primero se consolidan todas las
+    // listas (la consolidación no toca los bloques ocupados, así que `node` sigue
+    // valiendo). Devuelve el hueco resultante (el propio bloque si se aparcó).
+    Address free_block(size_t node) {
+        Address size = memory_blocks[node].size;
+        if (quick.enabled() && size <= quick.max_size) {
+            if (quick_lists_full(size)) {
+                flush_quick_lists();
+            } else if (quick_lists[static_cast<size_t>(size)].size() < static_cast<size_t>(quick.depth)) {
+                park_block(node);
+                return size;
+            }
+        }
+        return release_block(node);
+    }
+    
+    // Validar la solicitud, pedir el bloque a la política y asignarlo; `hole_size` es el
+    // tamano del bloque libre elegido antes de cortarlo
+    template <class Placement>
+    OpStatus allocate_with_policy(Placement& placement, std::string_view process_name, Address size,
+                                  Address& start, Address& hole_size) {
+        counters.operations++;
+        start = -1;
+        
+        if (size <= 0) {
+            return OpStatus::INVALID_SIZE;
+        }
+        
+        if (process_locations.find(memory_blocks, process_name) != nullptr) {
+            return OpStatus::DUPLICATE;
+        }
+        
+        Address block_size = layout.block_size(size);
+        start = take_parked(process_name, block_size, size);
+        if (start >= 0) {
+            placement.probes = 0; // la lista rápida no consulta a la política
+            hole_size = block_size;
+            return OpStatus::OK;
+        }
+        
+        size_t node = placement.select(memory_blocks, free_index, block_size);
+        if (node == NO_BLOCK && counters.cached_blocks > 0) {
+            flush_quick_lists(); // ante un fallo se consolidan los aparcados y se reintenta
+            node = placement.select(memory_blocks, free_index, block_size);
+        }
+        if (node == NO_BLOCK) {
+            counters.failed_allocations++;
+            return OpStatus::NO_MEMORY;
+        }
+        
+        hole_size = memory_blocks[node].size;
+        start = allocate_block(node, process_name, block_size, size);
+        placement.placed(start, memory_blocks[node].size);
+        return OpStatus::OK;
+    }
+    
+    // Liberar el bloque del proceso; `hole_size` es el hueco libre que queda tras fusionar
+    OpStatus release_process(std::string_view process_name, Address& start, Address& size, Address& hole_size) {
+        counters.operations++;
+        start = -1;
+        size = 0;
+        
+        const Address* location = process_locations.find(memory_blocks, process_name);
+        if (location == nullptr) {
+            return OpStatus::NOT_FOUND;
+        }
+        
+        size_t node = memory_blocks.find(*location);
+        process_locations.erase(memory_blocks, process_name);
+        if (node == NO_BLOCK || memory_blocks[node].is_free || memory_blocks[node].process_name != process_name) {
+            return OpStatus::NOT_FOUND;
+        }
+        
+        start = memory_blocks[node].start;
+        size = memory_blocks[node].size;
+        hole_size = free_block(node);
+        return OpStatus::OK;
+    }
+    
+    // Achicar en el lugar el bloque de `node` a `size`: la cola sobrante queda libre y se
+    // une al vecino siguiente si está libre. Una cola menor que min_split sin vecino
+    // libre se queda en el bloque, igual que al asignar.
+    void shrink_block(size_t node, Address size) {
+        MemoryBlock& block = memory_blocks[node];
+        Address tail = block.size - size;
+        size_t next = memory_blocks.next(node);
+        bool next_free = next != NO_BLOCK && memory_blocks[next].is_free;
+        if (tail == 0 || (tail < layout.min_split && !next_free)) {
+            return;
+        }
+        
+        Address tail_start = block.start + size;
+        block.size = size;
+        counters.used_memory -= tail;
+        if (next_free) {
+            MemoryBlock& following = memory_blocks[next];
+            remove_free_block(following.start, following.size);
+            memory_blocks.move_start(next, tail_start);
+            following.size += tail;
+            add_free_block(following.start, following.size);
+        } else {
+            memory_blocks.insert_after(node, tail_start, tail);
+            add_free_block(tail_start, tail);
+        }
+    }
+    
+    // Agrandar en el lugar el bloque de `node` a `size` tomando el comienzo del bloque
+    // libre siguiente. Devuelve false si no hay uno o no alcanza.
+    bool grow_in_place(size_t node, Address size) {
+        size_t next = memory_blocks.next(node);
+        if (next == NO_BLOCK || !memory_blocks[next].is_free) {
+            return false;
+        }
+        MemoryBlock& block = memory_blocks[node];
+        MemoryBlock& following = memory_blocks[next];
+        Address extra = size - block.size;
+        if (following.size < extra) {
+            return false;
+        }
+        Address remaining = following.size - extra;
+        if (remaining > 0 && remaining < layout.min_split) {
+            extra = following.size;
+            remaining = 0;
+        }
+        
+        remove_free_block(following.start, following.size);
+        block.size += extra;
+        counters.used_memory += extra;
+        if (remaining > 0) {
+            memory_blocks.move_start(next, following.start + extra);
+            following.size = remaining;
+            add_free_block(following.start, following.size);
+        } else {
+            memory_blocks.erase(next);
+        }
+        return true;
+    }
+    
+    // Cambiar el tamano del bloque de un proceso (comando R). Achicar siempre se hace en
+    // el lugar y agrandar usa el bloque libre siguiente si alcanza. Si no, la política
+    // elige un hueco nuevo (se asigna antes de liberar el viejo, como realloc) y, como
+    // último recurso, el proceso se desliza sobre el hueco que forma con sus vecinos
+    // libres. `moved` recibe las unidades copiadas (lo pedido antes del cambio) y
+    // `searched` indica si se consultó a la política.
+    template <class Placement>
+    OpStatus resize_with_policy(Placement& placement, std::string_view process_name, Address new_size,
+                                Address& start, Address& moved, bool& searched) {
+        counters.operations++;
+        start = -1;
+        moved = 0;
+        searched = false;
+        
+        if (new_size <= 0) {
+            return OpStatus::INVALID_SIZE;
+        }
+        const Address* location = process_locations.find(memory_blocks, process_name);
+        if (location == nullptr) {
+            return OpStatus::NOT_FOUND;
+        }
+        
+        size_t node = memory_blocks.find(*location);
+        Address block_size = layout.block_size(new_size);
+        MemoryBlock& block = memory_blocks[node];
+        if (block_size <= block.size || grow_in_place(node, block_size)) {
+            if (block_size <= block.size) {
+                shrink_block(node, block_size);
+            }
+            MemoryBlock& resized = memory_blocks[node];
+            counters.requested_memory += new_size - resized.requested;
+            resized.requested = new_size;
+            counters.resizes++;
+            start = resized.start;
+            return OpStatus::OK;
+        }
+        
+        std::string name(process_name);
+        Address old_requested = block.requested;
+        searched = true;
+        size_t target = placement.select(memory_blocks, free_index, block_size);
+        if (target != NO_BLOCK) {
+            process_locations.erase(memory_blocks, name);
+            start = allocate_block(target, name, block_size, new_size);
+            placement.placed(start, memory_blocks[target].size);
+            release_block(node);
+        } else {
+            // Hueco formado por el bloque y sus vecinos libres (el siguiente ya no alcanzó solo)
+            size_t previous = memory_blocks.previous(node);
+            size_t next = memory_blocks.next(node);
+            bool previous_free = previous != NO_BLOCK && memory_blocks[previous].is_free;
+            bool next_free = next != NO_BLOCK && memory_blocks[next].is_free;
+            Address region = block.size +
+                             (previous_free ? memory_blocks[previous].size : 0) +
+                             (next_free ? memory_blocks[next].size : 0);
+            if (!previous_free || region < block_size) {
+                counters.failed_allocations++;
+                return OpStatus::NO_MEMORY;
+            }
+            // Al liberar, el bloque se fusiona con el anterior, que conserva su nodo
+            process_locations.erase(memory_blocks, name);
+            release_block(node);
+            start = allocate_block(previous, name, block_size, new_size);
+        }
+        
+        moved = old_requested;
+        counters.resizes++;
+        counters.moves++;
+        counters.moved_memory += moved;
+        return OpStatus::OK;
+    }
+    
+    // Unir en una sola pasada los bloques de freed_blocks con sus vecinos libres. Los
+    // recién liberados llevan requested = -(orden + 1) y aún no están en el índice; de
+    // los demás solo se quitan del índice los que se fusionan, así que cada hueco
+    // resultante entra una vez. Los huecos entran por el mayor orden de sus liberados (y
+    // por dirección dentro del mismo orden), como los habría insertado la liberación en
+    // secuencia: las listas segregadas de TLSF son LIFO y su elección depende de ese
+    // orden. Cada inicio absorbido queda en merged_starts junto al de su hueco.
+    void coalesce_freed() {
+        pending_holes.clear();
+        merged_starts.clear();
+        for (size_t freed : freed_blocks) {
+            if (memory_blocks[freed].requested >= 0) {
+                continue; // ya fusionado en el tramo de otro liberado
+            }
+            size_t run = freed;
+            while (memory_blocks.previous(run) != NO_BLOCK && memory_blocks[memory_blocks.previous(run)].is_free) {
+                run = memory_blocks.previous(run);
+            }
+            
+            MemoryBlock& hole = memory_blocks[run];
+            int order = 0;
+            for (size_t node = run; node != NO_BLOCK && memory_blocks[node].is_free;) {
+                MemoryBlock& block = memory_blocks[node];
+                size_t next = memory_blocks.next(node);
+                if (block.requested == 0) {
+                    remove_free_block(block.start, block.size);
+                }
+                order = std::max(order, static_cast<int>(-block.requested - 1));
+                block.requested = 0;
+                if (node != run) {
+                    hole.size += block.size;
+                    merged_starts.emplace_back(block.start, hole.start);
+                    memory_blocks.erase(node);
+                }
+                node = next;
+            }
+            pending_holes.push_back({order, hole.start, hole.size});
+        }
+        
+        std::sort(pending_holes.begin(), pending_holes.end(), [](const PendingHole& a, const PendingHole& b) {
+            return a.order != b.order ? a.order < b.order : a.start < b.start;
+        });
+        for (const PendingHole& hole : pending_holes) {
+            add_free_block(hole.start, hole.size);
+        }
+    }
+
+public:
+    explicit BlockStore(Address size) : total_memory(size) {
+        memory_blocks.reserve(static_cast<size_t>(std::max<Address>(1, std::min<Address>(size, INITIAL_BLOCK_CAPACITY))));
+        
+        // Inicialmente toda la memoria está libre
+        memory_blocks.insert_after(NO_BLOCK, 0, total_memory);
+        add_free_block(0, total_memory);
+    }
+    
+    Address get_total_memory() const {
+        return total_memory;
+    }
+    
+    // Fijar la forma de los bloques; solo se admite sin procesos asignados, porque cada
+    // liberación descuenta la cabecera vigente
+    bool set_layout(const BlockLayout& block_layout) {
+        if (!process_locations.empty() || block_layout.alignment < 1 || block_layout.min_split < 1 ||
+            block_layout.header < 0) {
+            return false;
+        }
+        layout = block_layout;
+        return true;
+    }
+    
+    const BlockLayout& get_layout() const {
+        return layout;
+    }
+    
+    // Activar, cambiar o desactivar las listas rápidas; los bloques aparcados se
+    // consolidan antes, así que puede hacerse en cualquier momento
+    bool set_quick_lists(const QuickListConfig& config) {
+        if (config.max_size < 0 || config.depth < 1 ||
+            config.max_cached_percent < 1 || config.max_cached_percent > 100) {
+            return false;
+        }
+        flush_quick_lists();
+        quick = config;
+        quick_lists.assign(static_cast<size_t>(config.max_size) + (config.enabled() ? 1 : 0), {});
+        return true;
+    }
+    
+    const QuickListConfig& get_quick_lists() const {
+        return quick;
+    }
+    
+    // Bloques en orden de dirección
+    const BlockList& blocks() const {
+        return memory_blocks;
+    }
+    
+    // Contadores incrementales (sin recorrer memory_blocks)
+    const MemoryCounters& get_counters() const {
+        return counters;
+    }
+    
+    Address get_largest_free_block() const {
+        return free_index.largest();
+    }
+    
+    // Asignación sin mensajes con una política concreta: valida la solicitud, pide el
+    // bloque a la política y lo asigna. Los despachos especializados llaman aquí.
+    template <class Placement>
+    OpStatus try_allocate_with(Placement& placement, std::string_view process_name, Address size, Address& start) {
+        Address hole_size = 0;
+        OpStatus status = allocate_with_policy(placement, process_name, size, start, hole_size);
+        if (decision_sink != nullptr) {
+            bool searched = status == OpStatus::OK || status == OpStatus::NO_MEMORY;
+            record_decision('A', status, static_cast<uint8_t>(Placement::algorithm), size, start, hole_size,
+                            searched ? placement.probes : 0);
+        }
+        return status;
+    }
+    
+    // Liberación sin mensajes: devuelve la posición y el tamano del bloque liberado
+    OpStatus try_deallocate(std::string_view process_name, Address& start, Address& size) {
+        Address hole_size = 0;
+        OpStatus status = release_process(process_name, start, size, hole_size);
+        if (decision_sink != nullptr) {
+            record_decision('L', status, DecisionRecord::NO_ALGORITHM, size, start, hole_size, 0);
+        }
+        return status;
+    }
+    
+    // Asignar un lote (comando AB) con una política concreta. Cada solicitud ve el efecto
+    // de las anteriores y se atiende como en try_allocate_with: cortar un hueco ya cuesta
+    // O(1) en la lista enlazada, así que el lote ahorra el despacho del algoritmo. El
+    // índice se actualiza en cada asignación y no una vez por lote: la política elige
+    // la siguiente solicitud mirando el sobrante que dejó la anterior, y diferir su
+    // entrada al índice cambiaría las posiciones frente a la ejecución en secuencia.
+    template <class Placement>
+    void try_allocate_batch_with(Placement& placement, const std::vector<BatchRequest>& requests,
+                                 std::vector<BatchResult>& results) {
+        results.clear();
+        for (const auto& request : requests) {
+            BatchResult result{OpStatus::OK, -1, request.size};
+            result.status = try_allocate_with(placement, request.process_name, request.size, result.start);
+            results.push_back(result);
+        }
+    }
+    
+    // Liberar un lote (comando LB): cada bloque se marca libre sin fusionar y luego una
+    // sola pasada une cada liberado con sus vecinos libres. El estado final es el mismo
+    // que liberando en secuencia; el hueco informado a decision_sink es el final,
+    // después de todo el lote.
+    void try_deallocate_batch(const std::vector<std::string_view>& names, std::vector<BatchResult>& results) {
+        results.clear();
+        freed_blocks.clear();
+        long long first_operation = counters.operations;
+        int order = 0; // orden de inserción al índice que tendría cada liberación en secuencia
+        for (std::string_view name : names) {
+            counters.operations++;
+            order += 2;
+            BatchResult result{OpStatus::NOT_FOUND, -1, 0};
+            const Address* location = process_locations.find(memory_blocks, name);
+            if (location != nullptr) {
+                size_t node = memory_blocks.find(*location);
+                process_locations.erase(memory_blocks, name);
+                MemoryBlock& block = memory_blocks[node];
+                if (!block.is_free && block.process_name == name) {
+                    result = {OpStatus::OK, block.start, block.size};
+                    bool parked = false;
+                    if (quick.enabled() && block.size <= quick.max_size) {
+                        // Como free_block, pero la consolidación se suma a la pasada del lote
+                        if (quick_lists_full(block.size)) {
+                            unpark_all(order - 1); // la consolidación va antes que este bloque
+                        } else if (quick_lists[static_cast<size_t>(block.size)].size() <
+                                   static_cast<size_t>(quick.depth)) {
+                            park_block(node);
+                            parked = true;
+                        }
+                    }
+                    if (!parked) {
+                        block.is_free = true;
+                        block.process_name.clear();
+                        counters.used_memory -= block.size;
+                        counters.requested_memory -= block.requested;
+                        counters.header_memory -= layout.header;
+                        block.requested = -(order + 1); // liberado en este lote, aún fuera del índice
+                        freed_blocks.push_back(node);
+                    }
+                }
+            }
+            results.push_back(result);
+        }
+        if (!freed_blocks.empty()) {
+            coalesce_freed();
+        }
+        
+        if (decision_sink != nullptr) {
+            // Un bloque absorbido por la fusión se busca por el inicio de su hueco
+            std::sort(merged_starts.begin(), merged_starts.end());
+            for (size_t i = 0; i < results.size(); i++) {
+                const BatchResult& result = results[i];
+                Address hole_size = 0;
+                if (result.status == OpStatus::OK) {
+                    Address hole_start = result.start;
+                    auto merged = std::lower_bound(merged_starts.begin(), merged_starts.end(),
+                                                   std::make_pair(result.start, LLONG_MIN));
+                    if (merged != merged_starts.end() && merged->first == result.start) {
+                        hole_start = merged->second;
+                    }
+                    hole_size = memory_blocks[memory_blocks.find(hole_start)].size;
+                }
+                record_decision('L', result.status, DecisionRecord::NO_ALGORITHM, result.size, result.start,
+                                hole_size, 0, first_operation + static_cast<long long>(i) + 1);
+            }
+        }
+    }
+    
+    // Redimensionar con una política concreta; ver resize_with_policy
+    template <class Placement>
+    OpStatus try_resize_with(Placement& placement, std::string_view process_name, Address new_size,
+                             Address& start, Address& moved) {
+        bool searched;
+        OpStatus status = resize_with_policy(placement, process_name, new_size, start, moved, searched);
+        if (decision_sink != nullptr) {
+            record_decision('R', status, static_cast<uint8_t>(Placement::algorithm), new_size, start, moved,
+                            searched ? placement.probes : 0);
+        }
+        return status;
+    }
+    
+    // Registrar cada decisión de A/L/R en `sink` (nullptr para dejar de registrar)
+    void set_decision_sink(DecisionSink* sink) {
+        decision_sink = sink;
+    }
+    
+    // Verificar un bloque frente a su vecino anterior, el índice y el mapa de procesos:
+    // empieza donde termina el anterior, no hay dos libres contiguos y cada bloque
+    // libre está en el índice y cada ocupado en process_locations con su inicio
+    bool check_block(size_t node, std::string& problem) const {
+        const MemoryBlock& block = memory_blocks[node];
+        size_t previous = memory_blocks.previous(node);
+        Address expected_start = previous == NO_BLOCK ? 0 : memory_blocks[previous].start + memory_blocks[previous].size;
+        if (block.start != expected_start || block.size <= 0) {
+            problem = "el bloque en " + std::to_string(block.start) + " con tamano " + std::to_string(block.size) +
+                      " no sigue al anterior; se esperaba inicio " + std::to_string(expected_start);
+            return false;
+        }
+        if (block.cached) {
+            const std::vector<Address>* list = quick.enabled() && block.size <= quick.max_size
+                                               ? &quick_lists[static_cast<size_t>(block.size)] : nullptr;
+            if (block.is_free || !block.process_name.empty() || list == nullptr ||
+                std::find(list->begin(), list->end(), block.start) == list->end()) {
+                problem = "el bloque aparcado en " + std::to_string(block.start) + " no esta en su lista rapida";
+                return false;
+            }
+        } else if (block.is_free) {
+            if (previous != NO_BLOCK && memory_blocks[previous].is_free) {
+                problem = "bloques libres contiguos en " + std::to_string(memory_blocks[previous].start) + " y " +
+                          std::to_string(block.start);
+                return false;
+            }
+            if (!free_index.contains(block.start, block.size)) {
+                problem = "el bloque libre en " + std::to_string(block.start) + " no esta en el indice";
+                return false;
+            }
+        } else {
+            const Address* location = process_locations.find(memory_blocks, block.process_name);
+            if (location == nullptr || *location != block.start) {
+                problem = "el proceso " + block.process_name + " del bloque en " + std::to_string(block.start) +
+                          " no esta registrado en esa posicion";
+                return false;
+            }
+            if (block.size < layout.block_size(block.requested)) {
+                problem = "el bloque de " + block.process_name + " mide " + std::to_string(block.size) +
+                          " y la solicitud de " + std::to_string(block.requested) + " necesita " +
+                          std::to_string(layout.block_size(block.requested));
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Verificación completa, O(n log n): la lista está bien enlazada, todos los bloques
+    // cubren [0, total) sin huecos ni solapes, cada proceso apunta a su bloque ocupado y
+    // los contadores y el índice coinciden con los bloques. Si algo falla describe el
+    // primer problema en `problem`.
+    bool check_invariants(std::string& problem) const {
+        if (!memory_blocks.check(problem)) {
+            return false;
+        }
+        long long position = 0, used = 0, free = 0, free_blocks = 0, requested = 0, cached = 0, cached_blocks = 0;
+        Address largest = 0;
+        size_t owned = 0;
+        for (size_t node = memory_blocks.first(); node != NO_BLOCK; node = memory_blocks.next(node)) {
+            const MemoryBlock& block = memory_blocks[node];
+            if (!check_block(node, problem)) {
+                return false;
+            }
+            if (block.cached) {
+                cached += block.size;
+                cached_blocks++;
+            } else if (block.is_free) {
+                free += block.size;
+                free_blocks++;
+                largest = std::max(largest, block.size);
+            } else {
+                owned++;
+                used += block.size;
+                requested += block.requested;
+            }
+            position += block.size;
+        }
+        if (position != total_memory) {
+            problem = "los bloques cubren " + std::to_string(position) + " de " + std::to_string(total_memory) +
+                      " unidades";
+            return false;
+        }
+        if (counters.requested_memory != requested ||
+            counters.header_memory != static_cast<long long>(owned) * layout.header) {
+            problem = "las unidades pedidas (" + std::to_string(counters.requested_memory) + ") o las cabeceras (" +
+                      std::to_string(counters.header_memory) + ") no coinciden con los bloques ocupados";
+            return false;
+        }
+        if (owned != process_locations.size()) {
+            problem = std::to_string(process_locations.size()) + " procesos registrados para " +
+                      std::to_string(owned) + " bloques ocupados";
+            return false;
+        }
+        if (counters.used_memory != used || counters.free_memory != free || counters.free_blocks != free_blocks) {
+            problem = "contadores (usada " + std::to_string(counters.used_memory) + ", libre " +
+                      std::to_string(counters.free_memory) + ", bloques libres " +
+                      std::to_string(counters.free_blocks) + ") distintos de los bloques (" + std::to_string(used) +
+                      ", " + std::to_string(free) + ", " + std::to_string(free_blocks) + ")";
+            return false;
+        }
+        size_t listed = 0;
+        for (const auto& list : quick_lists) {
+            listed += list.size();
+        }
+        if (counters.cached_memory != cached || counters.cached_blocks != cached_blocks ||
+            listed != static_cast<size_t>(cached_blocks)) {
+            problem = "contadores de aparcados (" + std::to_string(counters.cached_memory) + " unidades, " +
+                      std::to_string(counters.cached_blocks) + " bloques, " + std::to_string(listed) +
+                      " en las listas) distintos de los bloques (" + std::to_string(cached) + ", " +
+                      std::to_string(cached_blocks) + ")";
+            return false;
+        }
+        if (free_index.count() != static_cast<size_t>(free_blocks) || free_index.largest() != largest) {
+            problem = "el indice tiene " + std::to_string(free_index.count()) + " bloques libres (mayor " +
+                      std::to_string(free_index.largest()) + ") y la lista " + std::to_string(free_blocks) +
+                      " (mayor " + std::to_string(largest) + ")";
+            return false;
+        }
+        if (free_index.segregated().enabled()) {
+            if (free_index.segregated().count() != static_cast<size_t>(free_blocks)) {
+                problem = "las listas segregadas tienen " + std::to_string(free_index.segregated().count()) +
+                          " bloques libres y la lista " + std::to_string(free_blocks);
+                return false;
+            }
+            if (!free_index.segregated().check(problem)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Liberar el bloque ocupado que empieza en `start`, sin importar el proceso dueño.
+    // El bloque se localiza en O(1) por el mapa de inicios de la lista.
+    OpStatus try_release_at(Address start, Address& size) {
+        counters.operations++;
+        size = 0;
+        
+        size_t node = memory_blocks.find(start);
+        if (node == NO_BLOCK || memory_blocks[node].is_free || memory_blocks[node].cached) {
+            return OpStatus::NOT_FOUND;
+        }
+        
+        MemoryBlock& block = memory_blocks[node];
+        process_locations.erase(memory_blocks, block.process_name);
+        size = block.size;
+        free_block(node);
+        return OpStatus::OK;
+    }
+};
+
+// Gestor con la política de colocación fijada en compilación: la búsqueda del
+// bloque se especializa para `Placement` y `FreeIndex` sin ningún switch.
+template <class Placement, class FreeIndex = LinearScanIndex>
+class BasicMemoryManager : public BlockStore<FreeIndex> {
+protected:
+    Placement placement;
+
+public:
+    explicit BasicMemoryManager(Address size = 100) : BlockStore<FreeIndex>(size) {
+        this->track_segregated(Placement::algorithm == AllocationAlgorithm::TLSF);
+    }
+    
+    AllocationAlgorithm get_algorithm() const {
+        return Placement::algorithm;
+    }
+    
+    // Ejecutar `function(política)`; aquí la política ya es fija
+    template <class Function>
+    decltype(auto) dispatch(Function&& function) {
+        return function(placement);
+    }
+    
+    // Asignación sin mensajes: aplica la política y devuelve el resultado y la posición
+    OpStatus try_allocate(std::string_view process_name, Address size, Address& start) {
+        return this->try_allocate_with(placement, process_name, size, start);
+    }
+    
+    // Redimensionar sin mensajes (comando R); `moved` son las unidades copiadas
+    OpStatus try_resize(std::string_view process_name, Address new_size, Address& start, Address& moved) {
+        return this->try_resize_with(placement, process_name, new_size, start, moved);
+    }
+    
+    // Asignar un lote sin mensajes (comando AB); un resultado por solicitud
+    void try_allocate_batch(const std::vector<BatchRequest>& requests, std::vector<BatchResult>& results) {
+        this->try_allocate_batch_with(placement, requests, results);
+    }
+};
+
+// Gestor cuyo algoritmo puede cambiarse en ejecución (comando ALG). Conserva una
+// instancia de cada política, de modo que Next Fit no pierde su posición.
+template <class FreeIndex = LinearScanIndex>
+class DynamicMemoryManager : public BlockStore<FreeIndex> {
+protected:
+    AllocationAlgorithm algorithm;
+    FirstFit first_fit;
+    BestFit best_fit;
+    WorstFit worst_fit;
+    NextFit next_fit;
+    TlsfFit tlsf;
+    AdaptiveFit adaptive;
+
+public:
+    explicit DynamicMemoryManager(Address size = 100, AllocationAlgorithm alg = AllocationAlgorithm::FIRST_FIT)
+        : BlockStore<FreeIndex>(size), algorithm(alg) {
+        this->track_segregated(alg == AllocationAlgorithm::TLSF);
+    }
+    
+    // Método para cambiar el algoritmo; las listas segregadas solo se llevan con TLSF
+    void set_algorithm(AllocationAlgorithm alg) {
+        algorithm = alg;
+        this->track_segregated(alg == AllocationAlgorithm::TLSF);
+    }
+    
+    AllocationAlgorithm get_algorithm() const {
+        return algorithm;
+    }
+    
+    // Obtener nombre del algoritmo actual
+    std::string_view get_algorithm_name() const {
+        return algorithm_display_name(algorithm);
+    }
+    
+    // Estado del algoritmo adaptativo: política vigente, costos medidos y cambios
+    const AdaptiveFit& get_adaptive() const {
+        return adaptive;
+    }
+    
+    // Ejecutar `function(política)` con la instancia del algoritmo vigente. Se despacha
+    // una sola vez y `function` queda especializada para esa política, de modo que un
+    // bucle dentro de ella asigna sin volver a consultar `algorithm`.
+    template <class Function>
+    decltype(auto) dispatch(Function&& function) {
+        switch (algorithm) {
+            case AllocationAlgorithm::BEST_FIT:
+                return function(best_fit);
+            case AllocationAlgorithm::WORST_FIT:
+                return function(worst_fit);
+            case AllocationAlgorithm::NEXT_FIT:
+                return function(next_fit);
+            case AllocationAlgorithm::TLSF:
+                return function(tlsf);
+            case AllocationAlgorithm::ADAPTIVE:
+                return function(adaptive);
+            case AllocationAlgorithm::FIRST_FIT:
+                break;
+        }
+        return function(first_fit);
+    }
+    
+    // Asignación sin mensajes: aplica el algoritmo y devuelve el resultado y la posición.
+    // Despacha en cada llamada; para reproducir muchas operaciones conviene dispatch.
+    OpStatus try_allocate(std::string_view process_name, Address size, Address& start) {
+        return dispatch([&](auto& placement) {
+            return this->try_allocate_with(placement, process_name, size, start);
+        });
+    }
+    
+    // Redimensionar sin mensajes (comando R); `moved` son las unidades copiadas
+    OpStatus try_resize(std::string_view process_name, Address new_size, Address& start, Address& moved) {
+        return dispatch([&](auto& placement) {
+            return this->try_resize_with(placement, process_name, new_size, start, moved);
+        });
+    }
+    
+    // Asignar un lote sin mensajes (comando AB); se despacha una vez para todo el lote
+    void try_allocate_batch(const std::vector<BatchRequest>& requests, std::vector<BatchResult>& results) {
+        dispatch([&](auto& placement) {
+            this->try_allocate_batch_with(placement, requests, results);
+        });
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_MEMORY_MANAGER_HPP
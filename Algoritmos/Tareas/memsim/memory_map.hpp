@@ -0,0 +1,82 @@
+// Representación visual del mapa de memoria (M en Tarea 1, D en Tarea 2). Recorre los
+// bloques una sola vez: el costo depende de los bloques y de las celdas impresas,
+// nunca del tamano total de la memoria.
+#ifndef MEMSIM_MEMORY_MAP_HPP
+#define MEMSIM_MEMORY_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory_manager.hpp"
+
+namespace memsim {
+
+// Celdas como máximo en la representación; con más memoria cada celda agrupa unidades
+constexpr Address MAX_VISUAL_CELLS = 10000;
+
+// Imprime el mapa en líneas de 50 celdas precedidas por la dirección de la primera.
+// Hasta MAX_VISUAL_CELLS unidades cada celda es una unidad; por encima, cada celda
+// agrupa `scale` unidades y muestra el símbolo que cubre la mayor parte de ellas.
+// `symbol(bloque)` da el carácter de cada bloque (a lo sumo cuatro distintos).
+template <class Symbol>
+void print_visual_map(std::ostream& out, const BlockList& blocks, Address total, Symbol&& symbol) {
+    constexpr size_t CELLS_PER_LINE = 50;
+    Address scale = (total + MAX_VISUAL_CELLS - 1) / MAX_VISUAL_CELLS;
+    Address cells = (total + scale - 1) / scale;
+    if (scale > 1) {
+        out << "(cada celda representa " << scale << " unidades; se muestra el estado mayoritario)\n";
+    }
+    
+    std::string line;
+    std::array<std::pair<char, Address>, 4> shares; // unidades de cada símbolo en la celda
+    auto block = blocks.begin();
+    for (Address cell = 0; cell < cells; cell++) {
+        Address cell_start = cell * scale;
+        Address cell_end = std::min(total, cell_start + scale);
+        size_t symbols = 0;
+        while (block != blocks.end()) {
+            const MemoryBlock& current = *block;
+            Address end = current.start + current.size;
+            Address units = std::min(end, cell_end) - std::max(current.start, cell_start);
+            char c = symbol(current);
+            size_t k = 0;
+            while (k < symbols && shares[k].first != c) {
+                k++;
+            }
+            if (k == symbols && symbols < shares.size()) {
+                shares[symbols++] = {c, 0};
+            }
+            if (k < symbols) {
+                shares[k].second += units;
+            }
+            if (end > cell_end) {
+                break; // el bloque sigue en la celda siguiente
+            }
+            ++block;
+            if (end == cell_end) {
+                break;
+            }
+        }
+        
+        size_t best = 0;
+        for (size_t k = 1; k < symbols; k++) {
+            if (shares[k].second > shares[best].second) {
+                best = k;
+            }
+        }
+        line.push_back(symbols > 0 ? shares[best].first : ' ');
+        if (line.size() == CELLS_PER_LINE || cell + 1 == cells) {
+            out << std::setw(3) << (cell + 1 - static_cast<Address>(line.size())) * scale << ": " << line << "\n";
+            line.clear();
+        }
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_MEMORY_MAP_HPP
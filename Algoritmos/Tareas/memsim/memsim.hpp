@@ -0,0 +1,25 @@
+// Biblioteca de solo cabeceras del simulador de gestión de memoria.
+#ifndef MEMSIM_HPP
+#define MEMSIM_HPP
+
+#include "pool.hpp"
+#include "memory_manager.hpp"
+#include "memory_map.hpp"
+#include "output.hpp"
+#include "sampling.hpp"
+#include "pipeline.hpp"
+#include "trace_analysis.hpp"
+#include "test_files.hpp"
+#include "simulator.hpp"
+#include "concurrent.hpp"
+#include "benchmark.hpp"
+#include "oracle.hpp"
+#include "decision_log.hpp"
+#include "fuzz.hpp"
+#include "paging.hpp"
+#include "branching.hpp"
+#include "wait_queue.hpp"
+#include "timed.hpp"
+#include "server.hpp"
+
+#endif // MEMSIM_HPP
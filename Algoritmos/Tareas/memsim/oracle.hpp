@@ -0,0 +1,408 @@
+// Oráculo de colocación offline: conoce el futuro completo de la traza (cada A con
+// su L) y acota la memoria mínima sin fallos para compararla con los algoritmos en
+// línea. La cota inferior es el pico de memoria viva; la superior, la mejor de una
+// colocación offline que usa la vida de cada proceso (mayor primero), dos heurísticas
+// sin límite de memoria que no miran el futuro y los propios algoritmos en línea.
+// El óptimo exacto (asignación dinámica de memoria offline) es NP-difícil.
+#ifndef MEMSIM_ORACLE_HPP
+#define MEMSIM_ORACLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "memory_manager.hpp"
+
+namespace memsim {
+
+// Vida de un proceso en número de operación A/L: vive en [birth, death). Los que
+// nunca se liberan mueren después de la última operación.
+struct TraceInterval {
+    long long birth;
+    long long death;
+    Address size;
+};
+
+// Empareja cada A con su L con las mismas reglas de rechazo que analyze_trace
+// (tamano no positivo, proceso ya vivo, liberar un proceso inexistente)
+inline std::vector<TraceInterval> collect_intervals(const std::vector<ReplayOp>& ops) {
+    std::vector<TraceInterval> intervals;
+    std::unordered_map<std::string, size_t> live; // proceso -> índice de su intervalo
+    long long operation = 0;
+    for (const auto& op : ops) {
+        operation++;
+        if (op.op == 'A') {
+            if (op.size > 0 && live.emplace(op.process_name, intervals.size()).second) {
+                intervals.push_back({operation, LLONG_MAX, op.size});
+            }
+        } else {
+            auto it = live.find(op.process_name);
+            if (it != live.end()) {
+                intervals[it->second].death = operation;
+                live.erase(it);
+            }
+        }
+    }
+    for (auto& interval : intervals) {
+        if (interval.death == LLONG_MAX) {
+            interval.death = operation + 1;
+        }
+    }
+    return intervals;
+}
+
+// Eventos del barrido en orden temporal: cada operación es a lo sumo un nacimiento o
+// una muerte, así que basta ordenar por tiempo; las muertes finales van antes del cierre
+struct SweepEvent {
+    long long time;
+    size_t interval;
+    bool birth;
+};
+
+inline std::vector<SweepEvent> sweep_events(const std::vector<TraceInterval>& intervals) {
+    std::vector<SweepEvent> events;
+    events.reserve(intervals.size() * 2);
+    for (size_t i = 0; i < intervals.size(); i++) {
+        events.push_back({intervals[i].birth, i, true});
+        events.push_back({intervals[i].death, i, false});
+    }
+    // A igual tiempo (solo los que nunca se liberan) las muertes primero
+    std::sort(events.begin(), events.end(), [](const SweepEvent& a, const SweepEvent& b) {
+        return a.time != b.time ? a.time < b.time : a.birth < b.birth;
+    });
+    return events;
+}
+
+// Cota inferior: el máximo de unidades vivas a la vez (peso de la mayor clique del
+// grafo de intervalos). Ninguna colocación, en línea u offline, puede usar menos.
+inline long long max_live_units(const std::vector<TraceInterval>& intervals, const std::vector<SweepEvent>& events) {
+    long long live = 0, peak = 0;
+    for (const auto& event : events) {
+        live += event.birth ? intervals[event.interval].size : -intervals[event.interval].size;
+        peak = std::max(peak, live);
+    }
+    return peak;
+}
+
+// Colocación offline que sí usa el futuro: con la vida completa de cada proceso
+// coloca los intervalos de mayor a menor tamano (a igual tamano, el de vida más
+// larga primero) en la dirección más baja donde no choque con ningún colocado que
+// conviva con él. Los intervalos ya vienen ordenados por nacimiento, así que los
+// colocados se indexan por posición en un árbol de segmentos con la muerte máxima de
+// cada rango: hallar los k que conviven con uno cuesta O((k + 1) log n), en total
+// O((n + s) log n) con s los pares de procesos que conviven. Devuelve la mayor
+// dirección final ocupada, o -1 si s supera OFFLINE_PAIR_LIMIT.
+constexpr long long OFFLINE_PAIR_LIMIT = 20000000;
+
+inline long long offline_largest_first(const std::vector<TraceInterval>& intervals, const std::vector<SweepEvent>& events) {
+    struct Range {
+        size_t node, lo, hi;
+    };
+    long long live = 0, pairs = 0;
+    for (const auto& event : events) {
+        pairs += event.birth ? live : 0;
+        live += event.birth ? 1 : -1;
+    }
+    if (pairs > OFFLINE_PAIR_LIMIT) {
+        return -1;
+    }
+    
+    size_t count = intervals.size();
+    size_t leaves = 1;
+    while (leaves < count) leaves *= 2;
+    std::vector<long long> latest(2 * leaves, 0); // muerte máxima de los colocados del rango
+    std::vector<long long> offset(count, 0);
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const TraceInterval& x = intervals[a];
+        const TraceInterval& y = intervals[b];
+        if (x.size != y.size) return x.size > y.size;
+        if (x.death - x.birth != y.death - y.birth) return x.death - x.birth > y.death - y.birth;
+        return a < b;
+    });
+    
+    std::vector<std::pair<long long, long long>> taken; // [inicio, fin) de los que conviven
+    std::vector<Range> pending;
+    long long high_water = 0;
+    for (size_t i : order) {
+        const TraceInterval& interval = intervals[i];
+        // Conviven los nacidos antes de esta muerte que mueren después de este nacimiento
+        size_t born_before = static_cast<size_t>(
+            std::partition_point(intervals.begin(), intervals.end(),
+                                 [&](const TraceInterval& other) { return other.birth < interval.death; }) -
+            intervals.begin());
+        taken.clear();
+        pending.assign(1, Range{1, 0, leaves});
+        while (!pending.empty()) {
+            Range range = pending.back();
+            pending.pop_back();
+            if (range.lo >= born_before || latest[range.node] <= interval.birth) {
+                continue;
+            }
+            if (range.node >= leaves) {
+                taken.emplace_back(offset[range.lo], offset[range.lo] + intervals[range.lo].size);
+                continue;
+            }
+            size_t middle = range.lo + (range.hi - range.lo) / 2;
+            pending.push_back({2 * range.node, range.lo, middle});
+            pending.push_back({2 * range.node + 1, middle, range.hi});
+        }
+        
+        std::sort(taken.begin(), taken.end());
+        long long start = 0;
+        for (const auto& [begin, end] : taken) {
+            if (begin - start >= interval.size) break;
+            start = std::max(start, end);
+        }
+        offset[i] = start;
+        high_water = std::max(high_water, start + interval.size);
+        for (size_t node = leaves + i; node > 0; node /= 2) {
+            latest[node] = std::max(latest[node], interval.death);
+        }
+    }
+    return high_water;
+}
+
+// Heurística sin futuro: coloreo del grafo de intervalos por clase de tamano. Cada
+// tamano se redondea a la potencia de 2 siguiente y cada clase recibe tantas ranuras
+// como intervalos simultáneos tenga (el coloreo voraz por nacimiento, que solo mira
+// el pasado, es óptimo dentro de la clase). Las clases se apilan; devuelve la memoria
+// total de esa colocación, saturada en LLONG_MAX si no cabe en un long long.
+inline long long size_class_colouring(const std::vector<TraceInterval>& intervals, const std::vector<SweepEvent>& events) {
+    constexpr int CLASSES = 63;
+    std::array<std::priority_queue<long long, std::vector<long long>, std::greater<long long>>, CLASSES> free_slots;
+    std::array<long long, CLASSES> slots{};
+    std::vector<long long> slot_of(intervals.size());
+    
+    // Tamanos sobre 2^62 (ninguna memoria simulable los admite) caen en la última clase
+    auto class_of = [](Address size) {
+        int k = 0;
+        while (k < CLASSES - 1 && (1LL << k) < size) k++;
+        return k;
+    };
+    
+    for (const auto& event : events) {
+        int k = class_of(intervals[event.interval].size);
+        auto& available = free_slots[static_cast<size_t>(k)];
+        if (event.birth) {
+            if (available.empty()) {
+                slot_of[event.interval] = slots[static_cast<size_t>(k)]++;
+            } else {
+                slot_of[event.interval] = available.top();
+                available.pop();
+            }
+        } else {
+            available.push(slot_of[event.interval]);
+        }
+    }
+    
+    long long total = 0;
+    for (int k = 0; k < CLASSES; k++) {
+        long long count = slots[static_cast<size_t>(k)];
+        if (count > (LLONG_MAX - total) >> k) {
+            return LLONG_MAX;
+        }
+        total += count << k;
+    }
+    return total;
+}
+
+// Heurística sin futuro: Best Fit sobre un espacio sin límite; huecos por (tamano, inicio) y por inicio para
+// fusionar; si ningún hueco sirve se asigna en el tope. Ningún hueco toca el tope (al
+// liberar el último tramo el tope baja), así que ampliarlo nunca deja huecos atrás.
+// Devuelve el tope máximo alcanzado, que es la memoria que necesita esa colocación.
+inline long long unbounded_best_fit(const std::vector<TraceInterval>& intervals, const std::vector<SweepEvent>& events) {
+    std::set<std::pair<long long, long long>> by_size; // (tamano, inicio)
+    std::map<long long, long long> by_start;           // inicio -> tamano
+    std::vector<long long> start_of(intervals.size());
+    long long top = 0, high_water = 0;
+    
+    auto remove_hole = [&](std::map<long long, long long>::iterator it) {
+        by_size.erase({it->second, it->first});
+        return by_start.erase(it);
+    };
+    auto add_hole = [&](long long start, long long size) {
+        by_start.emplace(start, size);
+        by_size.emplace(size, start);
+    };
+    
+    for (const auto& event : events) {
+        long long size = intervals[event.interval].size;
+        if (event.birth) {
+            auto fit = by_size.lower_bound({size, LLONG_MIN});
+            if (fit != by_size.end()) {
+                long long hole_start = fit->second, hole_size = fit->first;
+                remove_hole(by_start.find(hole_start));
+                if (hole_size > size) {
+                    add_hole(hole_start + size, hole_size - size);
+                }
+                start_of[event.interval] = hole_start;
+            } else {
+                start_of[event.interval] = top;
+                top += size;
+                high_water = std::max(high_water, top);
+            }
+        } else {
+            long long start = start_of[event.interval];
+            long long end = start + size;
+            auto next = by_start.lower_bound(start);
+            if (next != by_start.end() && next->first == end) {
+                end += next->second;
+                next = remove_hole(next);
+            }
+            if (next != by_start.begin()) {
+                auto previous = std::prev(next);
+                if (previous->first + previous->second == start) {
+                    start = previous->first;
+                    remove_hole(previous);
+                }
+            }
+            if (end == top) {
+                top = start; // el tramo final queda libre: el tope baja
+            } else {
+                add_hole(start, end - start);
+            }
+        }
+    }
+    return high_water;
+}
+
+// Resultado de un algoritmo en línea frente al oráculo
+struct OnlineRegret {
+    AllocationAlgorithm algorithm;
+    long long min_memory = -1; // memoria mínima sin fallos encontrada; -1 si supera el límite
+    int simulations = 0;
+};
+
+struct OracleReport {
+    size_t operations = 0;
+    size_t intervals = 0;
+    double oracle_seconds = 0.0; // emparejar, ordenar y las cuatro pasadas
+    double online_seconds = 0.0; // todas las simulaciones en línea
+    long long lower_bound = 0;
+    long long offline_memory = 0; // -1 si la traza excede OFFLINE_PAIR_LIMIT
+    long long colouring_memory = 0;
+    long long best_fit_memory = 0;
+    std::vector<OnlineRegret> online;
+    
+    // Mejor colocación conocida: el óptimo está en [lower_bound, upper_bound()]. Cada
+    // algoritmo en línea sin fallos también es una colocación válida, así que cuenta.
+    long long upper_bound() const {
+        long long best = std::min(colouring_memory, best_fit_memory);
+        if (offline_memory >= 0) best = std::min(best, offline_memory);
+        for (const auto& result : online) {
+            if (result.min_memory >= 0) best = std::min(best, result.min_memory);
+        }
+        return best;
+    }
+};
+
+// Simula `ops` con el algoritmo en línea y `memory` unidades; devuelve los fallos por
+// falta de memoria y deja en `high_water` la mayor dirección final ocupada
+inline long long simulate_online(AllocationAlgorithm algorithm, Address memory, const std::vector<ReplayOp>& ops,
+                                 long long& high_water) {
+    DynamicMemoryManager<SizeOrderedIndex> manager(memory, algorithm);
+    high_water = 0;
+    long long failures = 0;
+    manager.dispatch([&](auto& placement) {
+        Address start, size;
+        for (const auto& op : ops) {
+            if (op.op == 'A') {
+                OpStatus status = manager.try_allocate_with(placement, op.process_name, op.size, start);
+                if (status == OpStatus::NO_MEMORY) {
+                    failures++;
+                } else if (status == OpStatus::OK) {
+                    high_water = std::max(high_water, start + op.size);
+                }
+            } else {
+                manager.try_deallocate(op.process_name, start, size);
+            }
+        }
+    });
+    return failures;
+}
+
+// Memoria mínima sin fallos de un algoritmo en línea. First Fit elige siempre el hueco
+// de menor dirección, así que con memoria de sobra su tope máximo ya es el mínimo
+// exacto; para los demás se duplica desde la cota inferior y luego se busca en forma
+// binaria. La búsqueda supone que más memoria nunca agrega fallos, lo que no vale en
+// general para Best, Worst y Next Fit (otro tamano del último hueco cambia sus
+// elecciones): el resultado es una memoria sin fallos cuya inmediata menor falla, una
+// cota superior del mínimo que podría no ser la menor memoria sin fallos.
+inline OnlineRegret online_min_memory(AllocationAlgorithm algorithm, const std::vector<ReplayOp>& ops,
+                                      long long lower_bound) {
+    OnlineRegret result{algorithm};
+    long long high_water;
+    auto fails = [&](long long memory) {
+        result.simulations++;
+        return simulate_online(algorithm, memory, ops, high_water) > 0;
+    };
+    
+    long long limit = MAX_TOTAL_MEMORY;
+    long long hi = std::max(1LL, lower_bound);
+    if (algorithm == AllocationAlgorithm::FIRST_FIT) {
+        if (!fails(limit)) {
+            result.min_memory = std::max(1LL, high_water);
+        }
+        return result;
+    }
+    
+    while (fails(hi)) {
+        if (hi >= limit) {
+            return result;
+        }
+        hi = std::min(limit, hi * 2);
+    }
+    long long lo = std::max(lower_bound - 1, hi / 2); // lo falla (o está bajo la cota)
+    while (hi - lo > 1) {
+        long long middle = lo + (hi - lo) / 2;
+        if (fails(middle)) {
+            lo = middle;
+        } else {
+            hi = middle;
+        }
+    }
+    result.min_memory = hi;
+    return result;
+}
+
+// Ejecuta el oráculo y compara con First, Best, Worst y Next Fit
+inline OracleReport run_placement_oracle(const std::vector<ReplayOp>& ops) {
+    using Clock = std::chrono::steady_clock;
+    OracleReport report;
+    Clock::time_point started = Clock::now();
+    std::vector<TraceInterval> intervals = collect_intervals(ops);
+    std::vector<SweepEvent> events = sweep_events(intervals);
+    
+    report.operations = ops.size();
+    report.intervals = intervals.size();
+    report.lower_bound = max_live_units(intervals, events);
+    report.offline_memory = offline_largest_first(intervals, events);
+    report.colouring_memory = size_class_colouring(intervals, events);
+    report.best_fit_memory = unbounded_best_fit(intervals, events);
+    Clock::time_point swept = Clock::now();
+    report.oracle_seconds = std::chrono::duration<double>(swept - started).count();
+    
+    for (AllocationAlgorithm algorithm : {AllocationAlgorithm::FIRST_FIT, AllocationAlgorithm::BEST_FIT,
+                                          AllocationAlgorithm::WORST_FIT, AllocationAlgorithm::NEXT_FIT}) {
+        report.online.push_back(online_min_memory(algorithm, ops, report.lower_bound));
+    }
+    report.online_seconds = std::chrono::duration<double>(Clock::now() - swept).count();
+    return report;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_ORACLE_HPP
@@ -0,0 +1,228 @@
+// Salida estructurada del simulador: formatos de salida y escritores con buffer
+// para registros JSON (NDJSON) y CSV.
+#ifndef MEMSIM_OUTPUT_HPP
+#define MEMSIM_OUTPUT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace memsim {
+
+// Formato de salida de los comandos M, D, S, FR y de los resultados de A/L
+enum class OutputFormat {
+    TEXT,
+    JSON,
+    CSV
+};
+
+// Convierte "text", "json" o "csv" (sin distinguir mayúsculas) al formato correspondiente
+inline bool parse_output_format(std::string name, OutputFormat& format) {
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (name == "text" || name == "texto") format = OutputFormat::TEXT;
+    else if (name == "json") format = OutputFormat::JSON;
+    else if (name == "csv") format = OutputFormat::CSV;
+    else return false;
+    return true;
+}
+
+// Escritor con buffer propio: acumula la salida y la vuelca al stream en bloques
+// grandes. Los números se convierten con std::to_chars para evitar el coste de iostream.
+class StreamWriter {
+private:
+    std::ostream& out;
+    std::string buffer;
+    static constexpr size_t FLUSH_THRESHOLD = 1 << 16;
+
+public:
+    explicit StreamWriter(std::ostream& os) : out(os) {
+        buffer.reserve(FLUSH_THRESHOLD + 256);
+    }
+
+    ~StreamWriter() {
+        flush();
+    }
+
+    void flush() {
+        if (!buffer.empty()) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    StreamWriter& raw(std::string_view text) {
+        buffer.append(text.data(), text.size());
+        if (buffer.size() >= FLUSH_THRESHOLD) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+        return *this;
+    }
+
+    StreamWriter& raw(char c) {
+        buffer.push_back(c);
+        return *this;
+    }
+
+    StreamWriter& number(long long value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return raw(std::string_view(digits, result.ptr - digits));
+    }
+
+    // Cuatro decimales fijos; si no caben (valores enormes) se pasa a notación científica
+    StreamWriter& number(double value) {
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 4);
+        if (result.ec != std::errc()) {
+            result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::scientific, 6);
+        }
+        return raw(std::string_view(digits, result.ptr - digits));
+    }
+
+    // Cadena JSON entre comillas con los caracteres de control escapados
+    StreamWriter& json_string(std::string_view text) {
+        raw('"');
+        for (char c : text) {
+            switch (c) {
+                case '"': raw("\\\""); break;
+                case '\\': raw("\\\\"); break;
+                case '\n': raw("\\n"); break;
+                case '\t': raw("\\t"); break;
+                case '\r': raw("\\r"); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        static const char hex[] = "0123456789abcdef";
+                        raw("\\u00");
+                        raw(hex[(c >> 4) & 0xF]);
+                        raw(hex[c & 0xF]);
+                    } else {
+                        raw(c);
+                    }
+            }
+        }
+        return raw('"');
+    }
+
+    // Campo CSV: se entrecomilla solo si contiene separadores o comillas (RFC 4180)
+    StreamWriter& csv_field(std::string_view text) {
+        if (text.find_first_of(",\"\n\r") == std::string_view::npos) {
+            return raw(text);
+        }
+        raw('"');
+        for (char c : text) {
+            if (c == '"') raw('"');
+            raw(c);
+        }
+        return raw('"');
+    }
+};
+
+// Emisor de registros planos: en JSON produce un objeto por línea (NDJSON) y en CSV
+// una fila por registro cuya primera columna es el tipo. La cabecera CSV de cada tipo
+// se escribe la primera vez que aparece. No se construye ningún árbol en memoria.
+class RecordWriter {
+private:
+    StreamWriter writer;
+    OutputFormat format;
+    std::vector<std::string> csv_headers_written;
+
+    template <size_t N>
+    void write_csv_header(std::string_view type, const std::array<std::string_view, N>& columns) {
+        for (const auto& seen : csv_headers_written) {
+            if (seen == type) return;
+        }
+        csv_headers_written.emplace_back(type);
+        writer.raw("record");
+        for (const auto& column : columns) {
+            writer.raw(',').raw(column);
+        }
+        writer.raw('\n');
+    }
+
+    void key(std::string_view name) {
+        if (format == OutputFormat::JSON) {
+            writer.raw(",\"").raw(name).raw("\":");
+        } else {
+            writer.raw(',');
+        }
+    }
+
+public:
+    explicit RecordWriter(std::ostream& os, OutputFormat fmt = OutputFormat::TEXT)
+        : writer(os), format(fmt) {}
+
+    void set_format(OutputFormat fmt) {
+        writer.flush();
+        format = fmt;
+    }
+
+    OutputFormat get_format() const {
+        return format;
+    }
+
+    template <size_t N>
+    void begin(std::string_view type, const std::array<std::string_view, N>& columns) {
+        if (format == OutputFormat::JSON) {
+            writer.raw("{\"type\":").json_string(type);
+        } else {
+            write_csv_header(type, columns);
+            writer.raw(type);
+        }
+    }
+
+    void field(std::string_view name, long long value) {
+        key(name);
+        writer.number(value);
+    }
+
+    void field(std::string_view name, int value) {
+        field(name, static_cast<long long>(value));
+    }
+
+    // NaN e infinito no son JSON válido: se escriben como null (campo vacío en CSV)
+    void field(std::string_view name, double value) {
+        key(name);
+        if (!std::isfinite(value)) {
+            if (format == OutputFormat::JSON) writer.raw("null");
+            return;
+        }
+        writer.number(value);
+    }
+
+    void field(std::string_view name, bool value) {
+        key(name);
+        writer.raw(value ? "true" : "false");
+    }
+
+    void field(std::string_view name, std::string_view value) {
+        key(name);
+        if (format == OutputFormat::JSON) {
+            writer.json_string(value);
+        } else {
+            writer.csv_field(value);
+        }
+    }
+
+    void field(std::string_view name, const char* value) {
+        field(name, std::string_view(value));
+    }
+
+    void end() {
+        writer.raw(format == OutputFormat::JSON ? "}\n" : "\n");
+    }
+
+    void flush() {
+        writer.flush();
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_OUTPUT_HPP
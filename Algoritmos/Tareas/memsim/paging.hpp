@@ -0,0 +1,518 @@
+// Memoria virtual paginada: tablas de páginas por proceso, TLB asociativa por
+// conjuntos y reemplazo FIFO, LRU o Clock sobre los marcos físicos. El estado vive
+// en arreglos planos indexados por proceso, página, marco y conjunto de la TLB, así
+// que traducir un acceso son unas pocas lecturas de arreglos, sin ningún mapa.
+#ifndef MEMSIM_PAGING_HPP
+#define MEMSIM_PAGING_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "pipeline.hpp"
+
+namespace memsim {
+
+// Política de reemplazo de páginas cuando no quedan marcos libres
+enum class ReplacementPolicy {
+    FIFO,
+    LRU,
+    CLOCK
+};
+
+constexpr std::array<std::string_view, 3> REPLACEMENT_NAMES = {"FIFO", "LRU", "Clock"};
+
+constexpr std::string_view replacement_name(ReplacementPolicy policy) {
+    return REPLACEMENT_NAMES[static_cast<size_t>(policy)];
+}
+
+// Ciclos simulados de cada camino de una traducción
+struct PagingCosts {
+    long long tlb_hit = 1;       // la TLB tiene la traducción
+    long long page_walk = 20;    // fallo de TLB: se recorre la tabla de páginas
+    long long page_fault = 5000; // la página no reside: se trae a un marco (incluye el recorrido)
+};
+
+// Forma de la memoria paginada. El tamano de página y la cantidad de conjuntos de la
+// TLB (entradas / vías) son potencias de 2, así que página y conjunto salen de
+// desplazamientos y máscaras.
+struct PagingConfig {
+    int page_size = 64;   // unidades por página
+    int frames = 64;      // marcos físicos
+    int tlb_entries = 16;
+    int tlb_ways = 4;
+    ReplacementPolicy policy = ReplacementPolicy::LRU;
+    PagingCosts costs;
+    
+    // Describe el primer parámetro inválido, o devuelve "" si todos sirven
+    std::string validate() const {
+        auto power_of_two = [](int value) { return value > 0 && (value & (value - 1)) == 0; };
+        if (!power_of_two(page_size)) return "el tamano de pagina debe ser una potencia de 2";
+        if (frames < 1) return "se necesita al menos un marco";
+        if (tlb_ways < 1 || tlb_entries < tlb_ways || tlb_entries % tlb_ways != 0 ||
+            !power_of_two(tlb_entries / tlb_ways)) {
+            return "las entradas de la TLB deben ser vias x una potencia de 2 de conjuntos";
+        }
+        return "";
+    }
+};
+
+// Contadores de la simulación; los accesos inválidos no cuentan como accesos
+struct PagingStats {
+    long long accesses = 0;
+    long long tlb_hits = 0;
+    long long tlb_misses = 0;     // incluye los fallos de página
+    long long page_faults = 0;
+    long long evictions = 0;
+    long long invalid_accesses = 0; // proceso inexistente o desplazamiento fuera de su tamano
+    long long cycles = 0;
+    long long processes = 0;      // procesos creados
+    long long releases = 0;       // procesos liberados
+    
+    double tlb_hit_rate() const {
+        return accesses > 0 ? 100.0 * tlb_hits / accesses : 0.0;
+    }
+    
+    double fault_rate() const {
+        return accesses > 0 ? 100.0 * page_faults / accesses : 0.0;
+    }
+    
+    double cycles_per_access() const {
+        return accesses > 0 ? static_cast<double>(cycles) / accesses : 0.0;
+    }
+};
+
+// Resultado de un acceso
+enum class AccessResult {
+    TLB_HIT,
+    PAGE_HIT,   // fallo de TLB con la página residente
+    PAGE_FAULT,
+    INVALID
+};
+
+// Memoria paginada con paginación por demanda: crear un proceso solo arma su tabla de
+// páginas y cada página entra a un marco en su primer acceso. Los identificadores de
+// proceso son ranuras que se reciclan al liberar.
+class PagedMemory {
+public:
+    static constexpr int NO_FRAME = -1;
+    static constexpr int NO_PROCESS = -1;
+
+private:
+    static constexpr uint64_t EMPTY_KEY = ~0ULL;
+    
+    // Entrada de la TLB: clave (proceso << 32 | página), marco y último uso para el LRU
+    // dentro de su conjunto
+    struct TlbEntry {
+        uint64_t key = EMPTY_KEY;
+        uint64_t last_use = 0;
+        int frame = NO_FRAME;
+    };
+    
+    PagingConfig config;
+    int page_shift = 0;
+    uint32_t tlb_set_mask = 0;
+    std::vector<TlbEntry> tlb; // conjuntos contiguos de tlb_ways entradas
+    uint64_t tlb_clock = 0;
+    
+    // Por ranura de proceso: marco de cada página (NO_FRAME si no reside) y tamano en
+    // unidades (-1 si la ranura está libre). Las tablas conservan su capacidad al reciclarse.
+    std::vector<std::vector<int>> page_tables;
+    std::vector<Address> process_sizes;
+    std::vector<int> free_slots;
+    
+    // Por marco: dueño y página, lista doble en orden de reemplazo (cabeza = próxima
+    // víctima de FIFO y LRU) y bit de referencia de Clock
+    std::vector<int> frame_process;
+    std::vector<int> frame_page;
+    std::vector<int> frame_previous;
+    std::vector<int> frame_next;
+    std::vector<uint8_t> referenced;
+    std::vector<int> free_frames;
+    int list_head = NO_FRAME;
+    int list_tail = NO_FRAME;
+    int clock_hand = 0;
+    
+    PagingStats stats;
+    
+    static uint64_t tlb_key(int process, uint32_t page) {
+        return static_cast<uint64_t>(process) << 32 | page;
+    }
+    
+    TlbEntry* tlb_set(int process, uint32_t page) {
+        uint32_t set = (page ^ static_cast<uint32_t>(process) * 0x9E3779B1u) & tlb_set_mask;
+        return &tlb[static_cast<size_t>(set) * static_cast<size_t>(config.tlb_ways)];
+    }
+    
+    void unlink_frame(int frame) {
+        int previous = frame_previous[static_cast<size_t>(frame)];
+        int next = frame_next[static_cast<size_t>(frame)];
+        (previous == NO_FRAME ? list_head : frame_next[static_cast<size_t>(previous)]) = next;
+        (next == NO_FRAME ? list_tail : frame_previous[static_cast<size_t>(next)]) = previous;
+    }
+    
+    void append_frame(int frame) {
+        frame_previous[static_cast<size_t>(frame)] = list_tail;
+        frame_next[static_cast<size_t>(frame)] = NO_FRAME;
+        (list_tail == NO_FRAME ? list_head : frame_next[static_cast<size_t>(list_tail)]) = frame;
+        list_tail = frame;
+    }
+    
+    // Aviso de uso del marco a la política: LRU lo pasa al final, Clock marca su bit
+    void touch(int frame) {
+        if (config.policy == ReplacementPolicy::LRU) {
+            if (frame != list_tail) {
+                unlink_frame(frame);
+                append_frame(frame);
+            }
+        } else if (config.policy == ReplacementPolicy::CLOCK) {
+            referenced[static_cast<size_t>(frame)] = 1;
+        }
+    }
+    
+    void tlb_invalidate(int process, uint32_t page) {
+        TlbEntry* set = tlb_set(process, page);
+        uint64_t key = tlb_key(process, page);
+        for (int way = 0; way < config.tlb_ways; way++) {
+            if (set[way].key == key) {
+                set[way].key = EMPTY_KEY;
+                return;
+            }
+        }
+    }
+    
+    // Marco para una página nueva: uno libre o el que elija la política
+    int take_frame() {
+        if (!free_frames.empty()) {
+            int frame = free_frames.back();
+            free_frames.pop_back();
+            return frame;
+        }
+        
+        int victim;
+        if (config.policy == ReplacementPolicy::CLOCK) {
+            // Sin marcos libres todos están ocupados: a lo sumo dos vueltas
+            while (referenced[static_cast<size_t>(clock_hand)]) {
+                referenced[static_cast<size_t>(clock_hand)] = 0;
+                clock_hand = clock_hand + 1 == config.frames ? 0 : clock_hand + 1;
+            }
+            victim = clock_hand;
+            clock_hand = clock_hand + 1 == config.frames ? 0 : clock_hand + 1;
+        } else {
+            victim = list_head;
+        }
+        
+        int owner = frame_process[static_cast<size_t>(victim)];
+        int page = frame_page[static_cast<size_t>(victim)];
+        page_tables[static_cast<size_t>(owner)][static_cast<size_t>(page)] = NO_FRAME;
+        tlb_invalidate(owner, static_cast<uint32_t>(page));
+        if (config.policy != ReplacementPolicy::CLOCK) {
+            unlink_frame(victim);
+        }
+        stats.evictions++;
+        return victim;
+    }
+
+public:
+    explicit PagedMemory(const PagingConfig& paging_config)
+        : config(paging_config),
+          tlb(static_cast<size_t>(paging_config.tlb_entries)),
+          frame_process(static_cast<size_t>(paging_config.frames), NO_PROCESS),
+          frame_page(static_cast<size_t>(paging_config.frames), 0),
+          frame_previous(static_cast<size_t>(paging_config.frames), NO_FRAME),
+          frame_next(static_cast<size_t>(paging_config.frames), NO_FRAME),
+          referenced(static_cast<size_t>(paging_config.frames), 0) {
+        while ((1 << page_shift) < config.page_size) {
+            page_shift++;
+        }
+        tlb_set_mask = static_cast<uint32_t>(config.tlb_entries / config.tlb_ways - 1);
+        free_frames.reserve(static_cast<size_t>(config.frames));
+        for (int frame = config.frames; frame-- > 0;) {
+            free_frames.push_back(frame); // el marco 0 sale primero
+        }
+    }
+    
+    const PagingConfig& get_config() const {
+        return config;
+    }
+    
+    const PagingStats& get_stats() const {
+        return stats;
+    }
+    
+    int resident_pages() const {
+        return config.frames - static_cast<int>(free_frames.size());
+    }
+    
+    // Crear un proceso de `size` unidades sin páginas residentes; devuelve su
+    // identificador o NO_PROCESS si el tamano no es positivo o si sus páginas no caben
+    // en la tabla (los números de página son int y ocupan 32 bits de la clave de la TLB)
+    int create_process(Address size) {
+        if (size <= 0 || (size - 1) >> page_shift >= INT_MAX) {
+            return NO_PROCESS;
+        }
+        int process;
+        if (free_slots.empty()) {
+            process = static_cast<int>(page_tables.size());
+            page_tables.emplace_back();
+            process_sizes.push_back(0);
+        } else {
+            process = free_slots.back();
+            free_slots.pop_back();
+        }
+        Address pages = ((size - 1) >> page_shift) + 1;
+        page_tables[static_cast<size_t>(process)].assign(static_cast<size_t>(pages), NO_FRAME);
+        process_sizes[static_cast<size_t>(process)] = size;
+        stats.processes++;
+        return process;
+    }
+    
+    // Liberar los marcos del proceso y sus entradas de la TLB
+    void release_process(int process) {
+        std::vector<int>& table = page_tables[static_cast<size_t>(process)];
+        for (int& frame : table) {
+            if (frame != NO_FRAME) {
+                if (config.policy != ReplacementPolicy::CLOCK) {
+                    unlink_frame(frame);
+                }
+                frame_process[static_cast<size_t>(frame)] = NO_PROCESS;
+                referenced[static_cast<size_t>(frame)] = 0;
+                free_frames.push_back(frame);
+                frame = NO_FRAME;
+            }
+        }
+        uint64_t owner = static_cast<uint64_t>(process);
+        for (TlbEntry& entry : tlb) {
+            if (entry.key != EMPTY_KEY && entry.key >> 32 == owner) {
+                entry.key = EMPTY_KEY;
+            }
+        }
+        process_sizes[static_cast<size_t>(process)] = -1;
+        free_slots.push_back(process);
+        stats.releases++;
+    }
+    
+    // Traducir un acceso al desplazamiento `offset` del proceso: TLB, tabla de páginas
+    // y, si la página no reside, un marco libre o la víctima de la política
+    AccessResult access(int process, long long offset) {
+        if (process < 0 || static_cast<size_t>(process) >= process_sizes.size() || offset < 0 ||
+            offset >= process_sizes[static_cast<size_t>(process)]) {
+            stats.invalid_accesses++;
+            return AccessResult::INVALID;
+        }
+        stats.accesses++;
+        uint32_t page = static_cast<uint32_t>(offset >> page_shift);
+        uint64_t key = tlb_key(process, page);
+        TlbEntry* set = tlb_set(process, page);
+        tlb_clock++;
+        for (int way = 0; way < config.tlb_ways; way++) {
+            if (set[way].key == key) {
+                set[way].last_use = tlb_clock;
+                stats.tlb_hits++;
+                stats.cycles += config.costs.tlb_hit;
+                touch(set[way].frame);
+                return AccessResult::TLB_HIT;
+            }
+        }
+        
+        stats.tlb_misses++;
+        AccessResult result = AccessResult::PAGE_HIT;
+        // take_frame solo escribe en tablas ya creadas, así que la referencia sigue válida
+        int& frame = page_tables[static_cast<size_t>(process)][page];
+        if (frame == NO_FRAME) {
+            frame = take_frame();
+            frame_process[static_cast<size_t>(frame)] = process;
+            frame_page[static_cast<size_t>(frame)] = static_cast<int>(page);
+            if (config.policy != ReplacementPolicy::CLOCK) {
+                append_frame(frame);
+            }
+            stats.page_faults++;
+            stats.cycles += config.costs.page_fault;
+            result = AccessResult::PAGE_FAULT;
+        } else {
+            stats.cycles += config.costs.page_walk;
+        }
+        touch(frame);
+        
+        // La traducción entra a la TLB en una vía vacía o en la de uso más antiguo
+        TlbEntry* slot = set;
+        for (int way = 0; way < config.tlb_ways; way++) {
+            if (set[way].key == EMPTY_KEY) {
+                slot = &set[way];
+                break;
+            }
+            if (set[way].last_use < slot->last_use) {
+                slot = &set[way];
+            }
+        }
+        *slot = {key, tlb_clock, frame};
+        return result;
+    }
+    
+    // Verificación completa: cada página residente apunta a un marco que la reconoce,
+    // cada entrada de la TLB traduce a su marco y los marcos libres, ocupados y en la
+    // lista de reemplazo cuadran. Si algo falla describe el primer problema en `problem`.
+    bool check_invariants(std::string& problem) const {
+        int resident = 0;
+        for (size_t process = 0; process < page_tables.size(); process++) {
+            for (size_t page = 0; page < page_tables[process].size(); page++) {
+                int frame = page_tables[process][page];
+                if (frame == NO_FRAME) {
+                    continue;
+                }
+                resident++;
+                if (frame < 0 || frame >= config.frames ||
+                    frame_process[static_cast<size_t>(frame)] != static_cast<int>(process) ||
+                    frame_page[static_cast<size_t>(frame)] != static_cast<int>(page)) {
+                    problem = "la pagina " + std::to_string(page) + " del proceso " + std::to_string(process) +
+                              " apunta al marco " + std::to_string(frame) + ", que no la reconoce";
+                    return false;
+                }
+            }
+        }
+        if (resident + static_cast<int>(free_frames.size()) != config.frames) {
+            problem = std::to_string(resident) + " paginas residentes y " + std::to_string(free_frames.size()) +
+                      " marcos libres para " + std::to_string(config.frames) + " marcos";
+            return false;
+        }
+        if (config.policy != ReplacementPolicy::CLOCK) {
+            int listed = 0;
+            for (int frame = list_head; frame != NO_FRAME && listed <= config.frames;
+                 frame = frame_next[static_cast<size_t>(frame)]) {
+                listed++;
+            }
+            if (listed != resident) {
+                problem = "la lista de reemplazo enlaza " + std::to_string(listed) + " marcos de " +
+                          std::to_string(resident) + " ocupados";
+                return false;
+            }
+        }
+        for (const TlbEntry& entry : tlb) {
+            if (entry.key == EMPTY_KEY) {
+                continue;
+            }
+            size_t process = static_cast<size_t>(entry.key >> 32);
+            size_t page = static_cast<size_t>(entry.key & 0xFFFFFFFFu);
+            if (process >= page_tables.size() || page >= page_tables[process].size() ||
+                page_tables[process][page] != entry.frame) {
+                problem = "la TLB traduce la pagina " + std::to_string(page) + " del proceso " +
+                          std::to_string(process) + " a un marco que no le corresponde";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Resultado de reproducir una traza o una carga sintética en modo paginado
+struct PagingRun {
+    long long lines = 0;          // líneas con comando (accesos en la carga sintética)
+    long long rejected = 0;       // A con tamano inválido o proceso repetido, L sin proceso
+    long long other_commands = 0; // ni A, ni L, ni T (se ignoran)
+    double seconds = 0.0;
+};
+
+// Reproduce los comandos A, L y T (`T <proceso> <desplazamiento>`) de la traza. Los
+// nombres se resuelven con un mapa al leer cada línea; la traducción misma no usa mapas.
+inline PagingRun replay_paging_trace(std::istream& trace, PagedMemory& memory) {
+    PagingRun run;
+    std::unordered_map<std::string, int> processes;
+    std::string line;
+    std::string name; // conserva su capacidad entre líneas
+    ParsedCommand parsed;
+    int line_number = 0;
+    auto started = std::chrono::steady_clock::now();
+    while (std::getline(trace, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) {
+            continue;
+        }
+        run.lines++;
+        
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            int process = processes.count(parsed.process_name) > 0 ? PagedMemory::NO_PROCESS
+                                                                    : memory.create_process(parsed.size);
+            if (process == PagedMemory::NO_PROCESS) {
+                run.rejected++;
+            } else {
+                processes.emplace(parsed.process_name, process);
+            }
+        } else if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+            auto it = processes.find(parsed.process_name);
+            if (it == processes.end()) {
+                run.rejected++;
+                continue;
+            }
+            memory.release_process(it->second);
+            processes.erase(it);
+        } else {
+            std::string_view rest(parsed.line);
+            std::string_view command = next_token(rest);
+            long long offset;
+            if (command.size() == 1 && (command[0] == 'T' || command[0] == 't')) {
+                std::string_view process_name = next_token(rest);
+                name.assign(process_name.data(), process_name.size());
+                auto it = processes.find(name);
+                if (parse_int(next_token(rest), offset)) {
+                    memory.access(it == processes.end() ? PagedMemory::NO_PROCESS : it->second, offset);
+                    continue;
+                }
+            }
+            run.other_commands++;
+        }
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return run;
+}
+
+// Carga sintética: `process_count` procesos que en conjunto piden el doble de la memoria
+// física y `accesses` accesos con localidad. Se queda en un proceso por ráfagas de
+// unos 256 accesos, y 9 de cada 10 caen en una ventana de 1/8 de sus páginas que
+// avanza con el tiempo.
+inline PagingRun run_synthetic_paging(PagedMemory& memory, int process_count, long long accesses, uint64_t seed) {
+    PagingRun run;
+    XorShift64 rng(seed);
+    const PagingConfig& config = memory.get_config();
+    long long physical = static_cast<long long>(config.frames) * config.page_size;
+    int max_size = static_cast<int>(std::min<long long>(INT_MAX / 2, std::max(1LL, 4 * physical / process_count)));
+    std::vector<int> ids, sizes;
+    for (int i = 0; i < process_count; i++) {
+        int size = 1 + rng.below(max_size);
+        ids.push_back(memory.create_process(size));
+        sizes.push_back(size);
+    }
+    
+    auto started = std::chrono::steady_clock::now();
+    size_t current = 0;
+    long long window = 0;
+    for (long long i = 0; i < accesses; i++) {
+        if ((rng.next() & 255) == 0) {
+            current = static_cast<size_t>(rng.below(process_count));
+        }
+        if ((i & 1023) == 0) {
+            window++;
+        }
+        long long size = sizes[current];
+        long long span = std::max(1LL, size / 8);
+        uint64_t random = rng.next();
+        long long offset = random % 10 != 0
+                               ? (window * span / 4 + static_cast<long long>((random >> 8) % static_cast<uint64_t>(span))) % size
+                               : static_cast<long long>((random >> 8) % static_cast<uint64_t>(size));
+        memory.access(ids[current], offset);
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    run.lines = accesses;
+    return run;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_PAGING_HPP
@@ -0,0 +1,237 @@
+// Reproducción en pipeline: cola sin bloqueo y mensajes entre las etapas de
+// análisis, asignación y reporte.
+#ifndef MEMSIM_PIPELINE_HPP
+#define MEMSIM_PIPELINE_HPP
+
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "memory_manager.hpp"
+#include "output.hpp"
+
+namespace memsim {
+
+// Cola circular acotada sin bloqueo (algoritmo de Vyukov). Cada celda lleva un número
+// de secuencia que indica si está lista para escribir o para leer, de modo que admite
+// varios productores y consumidores sin mutex. La capacidad debe ser potencia de 2.
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_position{0};
+    alignas(64) std::atomic<size_t> dequeue_position{0};
+
+public:
+    explicit BoundedQueue(size_t capacity) : cells(new Cell[capacity]), mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    bool try_push(T& value) {
+        size_t position = enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // llena
+            } else {
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool try_pop(T& value) {
+        size_t position = dequeue_position.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // vacía
+            } else {
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    // Variantes que esperan cediendo el procesador mientras la cola está llena/vacía
+    void push(T& value) {
+        while (!try_push(value)) {
+            std::this_thread::yield();
+        }
+    }
+    
+    void pop(T& value) {
+        while (!try_pop(value)) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+// Comando ya analizado por la etapa de parsing
+struct ParsedCommand {
+    enum class Kind : uint8_t { ALLOCATE, RELEASE, OTHER, END };
+    
+    Kind kind = Kind::END;
+    int line_number = 0;
+    Address size = 0;
+    std::string process_name;
+    std::string line; // texto original (eco y comandos que no son A/L)
+};
+
+// Resultado listo para la etapa de reporte
+struct ReportItem {
+    enum class Kind : uint8_t { OPERATION, TEXT, END };
+    
+    Kind kind = Kind::END;
+    OutputFormat format = OutputFormat::TEXT; // formato vigente antes de ejecutar el comando
+    bool trailing_newline = true;             // el formato seguía siendo texto al terminar
+    char op = 'A';
+    OpStatus status = OpStatus::OK;
+    AllocationAlgorithm algorithm = AllocationAlgorithm::FIRST_FIT;
+    int line_number = 0;
+    Address size = 0;
+    Address start = -1;
+    std::string process_name;
+    std::string line;
+    std::string text;           // salida capturada de los comandos que no son A/L
+};
+
+// Extrae la siguiente palabra de `rest` (separada por espacios en blanco, como
+// operator>>) sin copiarla; devuelve una vista vacía si no quedan palabras
+inline std::string_view next_token(std::string_view& rest) {
+    size_t begin = 0;
+    while (begin < rest.size() && std::isspace(static_cast<unsigned char>(rest[begin]))) {
+        begin++;
+    }
+    size_t end = begin;
+    while (end < rest.size() && !std::isspace(static_cast<unsigned char>(rest[end]))) {
+        end++;
+    }
+    std::string_view token = rest.substr(begin, end - begin);
+    rest.remove_prefix(end);
+    return token;
+}
+
+// Entero al comienzo de `token` con las reglas de operator>>: signo opcional y
+// falla si no hay dígitos o si el valor no cabe en el tipo de `value`
+template <class Integer>
+bool parse_int(std::string_view token, Integer& value) {
+    if (!token.empty() && token[0] == '+') {
+        token.remove_prefix(1);
+        if (!token.empty() && token[0] == '-') {
+            return false;
+        }
+    }
+    auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+    return result.ec == std::errc();
+}
+
+// Mayor cantidad de procesos de un AB: el lote se arma completo antes de asignarlo,
+// así que un <n> enorme pediría memoria para millones de solicitudes
+constexpr int MAX_BATCH_SIZE = 1 << 20;
+
+// Argumentos de AB: <n> <prefijo> <tamano...>, con un tamano para todos o uno por
+// proceso. Los nombres son prefijo1 .. prefijoN. Devuelve false si la línea no sirve.
+inline bool parse_batch_allocation(std::string_view rest, std::vector<BatchRequest>& requests) {
+    int count;
+    if (!parse_int(next_token(rest), count) || count <= 0 || count > MAX_BATCH_SIZE) {
+        return false;
+    }
+    std::string_view prefix = next_token(rest);
+    if (prefix.empty()) {
+        return false;
+    }
+    
+    requests.resize(static_cast<size_t>(count));
+    size_t sizes = 0;
+    for (std::string_view token = next_token(rest); !token.empty(); token = next_token(rest)) {
+        if (sizes == requests.size() || !parse_int(token, requests[sizes].size)) {
+            return false;
+        }
+        sizes++;
+    }
+    if (sizes != 1 && sizes != requests.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < requests.size(); i++) {
+        requests[i].process_name.assign(prefix.data(), prefix.size());
+        requests[i].process_name += std::to_string(i + 1);
+        if (sizes == 1) {
+            requests[i].size = requests[0].size;
+        }
+    }
+    return true;
+}
+
+// Argumentos de LB: <proceso...>. Las vistas apuntan dentro de `rest`.
+inline bool parse_batch_release(std::string_view rest, std::vector<std::string_view>& names) {
+    names.clear();
+    for (std::string_view token = next_token(rest); !token.empty(); token = next_token(rest)) {
+        names.push_back(token);
+    }
+    return !names.empty();
+}
+
+// Convierte una línea de traza en un ParsedCommand; devuelve false si debe ignorarse.
+// Las palabras se leen como vistas y el texto se intercambia con parsed.line, así que
+// `line` recibe el buffer anterior y getline lo reutiliza sin pedir memoria.
+inline bool parse_trace_line(std::string& line, int line_number, ParsedCommand& parsed) {
+    if (line.empty() || line[0] == '#') {
+        return false;
+    }
+    
+    parsed.line_number = line_number;
+    parsed.kind = ParsedCommand::Kind::OTHER;
+    parsed.size = 0;
+    parsed.process_name.clear();
+    
+    std::string_view rest(line);
+    std::string_view command = next_token(rest);
+    if (command == "A" || command == "a") {
+        std::string_view process_name = next_token(rest);
+        if (!process_name.empty() && parse_int(next_token(rest), parsed.size)) {
+            parsed.process_name.assign(process_name.data(), process_name.size());
+            parsed.kind = ParsedCommand::Kind::ALLOCATE;
+        }
+    } else if (command == "L" || command == "l") {
+        std::string_view process_name = next_token(rest);
+        if (!process_name.empty()) {
+            parsed.process_name.assign(process_name.data(), process_name.size());
+            parsed.kind = ParsedCommand::Kind::RELEASE;
+        }
+    }
+    parsed.line.swap(line);
+    return true;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_PIPELINE_HPP
@@ -0,0 +1,127 @@
+// Pool de nodos para los contenedores del gestor (std::map / std::set): los nodos
+// liberados vuelven a una lista libre y se reutilizan, de modo que en régimen
+// estable asignar y liberar procesos no pide memoria al heap.
+#ifndef MEMSIM_POOL_HPP
+#define MEMSIM_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace memsim {
+
+// Reserva nodos de un único tamano en bloques de NODES_PER_CHUNK. La memoria solo se
+// devuelve al destruir el pool; las solicitudes de otro tamano van directo al heap.
+class NodePool {
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+    
+    static constexpr size_t NODES_PER_CHUNK = 256;
+    
+    size_t node_size = 0; // se fija con la primera solicitud
+    FreeNode* free_list = nullptr;
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    
+    void grow() {
+        chunks.emplace_back(new std::byte[node_size * NODES_PER_CHUNK]);
+        std::byte* chunk = chunks.back().get();
+        for (size_t i = NODES_PER_CHUNK; i-- > 0;) {
+            FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * node_size);
+            node->next = free_list;
+            free_list = node;
+        }
+    }
+
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    
+    void* allocate(size_t size) {
+        // Los nodos se redondean a la alineación máxima para poder alojar cualquier tipo
+        size_t rounded = (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        if (node_size == 0) {
+            node_size = rounded;
+        }
+        if (rounded != node_size) {
+            return ::operator new(size);
+        }
+        if (free_list == nullptr) {
+            grow();
+        }
+        FreeNode* node = free_list;
+        free_list = node->next;
+        return node;
+    }
+    
+    void deallocate(void* pointer, size_t size) {
+        size_t rounded = (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        if (rounded != node_size) {
+            ::operator delete(pointer);
+            return;
+        }
+        FreeNode* node = static_cast<FreeNode*>(pointer);
+        node->next = free_list;
+        free_list = node;
+    }
+};
+
+// Asignador compatible con la biblioteca estándar que toma los nodos de un NodePool.
+// Las copias comparten el pool (el contenedor lo reenlaza al tipo de su nodo), pero
+// una copia del contenedor recibe un pool propio para no compartirlo entre gestores.
+template <class T>
+class PoolAllocator {
+private:
+    std::shared_ptr<NodePool> pool;
+    
+    template <class U>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+    
+    PoolAllocator() : pool(std::make_shared<NodePool>()) {}
+    
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool(other.pool) {}
+    
+    PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+    
+    T* allocate(size_t count) {
+        if (count != 1) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(pool->allocate(sizeof(T)));
+    }
+    
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        pool->deallocate(pointer, sizeof(T));
+    }
+    
+    template <class U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept {
+        return pool == other.pool;
+    }
+    
+    template <class U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept {
+        return pool != other.pool;
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_POOL_HPP
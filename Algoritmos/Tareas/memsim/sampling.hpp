@@ -0,0 +1,159 @@
+// Muestreo periódico de métricas durante la reproducción de una traza.
+#ifndef MEMSIM_SAMPLING_HPP
+#define MEMSIM_SAMPLING_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "memory_manager.hpp"
+#include "output.hpp"
+
+namespace memsim {
+
+// Muestra de métricas tomada durante la reproducción de una traza. Todos los campos
+// son de 64 bits para que el formato binario sea un arreglo plano de registros fijos.
+struct MetricsSample {
+    long long operation;          // operaciones A/L procesadas hasta la muestra
+    long long elapsed_us;         // microsegundos desde que se activó el muestreo
+    long long used_memory;
+    long long free_memory;
+    long long free_blocks;
+    long long largest_free_block;
+    long long failed_allocations;
+};
+
+enum class SamplingMode {
+    OFF,
+    OPERATIONS,
+    MICROSECONDS
+};
+
+// Muestreo periódico de métricas en un buffer circular. Solo lee los contadores
+// incrementales del gestor (get_counters y get_largest_free_block), por lo que cada
+// muestra cuesta O(1).
+class MetricsSampler {
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    SamplingMode mode = SamplingMode::OFF;
+    long long interval = 0;
+    std::vector<MetricsSample> ring;
+    size_t head = 0;               // posición donde se escribirá la siguiente muestra
+    size_t stored = 0;             // muestras válidas en el buffer
+    long long overwritten = 0;     // muestras descartadas por buffer lleno
+    long long next_operation = 0;
+    Clock::time_point started;
+    Clock::time_point next_time;
+    
+    template <class Manager>
+    void push(const Manager& manager, Clock::time_point now) {
+        const MemoryCounters& c = manager.get_counters();
+        MetricsSample& sample = ring[head];
+        sample.operation = c.operations;
+        sample.elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - started).count();
+        sample.used_memory = c.used_memory;
+        sample.free_memory = c.free_memory;
+        sample.free_blocks = c.free_blocks;
+        sample.largest_free_block = manager.get_largest_free_block();
+        sample.failed_allocations = c.failed_allocations;
+        
+        head = (head + 1) % ring.size();
+        if (stored < ring.size()) {
+            stored++;
+        } else {
+            overwritten++;
+        }
+    }
+    
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 65536;
+    
+    // Activar el muestreo cada `every` operaciones o microsegundos
+    void configure(SamplingMode new_mode, long long every, size_t capacity = DEFAULT_CAPACITY) {
+        mode = (every > 0 && capacity > 0) ? new_mode : SamplingMode::OFF;
+        interval = every;
+        ring.assign(mode == SamplingMode::OFF ? 0 : capacity, MetricsSample{});
+        head = 0;
+        stored = 0;
+        overwritten = 0;
+        next_operation = every;
+        started = Clock::now();
+        next_time = started;
+    }
+    
+    bool enabled() const {
+        return mode != SamplingMode::OFF;
+    }
+    
+    size_t size() const {
+        return stored;
+    }
+    
+    long long dropped() const {
+        return overwritten;
+    }
+    
+    // Llamar después de cada operación A/L
+    template <class Manager>
+    void on_operation(const Manager& manager) {
+        if (mode == SamplingMode::OPERATIONS) {
+            long long done = manager.get_counters().operations;
+            if (done < next_operation) return;
+            next_operation = done + interval;
+            push(manager, Clock::now());
+        } else if (mode == SamplingMode::MICROSECONDS) {
+            Clock::time_point now = Clock::now();
+            if (now < next_time) return;
+            next_time = now + std::chrono::microseconds(interval);
+            push(manager, now);
+        }
+    }
+    
+    // Escribir las muestras (de la más antigua a la más reciente) en CSV o binario.
+    // Binario: "MSMP", version (u32), bytes por registro (u32), cantidad (u64) y
+    // luego los registros de 7 enteros de 64 bits en el orden de bytes de la máquina.
+    bool save(const std::string& filename, bool binary) const {
+        std::ofstream file(filename, binary ? std::ios::binary : std::ios::out);
+        if (!file.is_open()) {
+            return false;
+        }
+        
+        size_t first = (head + ring.size() - stored) % (ring.empty() ? 1 : ring.size());
+        if (binary) {
+            const uint32_t version = 1;
+            const uint32_t record_size = sizeof(MetricsSample);
+            const uint64_t count = stored;
+            file.write("MSMP", 4);
+            file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            file.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            // El buffer circular se escribe en a lo sumo dos tramos contiguos
+            size_t first_run = std::min(stored, ring.size() - first);
+            // ring.data() + first y no &ring[first]: sin muestreo configurado el buffer está vacío
+            file.write(reinterpret_cast<const char*>(ring.data() + first), first_run * sizeof(MetricsSample));
+            file.write(reinterpret_cast<const char*>(ring.data()), (stored - first_run) * sizeof(MetricsSample));
+        } else {
+            StreamWriter writer(file);
+            writer.raw("operation,elapsed_us,used,free,free_blocks,largest_free,failures\n");
+            for (size_t i = 0; i < stored; i++) {
+                const MetricsSample& sample = ring[(first + i) % ring.size()];
+                writer.number(sample.operation).raw(',')
+                      .number(sample.elapsed_us).raw(',')
+                      .number(sample.used_memory).raw(',')
+                      .number(sample.free_memory).raw(',')
+                      .number(sample.free_blocks).raw(',')
+                      .number(sample.largest_free_block).raw(',')
+                      .number(sample.failed_allocations).raw('\n');
+            }
+        }
+        return static_cast<bool>(file);
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_SAMPLING_HPP
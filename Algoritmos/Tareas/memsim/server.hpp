@@ -0,0 +1,568 @@
+// Servidor del asignador en un socket de dominio Unix: un bucle epoll de un solo hilo
+// atiende a varios clientes sobre un mismo gestor, y cada cliente puede tener muchas
+// peticiones en vuelo. Incluye el generador de carga que mide rendimiento y latencia.
+// Los sockets Unix y epoll son de Linux; en otros sistemas solo queda el protocolo.
+#ifndef MEMSIM_SERVER_HPP
+#define MEMSIM_SERVER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "concurrent.hpp"
+#include "memory_manager.hpp"
+#include "pipeline.hpp"
+#include "timed.hpp"
+
+namespace memsim {
+
+#ifdef __linux__
+constexpr bool SERVER_SUPPORTED = true;
+#else
+constexpr bool SERVER_SUPPORTED = false;
+#endif
+
+// Protocolo de líneas; cada petición lleva un identificador que la respuesta repite:
+//   <id> A <proceso> <tamano>  ->  <id> OK <inicio>
+//   <id> L <proceso>           ->  <id> OK <inicio> <tamano>
+//   <id> S                     ->  <id> OK <usada> <libre> <bloques_libres> <mayor_hueco> <fallos> <operaciones>
+//   <id> ALG <1-6>             ->  <id> OK <n>
+//   <id> SHUTDOWN              ->  <id> OK (el servidor termina tras responder)
+// Los errores son `<id> ERR <estado>` con el nombre de OpStatus o `bad_request`. Las
+// respuestas de una conexión salen en el orden de sus peticiones.
+template <class Manager>
+void handle_server_request(Manager& manager, std::string_view line, std::string& out, bool& shutdown) {
+    std::string_view rest = line;
+    std::string_view id = next_token(rest);
+    std::string command(next_token(rest));
+    std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+    out.append(id.empty() ? "-" : id);
+    
+    Address start = -1, size = 0;
+    OpStatus status = OpStatus::OK;
+    if (command == "A") {
+        std::string_view process_name = next_token(rest);
+        if (process_name.empty() || !parse_int(next_token(rest), size)) {
+            out.append(" ERR bad_request\n");
+            return;
+        }
+        status = manager.try_allocate(process_name, size, start);
+        if (status == OpStatus::OK) {
+            out.append(" OK ").append(std::to_string(start)).push_back('\n');
+            return;
+        }
+    } else if (command == "L") {
+        std::string_view process_name = next_token(rest);
+        if (process_name.empty()) {
+            out.append(" ERR bad_request\n");
+            return;
+        }
+        status = manager.try_deallocate(process_name, start, size);
+        if (status == OpStatus::OK) {
+            out.append(" OK ").append(std::to_string(start)).append(" ").append(std::to_string(size)).push_back('\n');
+            return;
+        }
+    } else if (command == "S") {
+        const MemoryCounters& counters = manager.get_counters();
+        out.append(" OK ").append(std::to_string(counters.used_memory)).append(" ");
+        out.append(std::to_string(counters.free_memory)).append(" ").append(std::to_string(counters.free_blocks));
+        out.append(" ").append(std::to_string(manager.get_largest_free_block())).append(" ");
+        out.append(std::to_string(counters.failed_allocations)).append(" ");
+        out.append(std::to_string(counters.operations)).push_back('\n');
+        return;
+    } else if (command == "ALG") {
+        int number;
+        if (!parse_int(next_token(rest), number) || number < 1 || number > static_cast<int>(ALGORITHM_NAMES.size())) {
+            out.append(" ERR bad_request\n");
+            return;
+        }
+        manager.set_algorithm(static_cast<AllocationAlgorithm>(number - 1));
+        out.append(" OK ").append(std::to_string(number)).push_back('\n');
+        return;
+    } else if (command == "SHUTDOWN") {
+        shutdown = true;
+        out.append(" OK\n");
+        return;
+    } else {
+        out.append(" ERR bad_request\n");
+        return;
+    }
+    out.append(" ERR ").append(op_status_name(status)).push_back('\n');
+}
+
+// Contadores del servidor. `reads` cuenta las lecturas que trajeron peticiones
+// completas; peticiones / lecturas es cuánto agrupa el pipelining de los clientes.
+struct ServerStats {
+    long long connections = 0;
+    long long requests = 0;
+    long long reads = 0;
+    long long writes = 0;
+    long long max_batch = 0;     // peticiones atendidas en una sola lectura
+    long long stalled_reads = 0; // veces que se dejó de leer a un cliente que no recibía sus respuestas
+    long long oversized_lines = 0; // conexiones cortadas por una línea sin '\n' de más de MAX_LINE
+};
+
+// Configuración del generador de carga. Cada conexión emite `ops` peticiones con a lo
+// sumo `depth` en vuelo: 55% A de 1 a `max_size` unidades, 44% L de un proceso propio
+// confirmado y un S cada 100 peticiones.
+struct LoadConfig {
+    int connections = 4;
+    int ops = 100000;
+    int depth = 64;
+    int max_size = 256;
+    uint64_t seed = 1;
+    std::string prefix = "c"; // prefijo de los procesos, distinto por corrida
+};
+
+struct LoadReport {
+    long long requests = 0;
+    long long ok = 0;
+    long long no_memory = 0;
+    long long errors = 0;      // respuestas ERR que no son falta de memoria
+    long long bad_replies = 0; // respuestas fuera de orden o ilegibles
+    double seconds = 0.0;
+    TimeSummary latency;       // nanosegundos desde enviar la petición hasta leer su respuesta
+    std::string problem;       // error de conexión, si lo hubo
+    
+    double throughput() const {
+        return seconds > 0.0 ? static_cast<double>(requests) / seconds : 0.0;
+    }
+};
+
+#ifdef __linux__
+
+// Bucle epoll sobre un gestor. No usa hilos ni bloqueos: las peticiones de todos los
+// clientes se atienden en serie, en el orden en que se leen.
+template <class Manager>
+class AllocatorServer {
+private:
+    static constexpr size_t READ_CHUNK = 64 * 1024;
+    static constexpr size_t MAX_PENDING_OUTPUT = 1 << 20; // con más, se deja de leer al cliente
+    static constexpr size_t MAX_LINE = 64 * 1024;         // una línea más larga corta la conexión
+    static constexpr int MAX_EVENTS = 64;
+    
+    struct Connection {
+        std::string input;
+        std::string output;
+        size_t sent = 0;
+        bool reading = true;
+        bool peer_closed = false; // el cliente cerró su lado: solo queda enviarle lo pendiente
+    };
+    
+    Manager& manager;
+    std::string path;
+    int listen_fd = -1;
+    int epoll_fd = -1;
+    std::unordered_map<int, Connection> connections;
+    std::atomic<bool> stopping{false};
+    ServerStats stats;
+    
+    void watch(int fd, uint32_t events, int operation) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, operation, fd, &event);
+    }
+    
+    void close_connection(int fd) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+    
+    void accept_clients() {
+        int fd;
+        while ((fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+            connections.emplace(fd, Connection());
+            watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+            stats.connections++;
+        }
+    }
+    
+    // Envía lo pendiente; false si el cliente se fue
+    bool flush(int fd, Connection& connection) {
+        while (connection.sent < connection.output.size()) {
+            ssize_t written = send(fd, connection.output.data() + connection.sent,
+                                   connection.output.size() - connection.sent, MSG_NOSIGNAL);
+            if (written < 0) {
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            connection.sent += static_cast<size_t>(written);
+            stats.writes++;
+        }
+        connection.output.clear();
+        connection.sent = 0;
+        return true;
+    }
+    
+    // Atiende todas las líneas completas de la entrada; el resto espera a la próxima lectura
+    void serve_input(Connection& connection) {
+        size_t begin = 0;
+        long long batch = 0;
+        bool shutdown = false;
+        for (size_t end = connection.input.find('\n'); end != std::string::npos;
+             end = connection.input.find('\n', begin)) {
+            std::string_view line(connection.input.data() + begin, end - begin);
+            begin = end + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.find_first_not_of(" \t") == std::string_view::npos) {
+                continue;
+            }
+            handle_server_request(manager, line, connection.output, shutdown);
+            batch++;
+        }
+        connection.input.erase(0, begin);
+        if (batch > 0) {
+            stats.reads++;
+            stats.requests += batch;
+            stats.max_batch = std::max(stats.max_batch, batch);
+        }
+        if (shutdown) {
+            stopping = true;
+        }
+    }
+    
+    void on_event(int fd, uint32_t events) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        Connection& connection = it->second;
+        bool broken = (events & EPOLLERR) != 0;
+        // Cada trozo leído se atiende enseguida: la entrada nunca pasa de una línea
+        // incompleta y se deja de leer en cuanto las respuestas pendientes llegan al tope
+        if (!broken && (events & EPOLLIN) != 0) {
+            char buffer[READ_CHUNK];
+            while (connection.output.size() - connection.sent < MAX_PENDING_OUTPUT) {
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    connection.input.append(buffer, static_cast<size_t>(received));
+                    serve_input(connection);
+                    if (connection.input.size() > MAX_LINE) {
+                        stats.oversized_lines++;
+                        broken = true;
+                        break;
+                    }
+                    continue;
+                }
+                if (received == 0) {
+                    connection.peer_closed = true;
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    broken = true;
+                }
+                break;
+            }
+        }
+        // Con un error, un cuelgue o un envío fallido lo pendiente ya no puede entregarse
+        if (broken || (events & EPOLLHUP) != 0 || !flush(fd, connection) ||
+            (connection.peer_closed && connection.output.empty())) {
+            close_connection(fd);
+            return;
+        }
+        
+        // Si el cliente no lee sus respuestas, se deja de leerle hasta que las reciba
+        bool reading = connection.output.size() - connection.sent < MAX_PENDING_OUTPUT;
+        if (!reading && connection.reading) {
+            stats.stalled_reads++;
+        }
+        connection.reading = reading;
+        uint32_t events_wanted = (reading && !connection.peer_closed ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+                                 (connection.output.empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+        watch(fd, events_wanted, EPOLL_CTL_MOD);
+    }
+
+public:
+    explicit AllocatorServer(Manager& target) : manager(target) {}
+    
+    ~AllocatorServer() {
+        for (auto& [fd, connection] : connections) {
+            close(fd);
+        }
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+        if (listen_fd >= 0) {
+            close(listen_fd);
+            unlink(path.c_str());
+        }
+    }
+    
+    // Crea el socket en `socket_path` (reemplaza uno anterior); devuelve el error o ""
+    std::string listen_on(const std::string& socket_path) {
+        sockaddr_un address{};
+        if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+            return "ruta de socket vacia o demasiado larga";
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+        unlink(socket_path.c_str());
+        
+        listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            listen(listen_fd, SOMAXCONN) < 0) {
+            return std::string("no se pudo escuchar en '") + socket_path + "': " + std::strerror(errno);
+        }
+        path = socket_path;
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd < 0) {
+            return std::string("epoll: ") + std::strerror(errno);
+        }
+        watch(listen_fd, EPOLLIN, EPOLL_CTL_ADD);
+        return "";
+    }
+    
+    // Atiende hasta recibir SHUTDOWN o hasta stop() (también desde otro hilo o una señal)
+    ServerStats run() {
+        epoll_event events[MAX_EVENTS];
+        while (!stopping) {
+            int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, 100);
+            for (int i = 0; i < ready; i++) {
+                if (events[i].data.fd == listen_fd) {
+                    accept_clients();
+                } else {
+                    on_event(events[i].data.fd, events[i].events);
+                }
+            }
+        }
+        for (auto& [fd, connection] : connections) {
+            flush(fd, connection);
+        }
+        return stats;
+    }
+    
+    void stop() {
+        stopping = true;
+    }
+};
+
+namespace detail {
+
+inline int connect_unix(const std::string& socket_path, std::string& problem) {
+    sockaddr_un address{};
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        problem = "ruta de socket demasiado larga";
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        problem = std::string("no se pudo conectar a '") + socket_path + "': " + std::strerror(errno);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+inline bool send_all(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t written = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace detail
+
+// Envía SHUTDOWN y espera la respuesta
+inline std::string shutdown_server(const std::string& socket_path) {
+    std::string problem;
+    int fd = detail::connect_unix(socket_path, problem);
+    if (fd < 0) {
+        return problem;
+    }
+    char reply[64];
+    if (!detail::send_all(fd, "0 SHUTDOWN\n") || recv(fd, reply, sizeof(reply), 0) <= 0) {
+        problem = "el servidor no respondio a SHUTDOWN";
+    }
+    close(fd);
+    return problem;
+}
+
+// Un hilo por conexión. Cada uno escribe de una vez todas las peticiones que caben en
+// la ventana de `depth` y lee las respuestas a medida que llegan; la latencia de cada
+// petición va desde que se envió su tanda hasta que se leyó su respuesta.
+inline LoadReport run_load_generator(const std::string& socket_path, const LoadConfig& config) {
+    using Clock = std::chrono::steady_clock;
+    struct ClientResult {
+        LoadReport report;
+        std::vector<long long> latencies;
+    };
+    std::vector<ClientResult> results(static_cast<size_t>(config.connections));
+    
+    auto client = [&](int index) {
+        ClientResult& result = results[static_cast<size_t>(index)];
+        LoadReport& report = result.report;
+        int fd = detail::connect_unix(socket_path, report.problem);
+        if (fd < 0) {
+            return;
+        }
+        result.latencies.reserve(static_cast<size_t>(config.ops));
+        
+        struct InFlight {
+            long long id;
+            Clock::time_point sent;
+            char op;
+            int process;
+        };
+        std::deque<InFlight> in_flight;
+        std::vector<int> live;     // procesos con A confirmado y sin L enviado
+        std::string prefix = config.prefix + std::to_string(index) + "P";
+        XorShift64 rng(config.seed * 7919 + static_cast<uint64_t>(index));
+        std::string batch, input;
+        char buffer[64 * 1024];
+        long long next_id = 1;
+        
+        while (report.requests < config.ops) {
+            batch.clear();
+            std::vector<InFlight> queued;
+            while (static_cast<int>(in_flight.size() + queued.size()) < config.depth &&
+                   next_id <= config.ops) {
+                InFlight request{next_id, Clock::time_point(), 'A', static_cast<int>(next_id)};
+                int roll = rng.below(100);
+                batch.append(std::to_string(next_id));
+                if (next_id % 100 == 0) {
+                    request.op = 'S';
+                    batch.append(" S\n");
+                } else if (!live.empty() && roll < 44) {
+                    size_t victim = static_cast<size_t>(rng.below(static_cast<int>(live.size())));
+                    std::swap(live[victim], live.back());
+                    request.op = 'L';
+                    request.process = live.back();
+                    live.pop_back();
+                    batch.append(" L ").append(prefix).append(std::to_string(request.process)).push_back('\n');
+                } else {
+                    batch.append(" A ").append(prefix).append(std::to_string(request.process)).append(" ");
+                    batch.append(std::to_string(1 + rng.below(config.max_size))).push_back('\n');
+                }
+                queued.push_back(request);
+                next_id++;
+            }
+            if (!queued.empty()) {
+                Clock::time_point now = Clock::now();
+                for (auto& request : queued) {
+                    request.sent = now;
+                    in_flight.push_back(request);
+                }
+                if (!detail::send_all(fd, batch)) {
+                    report.problem = "conexion cerrada por el servidor";
+                    break;
+                }
+            }
+            
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                report.problem = "conexion cerrada por el servidor";
+                break;
+            }
+            Clock::time_point arrived = Clock::now();
+            input.append(buffer, static_cast<size_t>(received));
+            size_t begin = 0;
+            for (size_t end = input.find('\n'); end != std::string::npos; end = input.find('\n', begin)) {
+                std::string_view rest(input.data() + begin, end - begin);
+                begin = end + 1;
+                long long id;
+                if (in_flight.empty() || !parse_int(next_token(rest), id) || id != in_flight.front().id) {
+                    report.bad_replies++;
+                    continue;
+                }
+                const InFlight& request = in_flight.front();
+                std::string_view status = next_token(rest);
+                if (status == "OK") {
+                    report.ok++;
+                    if (request.op == 'A') {
+                        live.push_back(request.process);
+                    }
+                } else if (next_token(rest) == op_status_name(OpStatus::NO_MEMORY)) {
+                    report.no_memory++;
+                } else {
+                    report.errors++;
+                }
+                result.latencies.push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(arrived - request.sent).count());
+                report.requests++;
+                in_flight.pop_front();
+            }
+            input.erase(0, begin);
+        }
+        
+        // Devuelve lo que quedó asignado (fuera de la medición) para que otra corrida
+        // empiece con la memoria libre. Va por tandas de `depth`, como la carga.
+        for (size_t first = 0; first < live.size() && report.problem.empty(); first += config.depth) {
+            batch.clear();
+            size_t last = std::min(live.size(), first + static_cast<size_t>(config.depth));
+            for (size_t i = first; i < last; i++) {
+                batch.append("0 L ").append(prefix).append(std::to_string(live[i])).push_back('\n');
+            }
+            long long pending = static_cast<long long>(last - first);
+            if (!detail::send_all(fd, batch)) {
+                break;
+            }
+            while (pending > 0) {
+                ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+                if (received <= 0) {
+                    report.problem = "conexion cerrada por el servidor";
+                    break;
+                }
+                pending -= std::count(buffer, buffer + received, '\n');
+            }
+        }
+        close(fd);
+    };
+    
+    auto started = Clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < config.connections; i++) {
+        threads.emplace_back(client, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    LoadReport total;
+    total.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    std::vector<long long> latencies;
+    for (auto& result : results) {
+        total.requests += result.report.requests;
+        total.ok += result.report.ok;
+        total.no_memory += result.report.no_memory;
+        total.errors += result.report.errors;
+        total.bad_replies += result.report.bad_replies;
+        if (total.problem.empty()) {
+            total.problem = result.report.problem;
+        }
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+    }
+    total.latency = summarize_times(latencies);
+    return total;
+}
+
+#endif // __linux__
+
+} // namespace memsim
+
+#endif // MEMSIM_SERVER_HPP
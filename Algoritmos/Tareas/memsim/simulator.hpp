@@ -0,0 +1,434 @@
+// Intérprete de comandos común a los simuladores: comandos A, L, R, AB, LB, M, S, FR, F y Q,
+// reproducción de archivos (secuencial o en pipeline) y bucle interactivo.
+#ifndef MEMSIM_SIMULATOR_HPP
+#define MEMSIM_SIMULATOR_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "memory_manager.hpp"
+#include "output.hpp"
+#include "pipeline.hpp"
+#include "sampling.hpp"
+#include "test_files.hpp"
+
+namespace memsim {
+
+// Mensajes del comando F que cada ejecutable conserva con su propia ortografía
+struct ShellTexts {
+    const char* selecting_file;
+    const char* no_file_selected;
+    FileSelectionTexts selection;
+};
+
+// Base de los simuladores (CRTP). `Manager` aporta la presentación: allocate,
+// deallocate, show_memory, show_statistics y analyze_fragmentation, además de
+// try_allocate/try_deallocate del gestor. `Derived` debe definir TEXTS y
+// report_operation, y puede redefinir los puntos de extensión marcados abajo.
+template <class Derived, class Manager>
+class SimulatorBase {
+protected:
+    Manager memory_manager;
+    MetricsSampler sampler;
+    bool pipelined = false;
+    std::vector<BatchRequest> batch_requests; // AB y LB conservan la capacidad entre lotes
+    std::vector<std::string_view> batch_names;
+    std::vector<BatchResult> batch_results;
+    
+    static constexpr size_t PIPELINE_QUEUE_CAPACITY = 4096;
+    
+    Derived& derived() {
+        return static_cast<Derived&>(*this);
+    }
+    
+    const Derived& derived() const {
+        return static_cast<const Derived&>(*this);
+    }
+    
+    // Puntos de extensión: el derivado los redefine con el mismo nombre
+    OutputFormat output_format() const {
+        return OutputFormat::TEXT;
+    }
+    
+    // Comandos propios del ejecutable; devuelve false si no lo reconoce
+    bool process_extra_command(const std::string&, std::istringstream&) {
+        return false;
+    }
+    
+    void flush_output() {}
+    
+    // Reproduce las líneas A/L consecutivas con la política ya fijada por dispatch.
+    // Devuelve true tras ejecutar cualquier otro comando (pudo cambiar el algoritmo,
+    // así que el llamador vuelve a despachar) y false al terminar el flujo. `line` y
+    // `parsed` vienen del llamador para conservar su capacidad entre tramos.
+    template <class Placement>
+    bool replay_segment(Placement& placement, std::istream& input, std::string& line,
+                        ParsedCommand& parsed, int& line_number) {
+        while (std::getline(input, line)) {
+            line_number++;
+            
+            // Ignorar líneas vacías y comentarios
+            if (!parse_trace_line(line, line_number, parsed)) {
+                continue;
+            }
+            
+            if (human_output()) {
+                std::cout << "[Linea " << line_number << "] " << parsed.line << "\n";
+            }
+            
+            if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+                Address start;
+                OpStatus status = memory_manager.try_allocate_with(placement, parsed.process_name, parsed.size, start);
+                memory_manager.report('A', parsed.process_name, parsed.size, status, start);
+                sampler.on_operation(memory_manager);
+            } else if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+                Address start, size;
+                OpStatus status = memory_manager.try_deallocate(parsed.process_name, start, size);
+                memory_manager.report('L', parsed.process_name, size, status, start);
+                sampler.on_operation(memory_manager);
+            } else {
+                // Los registros pendientes salen antes que cualquier texto del comando
+                derived().flush_output();
+                process_command(parsed.line);
+                if (human_output()) {
+                    std::cout << "\n";
+                }
+                return true;
+            }
+            
+            if (human_output()) {
+                std::cout << "\n"; // Espacio entre comandos para mejor legibilidad
+            }
+        }
+        return false;
+    }
+    
+    // Reproducción clásica: analizar, ejecutar e imprimir cada línea en secuencia. El
+    // algoritmo se despacha una vez por tramo de comandos A/L, no en cada asignación.
+    void replay_sequential(std::istream& input) {
+        std::string line;
+        ParsedCommand parsed;
+        int line_number = 0;
+        while (memory_manager.dispatch([&](auto& placement) {
+            return replay_segment(placement, input, line, parsed, line_number);
+        })) {
+        }
+        derived().flush_output();
+    }
+    
+    // Etapa de asignación del pipeline con la política fijada: ejecuta comandos hasta
+    // uno que no sea A/L (devuelve true, para volver a despachar) o hasta el fin (false)
+    template <class Placement>
+    bool allocate_segment(Placement& placement, BoundedQueue<ParsedCommand>& commands,
+                          BoundedQueue<ReportItem>& reports, std::ostringstream& captured) {
+        ParsedCommand command;
+        ReportItem item;
+        while (true) {
+            commands.pop(command);
+            if (command.kind == ParsedCommand::Kind::END) {
+                return false;
+            }
+            
+            item.format = derived().output_format();
+            item.line_number = command.line_number;
+            item.line = std::move(command.line);
+            
+            if (command.kind == ParsedCommand::Kind::ALLOCATE) {
+                item.kind = ReportItem::Kind::OPERATION;
+                item.op = 'A';
+                item.size = command.size;
+                item.status = memory_manager.try_allocate_with(placement, command.process_name, command.size, item.start);
+                item.algorithm = Placement::algorithm;
+                item.process_name = std::move(command.process_name);
+                sampler.on_operation(memory_manager);
+            } else if (command.kind == ParsedCommand::Kind::RELEASE) {
+                item.kind = ReportItem::Kind::OPERATION;
+                item.op = 'L';
+                item.status = memory_manager.try_deallocate(command.process_name, item.start, item.size);
+                item.algorithm = Placement::algorithm;
+                item.process_name = std::move(command.process_name);
+                sampler.on_operation(memory_manager);
+            } else {
+                item.kind = ReportItem::Kind::TEXT;
+                process_command(item.line);
+                derived().flush_output();
+                item.text = captured.str();
+                captured.str("");
+                item.trailing_newline = human_output();
+                reports.push(item);
+                return true;
+            }
+            item.trailing_newline = human_output();
+            reports.push(item);
+        }
+    }
+    
+    // Reproducción en tres etapas conectadas por colas sin bloqueo: un hilo analiza
+    // la traza, el hilo llamador ejecuta los comandos sobre el gestor y otro hilo
+    // da formato e imprime. La salida es idéntica a la reproducción secuencial; los
+    // comandos distintos de A/L se ejecutan con std::cout redirigido a un buffer.
+    void replay_pipelined(std::istream& input) {
+        BoundedQueue<ParsedCommand> commands(PIPELINE_QUEUE_CAPACITY);
+        BoundedQueue<ReportItem> reports(PIPELINE_QUEUE_CAPACITY);
+        std::streambuf* terminal = std::cout.rdbuf();
+        
+        std::thread parser([&]() {
+            std::string line;
+            int line_number = 0;
+            ParsedCommand parsed;
+            while (std::getline(input, line)) {
+                line_number++;
+                if (parse_trace_line(line, line_number, parsed)) {
+                    commands.push(parsed);
+                }
+            }
+            parsed = ParsedCommand();
+            commands.push(parsed);
+        });
+        
+        std::thread reporter([&]() {
+            std::ostream out(terminal);
+            RecordWriter records(out);
+            ReportItem item;
+            while (true) {
+                reports.pop(item);
+                if (item.kind == ReportItem::Kind::END) {
+                    break;
+                }
+                
+                if (item.format == OutputFormat::TEXT) {
+                    out << "[Linea " << item.line_number << "] " << item.line << "\n";
+                }
+                if (item.kind == ReportItem::Kind::OPERATION) {
+                    Derived::report_operation(out, records, item);
+                } else {
+                    out << item.text;
+                }
+                if (item.trailing_newline) {
+                    out << "\n";
+                }
+            }
+            out.flush();
+        });
+        
+        // Etapa de asignación (hilo actual), despachada una vez por tramo de comandos A/L
+        std::ostringstream captured;
+        std::cout.rdbuf(captured.rdbuf());
+        while (memory_manager.dispatch([&](auto& placement) {
+            return allocate_segment(placement, commands, reports, captured);
+        })) {
+        }
+        std::cout.rdbuf(terminal);
+        
+        ReportItem item;
+        reports.push(item);
+        parser.join();
+        reporter.join();
+    }
+    
+    // Bucle interactivo: leer y ejecutar comandos hasta Q o fin de la entrada
+    void command_loop() {
+        std::string line;
+        while (true) {
+            std::cout << "shell> ";
+            if (!std::getline(std::cin, line)) {
+                break;
+            }
+            
+            if (!process_command(line)) {
+                break;
+            }
+        }
+    }
+
+public:
+    template <class... Args>
+    explicit SimulatorBase(Args&&... args) : memory_manager(std::forward<Args>(args)...) {}
+    
+    // En los formatos estructurados solo se emiten registros, sin texto para humanos
+    bool human_output() const {
+        return derived().output_format() == OutputFormat::TEXT;
+    }
+    
+    MetricsSampler& get_sampler() {
+        return sampler;
+    }
+    
+    // Activar la reproducción de archivos en pipeline (análisis, asignación y reporte en hilos)
+    void set_pipelined(bool enabled) {
+        pipelined = enabled;
+    }
+    
+    // Registrar las decisiones de cada A/L (decision_log.hpp); nullptr lo desactiva
+    void set_decision_sink(DecisionSink* sink) {
+        memory_manager.set_decision_sink(sink);
+    }
+    
+    // Alineación, tamano mínimo de corte y cabecera de los bloques (antes de asignar)
+    bool set_layout(const BlockLayout& layout) {
+        return memory_manager.set_layout(layout);
+    }
+    
+    // Listas rápidas por tamano para los bloques liberados (ver QuickListConfig)
+    bool set_quick_lists(const QuickListConfig& config) {
+        return memory_manager.set_quick_lists(config);
+    }
+    
+    // Reproducir los comandos de un flujo (archivo de traza)
+    void replay(std::istream& input) {
+        if (pipelined) {
+            replay_pipelined(input);
+        } else {
+            replay_sequential(input);
+        }
+    }
+    
+    bool process_command(const std::string& line) {
+        // A, L, R, AB y LB se leen como vistas sobre `line`; solo el resto de los comandos arma
+        // un istringstream para sus argumentos
+        std::string_view rest(line);
+        std::string command(next_token(rest));
+        
+        if (command.empty()) {
+            return true;
+        }
+        
+        // Convertir a mayúsculas
+        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+        
+        if (command == "A") {
+            std::string_view process_name = next_token(rest);
+            Address size;
+            if (!process_name.empty() && parse_int(next_token(rest), size)) {
+                memory_manager.allocate(process_name, size);
+                sampler.on_operation(memory_manager);
+            } else {
+                std::cout << "Uso: A <proceso> <tamano>\n";
+            }
+            derived().flush_output();
+            return true;
+        }
+        if (command == "R") {
+            std::string_view process_name = next_token(rest);
+            Address size;
+            if (!process_name.empty() && parse_int(next_token(rest), size)) {
+                memory_manager.resize(process_name, size);
+                sampler.on_operation(memory_manager);
+            } else {
+                std::cout << "Uso: R <proceso> <nuevo_tamano>\n";
+            }
+            derived().flush_output();
+            return true;
+        }
+        if (command == "AB") {
+            // Un mensaje por proceso, igual que los A equivalentes; el muestreo ve el lote completo
+            if (parse_batch_allocation(rest, batch_requests)) {
+                memory_manager.try_allocate_batch(batch_requests, batch_results);
+                for (size_t i = 0; i < batch_results.size(); i++) {
+                    memory_manager.report('A', batch_requests[i].process_name, batch_requests[i].size,
+                                          batch_results[i].status, batch_results[i].start);
+                }
+                sampler.on_operation(memory_manager);
+            } else {
+                std::cout << "Uso: AB <n> <prefijo> <tamano> | AB <n> <prefijo> <tamano1> ... <tamanoN> (n hasta "
+                          << MAX_BATCH_SIZE << ")\n";
+            }
+            derived().flush_output();
+            return true;
+        }
+        if (command == "LB") {
+            if (parse_batch_release(rest, batch_names)) {
+                memory_manager.try_deallocate_batch(batch_names, batch_results);
+                for (size_t i = 0; i < batch_results.size(); i++) {
+                    memory_manager.report('L', batch_names[i], batch_results[i].size, batch_results[i].status,
+                                          batch_results[i].start);
+                }
+                sampler.on_operation(memory_manager);
+            } else {
+                std::cout << "Uso: LB <proceso1> <proceso2> ...\n";
+            }
+            derived().flush_output();
+            return true;
+        }
+        if (command == "L") {
+            std::string_view process_name = next_token(rest);
+            if (!process_name.empty()) {
+                memory_manager.deallocate(process_name);
+                sampler.on_operation(memory_manager);
+            } else {
+                std::cout << "Uso: L <proceso>\n";
+            }
+            derived().flush_output();
+            return true;
+        }
+        
+        std::istringstream iss{std::string(rest)};
+        if (command == "M") {
+            memory_manager.show_memory();
+        }
+        else if (command == "S") {
+            memory_manager.show_statistics();
+        }
+        else if (command == "FR") {
+            memory_manager.analyze_fragmentation();
+        }
+        else if (command == "F") {
+            std::string filename;
+            if (iss >> filename) {
+                execute_from_file(filename);
+            } else {
+                // Si no se proporciona archivo, usar selección dinámica
+                std::cout << Derived::TEXTS.selecting_file;
+                std::string selected_file = select_test_file(Derived::TEXTS.selection);
+                if (!selected_file.empty()) {
+                    execute_from_file(selected_file);
+                } else {
+                    std::cout << Derived::TEXTS.no_file_selected;
+                }
+            }
+        }
+        else if (command == "Q") {
+            if (human_output()) {
+                std::cout << "Saliendo del simulador...\n";
+            }
+            return false;
+        }
+        else if (!derived().process_extra_command(command, iss)) {
+            std::cout << "Comando no reconocido: " << command << "\n";
+        }
+        
+        derived().flush_output();
+        return true;
+    }
+    
+    void execute_from_file(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << filename << "'\n";
+            return;
+        }
+        
+        if (human_output()) {
+            std::cout << "Ejecutando comandos desde '" << filename << "'...\n\n";
+        }
+        
+        replay(file);
+        
+        if (human_output()) {
+            std::cout << "=== Ejecucion del archivo completada ===\n";
+        }
+        file.close();
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_SIMULATOR_HPP
@@ -0,0 +1,92 @@
+// Selección de archivos de traza del directorio Test.
+#ifndef MEMSIM_TEST_FILES_HPP
+#define MEMSIM_TEST_FILES_HPP
+
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace memsim {
+
+// Mensajes de select_test_file que cada ejecutable conserva con su propia ortografía
+struct FileSelectionTexts {
+    const char* invalid_option;
+    const char* invalid_input;
+};
+
+constexpr FileSelectionTexts DEFAULT_SELECTION_TEXTS = {
+    "Opcion no valida. Usando el primer archivo disponible.\n",
+    "Entrada no valida. Usando el primer archivo disponible.\n"};
+
+// Función para listar archivos en el directorio Test
+inline std::vector<std::string> list_test_files() {
+    std::vector<std::string> files;
+    std::string test_dir = "../../Test";
+    
+    try {
+        if (std::filesystem::exists(test_dir) && std::filesystem::is_directory(test_dir)) {
+            for (const auto& entry : std::filesystem::directory_iterator(test_dir)) {
+                if (entry.is_regular_file()) {
+                    files.push_back(entry.path().filename().string());
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error al acceder al directorio Test: " << e.what() << std::endl;
+    }
+    
+    return files;
+}
+
+// Función para mostrar y seleccionar archivo dinámicamente
+inline std::string select_test_file(const FileSelectionTexts& texts = DEFAULT_SELECTION_TEXTS) {
+    std::vector<std::string> files = list_test_files();
+    
+    if (files.empty()) {
+        std::cout << "No se encontraron archivos en el directorio Test.\n";
+        std::cout << "Ingrese el nombre del archivo manualmente: ";
+        std::string filename;
+        std::getline(std::cin, filename);
+        return filename;
+    }
+    
+    std::cout << "\n=== ARCHIVOS DISPONIBLES EN TEST ===\n";
+    for (size_t i = 0; i < files.size(); i++) {
+        std::cout << (i + 1) << ". " << files[i] << "\n";
+    }
+    std::cout << (files.size() + 1) << ". Introducir nombre manualmente\n";
+    
+    std::cout << "\nSeleccione una opcion (1-" << (files.size() + 1) << "): ";
+    std::string input;
+    std::getline(std::cin, input);
+    
+    try {
+        int choice = std::stoi(input);
+        if (choice >= 1 && choice <= static_cast<int>(files.size())) {
+            std::string selected_file = "../../Test/" + files[choice - 1];
+            std::cout << "Archivo seleccionado: " << files[choice - 1] << "\n";
+            return selected_file;
+        } else if (choice == static_cast<int>(files.size()) + 1) {
+            std::cout << "Ingrese el nombre del archivo: ";
+            std::string filename;
+            std::getline(std::cin, filename);
+            return filename;
+        } else {
+            std::cout << texts.invalid_option;
+            std::string selected_file = "../../Test/" + files[0];
+            std::cout << "Archivo seleccionado: " << files[0] << "\n";
+            return selected_file;
+        }
+    } catch (const std::exception&) {
+        std::cout << texts.invalid_input;
+        std::string selected_file = "../../Test/" + files[0];
+        std::cout << "Archivo seleccionado: " << files[0] << "\n";
+        return selected_file;
+    }
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_TEST_FILES_HPP
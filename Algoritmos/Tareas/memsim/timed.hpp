@@ -0,0 +1,492 @@
+// Simulación por eventos en tiempo simulado: cada comando de la traza llega en su
+// instante (`@t=N`) y un A puede fijar la vida del proceso (`dur=N`), de modo que el
+// planificador emite solo el L correspondiente al vencer. El asignador atiende una
+// solicitud a la vez y cada búsqueda cuesta tiempo simulado según los bloques que
+// examina, así que la latencia de asignación incluye la espera detrás de otras. Con
+// cola de espera, los A sin hueco esperan a que una liberación les haga lugar.
+#ifndef MEMSIM_TIMED_HPP
+#define MEMSIM_TIMED_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "memory_manager.hpp"
+#include "pipeline.hpp"
+#include "wait_queue.hpp"
+
+namespace memsim {
+
+// Cola de prioridad monótona (radix heap): las claves insertadas nunca son menores que
+// la última extraída, como los instantes de una simulación por eventos. Cada elemento
+// vive en el balde del bit más alto en que su clave difiere de la última extraída; al
+// vaciarse el balde 0 se reparte el primer balde no vacío, así que un elemento cambia
+// de balde a lo sumo 64 veces y push/pop cuestan O(1) amortizado. Consultar la mínima
+// no reparte nada (una máscara de baldes ocupados y el mínimo de cada balde), para que
+// después se puedan insertar claves menores que ella. Los baldes conservan su
+// capacidad, de modo que en régimen estable no se pide memoria.
+template <class T>
+class RadixHeap {
+private:
+    std::array<std::vector<std::pair<uint64_t, T>>, 65> buckets;
+    std::array<uint64_t, 65> minimums{}; // clave mínima de cada balde no vacío
+    uint64_t occupied = 0;               // bit b - 1 encendido si el balde b > 0 tiene elementos
+    uint64_t last = 0;                   // última clave extraída
+    size_t count = 0;
+    
+    static size_t bucket_of(uint64_t key, uint64_t last) {
+        return key == last ? 0 : static_cast<size_t>(64 - __builtin_clzll(key ^ last));
+    }
+    
+    void place(uint64_t key, T&& value) {
+        size_t b = bucket_of(key, last);
+        minimums[b] = buckets[b].empty() ? key : std::min(minimums[b], key);
+        buckets[b].emplace_back(key, std::move(value));
+        if (b > 0) {
+            occupied |= 1ull << (b - 1);
+        }
+    }
+    
+    // Deja en el balde 0 los elementos de clave mínima
+    void refill() {
+        if (!buckets[0].empty()) {
+            return;
+        }
+        size_t i = static_cast<size_t>(__builtin_ctzll(occupied)) + 1;
+        occupied &= ~(1ull << (i - 1));
+        last = minimums[i];
+        for (auto& entry : buckets[i]) {
+            place(entry.first, std::move(entry.second));
+        }
+        buckets[i].clear();
+    }
+
+public:
+    bool empty() const {
+        return count == 0;
+    }
+    
+    size_t size() const {
+        return count;
+    }
+    
+    // Requiere key >= la última clave extraída
+    void push(uint64_t key, T value) {
+        place(key, std::move(value));
+        count++;
+    }
+    
+    // Clave mínima sin extraerla; requiere !empty()
+    uint64_t top_key() const {
+        return !buckets[0].empty() ? last : minimums[static_cast<size_t>(__builtin_ctzll(occupied)) + 1];
+    }
+    
+    // Extrae un elemento de clave mínima; entre claves iguales el orden no está definido
+    std::pair<uint64_t, T> pop() {
+        refill();
+        std::pair<uint64_t, T> entry = std::move(buckets[0].back());
+        buckets[0].pop_back();
+        count--;
+        return entry;
+    }
+};
+
+// Comando de una traza con tiempo. Sin `@t=` llega en el instante de la línea anterior;
+// sin `dur=` el proceso vive hasta un L explícito.
+struct TimedRequest {
+    char op;                 // 'A' o 'L'
+    long long time;
+    long long duration = -1;
+    Address size = 0;
+    int line_number = 0;
+    std::string process_name;
+};
+
+// Lee las marcas `@t=N` y `dur=N` que siguen a un comando; false si hay otra palabra
+// o un valor negativo
+inline bool parse_timing(std::string_view rest, long long& time, long long& duration) {
+    for (std::string_view token = next_token(rest); !token.empty(); token = next_token(rest)) {
+        if (token.substr(0, 3) == "@t=") {
+            if (!parse_int(token.substr(3), time) || time < 0) return false;
+        } else if (token.substr(0, 4) == "dur=") {
+            if (!parse_int(token.substr(4), duration) || duration < 0) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Comandos A y L de una traza con tiempo, ordenados por instante (estable: a igual
+// instante se respeta el orden del archivo). `ignored` cuenta las líneas que no son A/L
+// o cuyas marcas de tiempo no se entienden.
+inline std::vector<TimedRequest> load_timed_requests(std::istream& input, long long& ignored) {
+    std::vector<TimedRequest> requests;
+    std::string line;
+    ParsedCommand parsed;
+    int line_number = 0;
+    long long time = 0;
+    ignored = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) {
+            continue;
+        }
+        std::string_view rest(parsed.line);
+        next_token(rest); // comando
+        next_token(rest); // proceso
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            next_token(rest); // tamano
+        }
+        long long duration = -1;
+        if (parsed.kind == ParsedCommand::Kind::OTHER || !parse_timing(rest, time, duration) ||
+            (parsed.kind == ParsedCommand::Kind::RELEASE && duration >= 0)) {
+            ignored++;
+            continue;
+        }
+        requests.push_back({parsed.kind == ParsedCommand::Kind::ALLOCATE ? 'A' : 'L', time, duration, parsed.size,
+                            line_number, parsed.process_name});
+    }
+    std::stable_sort(requests.begin(), requests.end(),
+                     [](const TimedRequest& a, const TimedRequest& b) { return a.time < b.time; });
+    return requests;
+}
+
+// Carga sintética de `count` llegadas: tamanos de 1 a `max_size`, vidas de 1 a 2000
+// unidades de tiempo y llegadas espaciadas para que la demanda viva media ronde el 90%
+// de `memory` (los picos superan la memoria y algunas asignaciones fallan)
+inline std::vector<TimedRequest> synthetic_timed_requests(long long count, int max_size, Address memory,
+                                                          uint64_t seed) {
+    constexpr int MEAN_DURATION = 1000;
+    std::vector<TimedRequest> requests;
+    requests.reserve(static_cast<size_t>(count));
+    XorShift64 rng(seed);
+    // Separación media entre llegadas en 1/65536 de unidad de tiempo
+    double mean_gap = MEAN_DURATION * (1.0 + max_size) / 2.0 / (0.9 * static_cast<double>(memory));
+    uint64_t gap_span = static_cast<uint64_t>(2.0 * mean_gap * 65536.0) + 1;
+    uint64_t clock = 0;
+    for (long long i = 0; i < count; i++) {
+        clock += rng.next() % gap_span;
+        requests.push_back({'A', static_cast<long long>(clock >> 16), 1 + rng.below(2 * MEAN_DURATION),
+                            1 + rng.below(max_size), 0, "P" + std::to_string(i)});
+    }
+    return requests;
+}
+
+// Parámetros de la simulación con tiempo
+struct TimedConfig {
+    long long probe_time = 1; // tiempo simulado por bloque examinado en una búsqueda
+    bool wait = false;        // los A sin hueco esperan en vez de descartarse
+    AdmissionPolicy admission = AdmissionPolicy::FIFO;
+};
+
+// Media, percentiles y máximo de una serie de tiempos simulados
+struct TimeSummary {
+    long long count = 0;
+    double mean = 0.0;
+    long long p50 = 0;
+    long long p99 = 0;
+    long long max = 0;
+};
+
+// Resume `values` (los reordena)
+inline TimeSummary summarize_times(std::vector<long long>& values) {
+    TimeSummary summary;
+    summary.count = static_cast<long long>(values.size());
+    if (values.empty()) {
+        return summary;
+    }
+    long long total = 0;
+    for (long long value : values) {
+        total += value;
+    }
+    summary.mean = static_cast<double>(total) / static_cast<double>(values.size());
+    auto percentile = [&](double fraction) {
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    };
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    summary.max = *std::max_element(values.begin(), values.end());
+    return summary;
+}
+
+// Resultado de una simulación con tiempo
+struct TimedRun {
+    long long arrivals = 0;         // A recibidos
+    long long allocated = 0;        // incluye los admitidos desde la cola de espera
+    long long failed = 0;           // sin hueco suficiente y descartados (sin cola de espera)
+    long long rejected = 0;         // tamano inválido o proceso repetido
+    long long expirations = 0;      // L emitidos por el planificador al vencer dur
+    long long releases = 0;         // L explícitos de la traza
+    long long unknown_releases = 0; // L de procesos que no están vivos ni esperan
+    long long ignored_lines = 0;
+    long long events = 0;           // llegadas, atenciones y vencimientos procesados
+    long long end_time = 0;         // instante del último evento
+    double memory_time = 0.0;       // integral de la memoria ocupada en el tiempo
+    long long peak_used = 0;
+    long long probe_time = 0;
+    TimeSummary latency;            // llegada -> fin de la búsqueda que asignó
+    
+    // Cola de espera (TimedConfig::wait)
+    long long queued = 0;           // A que entraron a la cola
+    long long admitted = 0;         // esperantes asignados tras una liberación
+    long long withdrawn = 0;        // A retirados por un L antes de asignarse
+    long long still_waiting = 0;    // esperantes sin atender al terminar
+    long long oldest_waiting = 0;   // espera del más antiguo de ellos al terminar
+    long long max_queue = 0;
+    long long bypasses = 0;         // admisiones que pasaron por delante del más antiguo
+    double head_blocked_time = 0.0; // tiempo en que el más antiguo no cabe pero otro sí
+    TimeSummary wait;               // entrada a la cola -> admisión
+    double seconds = 0.0;
+    
+    // Fracción media de la memoria ocupada entre el instante 0 y el último evento
+    double mean_occupancy(Address total_memory) const {
+        return end_time > 0 ? memory_time / (static_cast<double>(end_time) * static_cast<double>(total_memory)) : 0.0;
+    }
+    
+    double events_per_second() const {
+        return seconds > 0.0 ? events / seconds : 0.0;
+    }
+};
+
+// Simula `requests` sobre `manager`. Eventos de un mismo instante: primero los
+// vencimientos, luego las llegadas y al final la atención del asignador, de modo que
+// una asignación ve la memoria que se libera en su propio instante. El asignador toma
+// las solicitudes en orden de llegada y cada una lo ocupa `probe_time` por bloque
+// examinado; el proceso vive `dur` a partir del fin de su búsqueda.
+// Con cola de espera, un A sin hueco espera y tras cada liberación la política de
+// admisión elige a quién reintentar mientras alguno quepa en el mayor hueco (los
+// bloques aparcados en listas rápidas no cuentan hasta consolidarse). Con FIFO un A
+// tampoco se adelanta a la cola: si hay esperantes, se forma detrás. Un L de un
+// proceso que todavía espera (al asignador o en la cola) lo retira sin asignarlo.
+// El estado de cada solicitud vive en vectores indexados por su posición en
+// `requests`, así que los eventos no piden memoria.
+template <class Manager>
+TimedRun run_timed_simulation(Manager& manager, const std::vector<TimedRequest>& requests, const TimedConfig& config) {
+    constexpr long long NONE = LLONG_MAX;
+    constexpr char IDLE = 0, PENDING = 1, WAITING = 2, HOLDING = 3;
+    TimedRun run;
+    run.probe_time = config.probe_time;
+    RadixHeap<uint32_t> expirations;        // índice de la solicitud que vence
+    std::vector<char> state(requests.size(), IDLE);
+    std::deque<uint32_t> pending;           // esperan al asignador
+    WaitQueue waiting(config.admission);    // esperan memoria
+    std::vector<long long> waiting_since(config.wait ? requests.size() : 0);
+    std::vector<long long> latencies, waits;
+    latencies.reserve(requests.size());
+    bool explicit_releases = std::any_of(requests.begin(), requests.end(),
+                                         [](const TimedRequest& request) { return request.op == 'L'; });
+    bool fifo = config.wait && config.admission == AdmissionPolicy::FIFO;
+    
+    // Para los L explícitos: número denso de cada nombre, calculado antes de simular, y
+    // por nombre la solicitud que lo ocupa o, si ninguna, la última que espera con él
+    std::vector<uint32_t> name_id;
+    std::vector<uint32_t> by_name;
+    if (explicit_releases) {
+        std::unordered_map<std::string_view, uint32_t> ids;
+        ids.reserve(requests.size());
+        name_id.reserve(requests.size());
+        for (const auto& request : requests) {
+            name_id.push_back(ids.emplace(request.process_name, static_cast<uint32_t>(ids.size())).first->second);
+        }
+        by_name.assign(ids.size(), WaitQueue::NONE);
+    }
+    
+    auto started = std::chrono::steady_clock::now();
+    manager.dispatch([&](auto& placement) {
+        long long now = 0;
+        long long server_free = 0;
+        size_t next = 0;
+        bool head_blocked = false;
+        Address start, size;
+        
+        // La solicitud `index` deja de ocupar o esperar con su nombre
+        auto forget = [&](uint32_t index) {
+            state[index] = IDLE;
+            if (explicit_releases && by_name[name_id[index]] == index) {
+                by_name[name_id[index]] = WaitQueue::NONE;
+            }
+        };
+        
+        auto enqueue = [&](uint32_t index, long long time) {
+            waiting.push(index, manager.get_layout().block_size(requests[index].size));
+            state[index] = WAITING;
+            waiting_since[index] = time;
+            run.queued++;
+            run.max_queue = std::max(run.max_queue, static_cast<long long>(waiting.size()));
+        };
+        
+        // Busca hueco para la solicitud `index` en el instante `time`; devuelve el resultado
+        auto allocate = [&](uint32_t index, long long time) {
+            const TimedRequest& request = requests[index];
+            placement.probes = 0;
+            OpStatus status = manager.try_allocate_with(placement, request.process_name, request.size, start);
+            long long finished = std::max(time, server_free) + static_cast<long long>(placement.probes) * config.probe_time;
+            server_free = finished;
+            if (status == OpStatus::OK) {
+                run.allocated++;
+                run.peak_used = std::max(run.peak_used, manager.get_counters().used_memory);
+                latencies.push_back(finished - request.time);
+                state[index] = HOLDING;
+                if (explicit_releases) {
+                    by_name[name_id[index]] = index;
+                }
+                if (request.duration >= 0) {
+                    expirations.push(static_cast<uint64_t>(finished + request.duration), index);
+                }
+            } else if (status != OpStatus::NO_MEMORY) {
+                run.rejected++;
+            }
+            return status;
+        };
+        
+        // Admite esperantes mientras la política encuentre uno que quepa
+        auto admit = [&](long long time) {
+            for (uint32_t index = waiting.candidate(manager.get_largest_free_block()); index != WaitQueue::NONE;
+                 index = waiting.candidate(manager.get_largest_free_block())) {
+                bool bypass = index != waiting.oldest();
+                waiting.erase(index);
+                OpStatus status = allocate(index, time);
+                if (status == OpStatus::NO_MEMORY) {
+                    waiting.push(index, manager.get_layout().block_size(requests[index].size));
+                    break;
+                }
+                if (status == OpStatus::OK) {
+                    run.admitted++;
+                    run.bypasses += bypass ? 1 : 0;
+                    waits.push_back(time - waiting_since[index]);
+                } else {
+                    forget(index);
+                }
+            }
+        };
+        
+        auto release = [&](uint32_t index, long long time) {
+            manager.try_deallocate(requests[index].process_name, start, size);
+            forget(index);
+            if (config.wait) {
+                admit(time);
+            }
+        };
+        
+        // L de un proceso que aún espera: sale de la cola (lo que puede destrabar a
+        // los de detrás) o de los pendientes del asignador
+        auto withdraw = [&](uint32_t index, long long time) {
+            if (state[index] == WAITING) {
+                waiting.erase(index);
+                forget(index);
+                admit(time);
+            } else {
+                pending.erase(std::find(pending.begin(), pending.end(), index));
+                forget(index);
+            }
+        };
+        
+        while (true) {
+            long long expiry = expirations.empty() ? NONE : static_cast<long long>(expirations.top_key());
+            long long arrival = next < requests.size() ? requests[next].time : NONE;
+            long long service = pending.empty() ? NONE : std::max(requests[pending.front()].time, server_free);
+            long long time = std::min({expiry, arrival, service});
+            if (time == NONE) {
+                break;
+            }
+            run.memory_time += static_cast<double>(manager.get_counters().used_memory) * static_cast<double>(time - now);
+            run.head_blocked_time += head_blocked ? static_cast<double>(time - now) : 0.0;
+            now = time;
+            run.events++;
+            
+            if (expiry == time) {
+                uint32_t index = expirations.pop().second;
+                if (state[index] == HOLDING) {
+                    release(index, time);
+                    run.expirations++;
+                } else {
+                    run.events--; // el proceso ya se liberó con un L explícito
+                }
+            } else if (arrival == time) {
+                const TimedRequest& request = requests[next];
+                uint32_t index = static_cast<uint32_t>(next);
+                if (request.op == 'A') {
+                    pending.push_back(index);
+                    state[index] = PENDING;
+                    if (explicit_releases) {
+                        uint32_t& owner = by_name[name_id[index]];
+                        owner = owner != WaitQueue::NONE && state[owner] == HOLDING ? owner : index;
+                    }
+                    run.arrivals++;
+                } else {
+                    uint32_t owner = by_name[name_id[index]];
+                    if (owner == WaitQueue::NONE) {
+                        run.unknown_releases++;
+                    } else if (state[owner] == HOLDING) {
+                        release(owner, time);
+                        run.releases++;
+                    } else {
+                        withdraw(owner, time);
+                        run.withdrawn++;
+                    }
+                }
+                next++;
+            } else {
+                uint32_t index = pending.front();
+                pending.pop_front();
+                if (fifo && !waiting.empty()) {
+                    enqueue(index, time);
+                } else {
+                    OpStatus status = allocate(index, time);
+                    if (status == OpStatus::NO_MEMORY && config.wait) {
+                        enqueue(index, time);
+                    } else if (status != OpStatus::OK) {
+                        run.failed += status == OpStatus::NO_MEMORY ? 1 : 0;
+                        forget(index);
+                    }
+                }
+            }
+            head_blocked = config.wait && waiting.head_blocked(manager.get_largest_free_block());
+        }
+        run.end_time = now;
+    });
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    
+    run.still_waiting = static_cast<long long>(waiting.size());
+    if (!waiting.empty()) {
+        run.oldest_waiting = run.end_time - waiting_since[waiting.oldest()];
+    }
+    run.latency = summarize_times(latencies);
+    run.wait = summarize_times(waits);
+    return run;
+}
+
+// Mide el planificador solo: 4096 procesos en vuelo; cada vencimiento extraído
+// programa el siguiente entre 1 y 2048 unidades más tarde. Devuelve millones de eventos por segundo.
+inline double measure_event_queue(long long events, uint64_t seed) {
+    constexpr int IN_FLIGHT = 4096;
+    RadixHeap<uint32_t> queue;
+    XorShift64 rng(seed);
+    for (uint32_t i = 0; i < IN_FLIGHT; i++) {
+        queue.push(static_cast<uint64_t>(1 + rng.below(2000)), i);
+    }
+    auto started = std::chrono::steady_clock::now();
+    for (long long i = 0; i < events; i++) {
+        auto [time, id] = queue.pop();
+        queue.push(time + 1 + (rng.next() & 2047), id);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return seconds > 0.0 ? events / seconds / 1e6 : 0.0;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_TIMED_HPP
@@ -0,0 +1,166 @@
+// Perfil de una traza A/L sin simular la colocación: demanda viva, vida de los
+// procesos e histogramas de tamanos. Una sola pasada y memoria O(procesos vivos).
+#ifndef MEMSIM_TRACE_ANALYSIS_HPP
+#define MEMSIM_TRACE_ANALYSIS_HPP
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+#include "pipeline.hpp"
+
+namespace memsim {
+
+// Histograma en potencias de 2: la clase k cuenta los valores en [2^k, 2^(k+1) - 1]
+struct Log2Histogram {
+    static constexpr int CLASSES = 63;
+    std::array<long long, CLASSES> counts{};
+    
+    static int class_of(long long value) {
+        int k = 0;
+        while (k + 1 < CLASSES && (value >> (k + 1)) > 0) {
+            k++;
+        }
+        return k;
+    }
+    
+    static long long class_min(int k) {
+        return 1LL << k;
+    }
+    
+    static long long class_max(int k) {
+        return (1LL << k) + ((1LL << k) - 1);
+    }
+    
+    void add(long long value) {
+        counts[static_cast<size_t>(class_of(value < 1 ? 1 : value))]++;
+    }
+    
+    // Rango de clases con datos: [first, last]; first > last si está vacío
+    int first() const {
+        for (int k = 0; k < CLASSES; k++) if (counts[static_cast<size_t>(k)] > 0) return k;
+        return CLASSES;
+    }
+    
+    int last() const {
+        for (int k = CLASSES - 1; k >= 0; k--) if (counts[static_cast<size_t>(k)] > 0) return k;
+        return -1;
+    }
+};
+
+// Propiedades de la demanda de una traza. Las solicitudes que el simulador rechaza
+// sin mirar la memoria (tamano no positivo, proceso ya vivo, liberar un proceso
+// inexistente) no cuentan como demanda; el resto se supone siempre atendido.
+struct TraceProfile {
+    long long lines = 0;            // líneas con comando (sin vacías ni comentarios)
+    long long allocations = 0;      // A aceptados
+    long long releases = 0;         // L de procesos vivos
+    long long other_commands = 0;
+    long long invalid_sizes = 0;
+    long long duplicates = 0;
+    long long unknown_releases = 0;
+    
+    long long requested_units = 0;
+    Address min_size = 0;
+    Address max_size = 0;
+    
+    long long live_units = 0;       // demanda viva al final de la traza
+    long long live_processes = 0;
+    long long peak_live_units = 0;
+    int peak_live_line = 0;         // línea donde se alcanzó el pico
+    long long peak_live_processes = 0;
+    
+    long long lifetime_total = 0;   // vida en operaciones A/L de los procesos liberados
+    long long max_lifetime = 0;
+    
+    Log2Histogram size_histogram;
+    Log2Histogram lifetime_histogram;
+    
+    // Memoria total mínima para atender toda la traza: el pico de demanda viva. Es una
+    // cota inferior para cualquier algoritmo; la fragmentación puede exigir más.
+    long long min_total_memory() const {
+        return peak_live_units;
+    }
+    
+    double average_size() const {
+        return allocations > 0 ? static_cast<double>(requested_units) / allocations : 0.0;
+    }
+    
+    double average_lifetime() const {
+        return releases > 0 ? static_cast<double>(lifetime_total) / releases : 0.0;
+    }
+};
+
+// Recorre la traza una vez; solo guarda el tamano y el nacimiento de los procesos vivos
+inline TraceProfile analyze_trace(std::istream& input) {
+    struct LiveProcess {
+        Address size;
+        long long born; // número de operación A/L de su asignación
+    };
+    
+    TraceProfile profile;
+    std::unordered_map<std::string, LiveProcess> live;
+    std::string line;
+    ParsedCommand parsed;
+    int line_number = 0;
+    long long operation = 0;
+    
+    while (std::getline(input, line)) {
+        line_number++;
+        if (!parse_trace_line(line, line_number, parsed)) {
+            continue;
+        }
+        profile.lines++;
+        
+        if (parsed.kind == ParsedCommand::Kind::ALLOCATE) {
+            operation++;
+            if (parsed.size <= 0) {
+                profile.invalid_sizes++;
+                continue;
+            }
+            if (!live.emplace(parsed.process_name, LiveProcess{parsed.size, operation}).second) {
+                profile.duplicates++;
+                continue;
+            }
+            
+            profile.allocations++;
+            profile.requested_units += parsed.size;
+            profile.min_size = profile.allocations == 1 ? parsed.size : std::min(profile.min_size, parsed.size);
+            profile.max_size = std::max(profile.max_size, parsed.size);
+            profile.size_histogram.add(parsed.size);
+            
+            profile.live_units += parsed.size;
+            profile.live_processes++;
+            if (profile.live_units > profile.peak_live_units) {
+                profile.peak_live_units = profile.live_units;
+                profile.peak_live_line = line_number;
+            }
+            profile.peak_live_processes = std::max(profile.peak_live_processes, profile.live_processes);
+        } else if (parsed.kind == ParsedCommand::Kind::RELEASE) {
+            operation++;
+            auto it = live.find(parsed.process_name);
+            if (it == live.end()) {
+                profile.unknown_releases++;
+                continue;
+            }
+            
+            long long lifetime = operation - it->second.born;
+            profile.releases++;
+            profile.lifetime_total += lifetime;
+            profile.max_lifetime = std::max(profile.max_lifetime, lifetime);
+            profile.lifetime_histogram.add(lifetime);
+            profile.live_units -= it->second.size;
+            profile.live_processes--;
+            live.erase(it);
+        } else {
+            profile.other_commands++;
+        }
+    }
+    return profile;
+}
+
+} // namespace memsim
+
+#endif // MEMSIM_TRACE_ANALYSIS_HPP
@@ -0,0 +1,110 @@
+// Cola de espera de asignaciones: las solicitudes que no encuentran hueco esperan en
+// vez de descartarse y, tras cada liberación, la política de admisión decide a quién
+// se le vuelve a intentar. Los esperantes se indexan por tamano y por llegada, así que
+// saber si alguno cabe en el mayor hueco cuesta O(log n) y no recorre la cola.
+#ifndef MEMSIM_WAIT_QUEUE_HPP
+#define MEMSIM_WAIT_QUEUE_HPP
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string_view>
+#include <utility>
+
+#include "memory_manager.hpp"
+#include "pool.hpp"
+
+namespace memsim {
+
+// A quién se admite cuando se libera memoria
+enum class AdmissionPolicy {
+    FIFO,           // solo el más antiguo; si no cabe, bloquea a los demás
+    SMALLEST_FIRST, // el de menor tamano (a igual tamano, el más antiguo)
+    BEST_FIT_FIRST  // el de mayor tamano que quepa en el mayor hueco: el que mejor lo llena
+};
+
+constexpr std::array<std::string_view, 3> ADMISSION_NAMES = {"FIFO", "Menor primero", "Mejor ajuste primero"};
+
+constexpr std::string_view admission_name(AdmissionPolicy policy) {
+    return ADMISSION_NAMES[static_cast<size_t>(policy)];
+}
+
+// Esperantes identificados por un número creciente en orden de llegada (`id`) y
+// su tamano de bloque. Los nodos de ambos índices salen de pools.
+class WaitQueue {
+private:
+    using SizeSet = std::set<std::pair<Address, uint32_t>, std::less<std::pair<Address, uint32_t>>,
+                             PoolAllocator<std::pair<Address, uint32_t>>>;
+    using ArrivalMap = std::map<uint32_t, Address, std::less<uint32_t>,
+                                PoolAllocator<std::pair<const uint32_t, Address>>>;
+    
+    SizeSet by_size;       // (tamano, id)
+    ArrivalMap by_arrival; // id -> tamano
+    AdmissionPolicy policy;
+
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
+    explicit WaitQueue(AdmissionPolicy admission = AdmissionPolicy::FIFO) : policy(admission) {}
+    
+    AdmissionPolicy get_policy() const {
+        return policy;
+    }
+    
+    bool empty() const {
+        return by_arrival.empty();
+    }
+    
+    size_t size() const {
+        return by_arrival.size();
+    }
+    
+    // Esperante más antiguo; requiere !empty()
+    uint32_t oldest() const {
+        return by_arrival.begin()->first;
+    }
+    
+    void push(uint32_t id, Address size) {
+        by_size.emplace(size, id);
+        by_arrival.emplace(id, size);
+    }
+    
+    void erase(uint32_t id) {
+        auto it = by_arrival.find(id);
+        by_size.erase({it->second, id});
+        by_arrival.erase(it);
+    }
+    
+    // Esperante que la política admite con `largest` unidades en el mayor hueco, o NONE
+    uint32_t candidate(Address largest) const {
+        if (empty()) {
+            return NONE;
+        }
+        switch (policy) {
+            case AdmissionPolicy::FIFO:
+                return by_arrival.begin()->second <= largest ? by_arrival.begin()->first : NONE;
+            case AdmissionPolicy::SMALLEST_FIRST:
+                return by_size.begin()->first <= largest ? by_size.begin()->second : NONE;
+            case AdmissionPolicy::BEST_FIT_FIRST: {
+                auto it = by_size.upper_bound({largest, NONE});
+                if (it == by_size.begin()) {
+                    return NONE;
+                }
+                // El más antiguo entre los de ese tamano
+                return by_size.lower_bound({std::prev(it)->first, 0})->second;
+            }
+        }
+        return NONE;
+    }
+    
+    // Bloqueo en cabeza: el más antiguo no cabe pero otro esperante sí
+    bool head_blocked(Address largest) const {
+        return !empty() && by_arrival.begin()->second > largest && by_size.begin()->first <= largest;
+    }
+};
+
+} // namespace memsim
+
+#endif // MEMSIM_WAIT_QUEUE_HPP
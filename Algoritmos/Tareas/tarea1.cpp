@@ -1,130 +1,103 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <map>
+#include <string_view>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
-#include <cctype>
-#include <filesystem>
+#include <climits>
 
-namespace fs = std::filesystem;
+#include "memsim/memsim.hpp"
 
-// Estructura para representar un bloque de memoria
-struct MemoryBlock {
-    int start;
-    int size;
-    std::string process_name;
-    bool is_free;
-    
-    MemoryBlock(int s, int sz, std::string name = "", bool free = true) 
-        : start(s), size(sz), process_name(name), is_free(free) {}
-};
+using namespace memsim;
 
-class MemoryManager {
-private:
-    int total_memory;
-    std::vector<MemoryBlock> memory_blocks;
-    std::map<std::string, int> process_locations; // Para rastrear dónde están los procesos
+// Mensaje de texto con el resultado de un comando A o L
+void print_op_message(std::ostream& out, char op, std::string_view process_name, Address size, OpStatus status) {
+    if (op == 'L') {
+        if (status == OpStatus::OK) {
+            out << "Memoria liberada del proceso '" << process_name << "'\n";
+        } else {
+            out << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
+        }
+        return;
+    }
     
+    switch (status) {
+        case OpStatus::OK:
+            out << "Memoria asignada al proceso '" << process_name 
+                << "' - Tamano: " << size << " unidades\n";
+            break;
+        case OpStatus::INVALID_SIZE:
+            out << "Error: El tamano debe ser positivo\n";
+            break;
+        case OpStatus::DUPLICATE:
+            out << "Error: El proceso '" << process_name << "' ya tiene memoria asignada\n";
+            break;
+        default:
+            out << "Error: No hay suficiente memoria contigua disponible para el proceso '" 
+                << process_name << "'\n";
+            break;
+    }
+}
+
+// Mensaje de texto con el resultado de un comando R
+void print_resize_message(std::ostream& out, std::string_view process_name, Address size, OpStatus status,
+                          Address moved) {
+    switch (status) {
+        case OpStatus::OK:
+            out << "Proceso '" << process_name << "' redimensionado - Tamano: " << size << " unidades";
+            if (moved > 0) {
+                out << " (movido, " << moved << " unidades copiadas)\n";
+            } else {
+                out << " (en el lugar)\n";
+            }
+            break;
+        case OpStatus::INVALID_SIZE:
+            out << "Error: El tamano debe ser positivo\n";
+            break;
+        case OpStatus::NOT_FOUND:
+            out << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
+            break;
+        default:
+            out << "Error: No hay suficiente memoria contigua para redimensionar el proceso '" 
+                << process_name << "'\n";
+            break;
+    }
+}
+
+// Gestor de Tarea 1: First Fit fijado en compilación, con la presentación de esta tarea
+class MemoryManager : public BasicMemoryManager<FirstFit> {
 public:
-    MemoryManager(int size = 100) : total_memory(size) {
-        // Inicialmente toda la memoria está libre
-        memory_blocks.push_back(MemoryBlock(0, total_memory, "", true));
+    MemoryManager(Address size = 100) : BasicMemoryManager(size) {}
+    
+    // Mensaje con el resultado de un comando A o L
+    void report(char op, std::string_view process_name, Address size, OpStatus status, Address) {
+        print_op_message(std::cout, op, process_name, size, status);
     }
     
     // Método para asignar memoria (comando A)
-    bool allocate(const std::string& process_name, int size) {
-        if (size <= 0) {
-            std::cout << "Error: El tamano debe ser positivo\n";
-            return false;
-        }
-        
-        if (process_locations.find(process_name) != process_locations.end()) {
-            std::cout << "Error: El proceso '" << process_name << "' ya tiene memoria asignada\n";
-            return false;
-        }
-        
-        // Buscar el primer bloque libre que sea suficientemente grande (First Fit)
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end(); ++it) {
-            if (it->is_free && it->size >= size) {
-                // Encontramos un bloque libre suficientemente grande
-                int start_pos = it->start;
-                int remaining_size = it->size - size;
-                
-                // Crear el bloque ocupado
-                MemoryBlock allocated_block(start_pos, size, process_name, false);
-                
-                // Reemplazar el bloque libre
-                if (remaining_size > 0) {
-                    // Si queda espacio, crear un nuevo bloque libre
-                    it->start = start_pos + size;
-                    it->size = remaining_size;
-                    memory_blocks.insert(it, allocated_block);
-                } else {
-                    // Si no queda espacio, simplemente reemplazar
-                    *it = allocated_block;
-                }
-                
-                process_locations[process_name] = start_pos;
-                std::cout << "Memoria asignada al proceso '" << process_name 
-                         << "' - Tamano: " << size << " unidades\n";
-                return true;
-            }
-        }
-        
-        std::cout << "Error: No hay suficiente memoria contigua disponible para el proceso '" 
-                 << process_name << "'\n";
-        return false;
+    bool allocate(std::string_view process_name, Address size) {
+        Address start;
+        OpStatus status = try_allocate(process_name, size, start);
+        report('A', process_name, size, status, start);
+        return status == OpStatus::OK;
     }
     
     // Método para liberar memoria (comando L)
-    bool deallocate(const std::string& process_name) {
-        auto it = process_locations.find(process_name);
-        if (it == process_locations.end()) {
-            std::cout << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
-            return false;
-        }
-        
-        int process_start = it->second;
-        process_locations.erase(it);
-        
-        // Encontrar y liberar el bloque
-        for (auto& block : memory_blocks) {
-            if (!block.is_free && block.start == process_start && block.process_name == process_name) {
-                block.is_free = true;
-                block.process_name = "";
-                std::cout << "Memoria liberada del proceso '" << process_name << "'\n";
-                
-                // Fusionar bloques libres adyacentes
-                merge_free_blocks();
-                return true;
-            }
-        }
-        
-        return false;
+    bool deallocate(std::string_view process_name) {
+        Address start, size;
+        OpStatus status = try_deallocate(process_name, start, size);
+        report('L', process_name, size, status, start);
+        return status == OpStatus::OK;
     }
     
-    // Método para fusionar bloques libres adyacentes
-    void merge_free_blocks() {
-        // Ordenar bloques por posición de inicio
-        std::sort(memory_blocks.begin(), memory_blocks.end(), 
-                 [](const MemoryBlock& a, const MemoryBlock& b) {
-                     return a.start < b.start;
-                 });
-        
-        // Fusionar bloques libres consecutivos
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end() - 1; ) {
-            if (it->is_free && (it + 1)->is_free && 
-                (it->start + it->size) == (it + 1)->start) {
-                // Fusionar los bloques
-                it->size += (it + 1)->size;
-                memory_blocks.erase(it + 1);
-            } else {
-                ++it;
-            }
-        }
+    // Método para redimensionar un proceso (comando R)
+    bool resize(std::string_view process_name, Address size) {
+        Address start, moved;
+        OpStatus status = try_resize(process_name, size, start, moved);
+        print_resize_message(std::cout, process_name, size, status, moved);
+        return status == OpStatus::OK;
     }
     
     // Método para mostrar el estado de la memoria (comando M)
@@ -133,12 +106,6 @@ public:
         std::cout << "MAPA DE MEMORIA (Total: " << total_memory << " unidades)\n";
         std::cout << std::string(50, '=') << "\n";
         
-        // Ordenar bloques por posición
-        std::sort(memory_blocks.begin(), memory_blocks.end(), 
-                 [](const MemoryBlock& a, const MemoryBlock& b) {
-                     return a.start < b.start;
-                 });
-        
         std::cout << std::left << std::setw(8) << "Inicio" 
                  << std::setw(8) << "Tamano" 
                  << std::setw(12) << "Estado" 
@@ -152,26 +119,11 @@ public:
                      << (block.is_free ? "" : block.process_name) << "\n";
         }
         
-        // Mostrar representación visual
+        // Mostrar representación visual en líneas de 50 caracteres
         std::cout << "\nRepresentacion visual:\n";
-        std::string visual_map(total_memory, '.');
-        
-        for (const auto& block : memory_blocks) {
-            char symbol = block.is_free ? '.' : '#';
-            for (int i = block.start; i < block.start + block.size; ++i) {
-                visual_map[i] = symbol;
-            }
-        }
-        
-        // Mostrar la representación en líneas de 50 caracteres
-        for (int i = 0; i < total_memory; i += 50) {
-            std::cout << std::setw(3) << i << ": ";
-            int end = std::min(i + 50, total_memory);
-            for (int j = i; j < end; ++j) {
-                std::cout << visual_map[j];
-            }
-            std::cout << "\n";
-        }
+        print_visual_map(std::cout, memory_blocks, total_memory, [](const MemoryBlock& block) {
+            return block.is_free ? '.' : '#';
+        });
         
         std::cout << "\nLeyenda: '.' = Libre, '#' = Ocupado\n";
         std::cout << std::string(50, '=') << "\n\n";
@@ -179,13 +131,13 @@ public:
     
     // Mostrar estadísticas de memoria
     void show_statistics() {
-        int free_memory = 0;
-        int used_memory = 0;
+        Address free_memory = 0;
+        Address used_memory = 0;
         int free_blocks = 0;
         int used_blocks = 0;
-        int smallest_free_block = INT_MAX;
-        int largest_free_block = 0;
-        int total_free_fragments = 0;
+        Address smallest_free_block = LLONG_MAX;
+        Address largest_free_block = 0;
+        Address total_free_fragments = 0;
         
         for (const auto& block : memory_blocks) {
             if (block.is_free) {
@@ -206,7 +158,7 @@ public:
         
         // Calcular fragmentación externa
         // Fragmentación externa = suma de bloques libres que son demasiado pequeños para ser útiles
-        int external_fragmentation = 0;
+        Address external_fragmentation = 0;
         int min_useful_size = 10; // Consideramos bloques menores a 10 como fragmentación externa
         
         for (const auto& block : memory_blocks) {
@@ -215,10 +167,9 @@ public:
             }
         }
         
-        // Calcular fragmentación interna
-        // Para First Fit, la fragmentación interna es mínima ya que no hay desperdicio dentro de bloques asignados
-        // Sin embargo, podemos calcular el espacio total fragmentado
-        int internal_fragmentation = 0; // En First Fit básico, no hay fragmentación interna real
+        // Calcular fragmentación interna: lo ocupado que no se pidió (cabeceras, relleno de
+        // alineación y sobrantes entregados). Con el modelo exacto por defecto es 0.
+        Address internal_fragmentation = counters.used_memory - counters.requested_memory;
         
         std::cout << "Estadisticas de memoria:\n";
         std::cout << "- Memoria total: " << total_memory << " unidades\n";
@@ -243,6 +194,12 @@ public:
         }
         
         // Eficiencia del algoritmo
+        if (counters.resizes > 0) {
+            std::cout << "- Redimensiones: " << counters.resizes << " (en el lugar: " 
+                     << counters.resizes - counters.moves << ", con movimiento: " << counters.moves 
+                     << ", unidades copiadas: " << counters.moved_memory << ")\n";
+        }
+        
         double efficiency = (100.0 * used_memory / total_memory);
         std::cout << "- Eficiencia de utilizacion: " << efficiency << "%\n";
         std::cout << "- Nivel de fragmentacion total: " 
@@ -255,9 +212,9 @@ public:
         std::cout << "ANALISIS DE FRAGMENTACION - FIRST FIT\n";
         std::cout << std::string(50, '=') << "\n";
         
-        std::vector<int> free_sizes;
-        int total_free = 0, total_used = 0;
-        int used_memory = 0;
+        std::vector<Address> free_sizes;
+        Address total_free = 0, total_used = 0;
+        Address used_memory = 0;
         
         for (const auto& block : memory_blocks) {
             if (block.is_free) {
@@ -279,9 +236,9 @@ public:
         
         // Clasificación de fragmentos
         int critical_fragments = 0, small_fragments = 0, usable_fragments = 0;
-        int critical_size = 0, small_size = 0, usable_size = 0;
+        Address critical_size = 0, small_size = 0, usable_size = 0;
         
-        for (int size : free_sizes) {
+        for (Address size : free_sizes) {
             if (size <= 5) {
                 critical_fragments++;
                 critical_size += size;
@@ -337,79 +294,23 @@ public:
     }
 };
 
-// Función para listar archivos en el directorio Test
-std::vector<std::string> list_test_files() {
-    std::vector<std::string> files;
-    std::string test_dir = "../../Test";
-    
-    try {
-        if (fs::exists(test_dir) && fs::is_directory(test_dir)) {
-            for (const auto& entry : fs::directory_iterator(test_dir)) {
-                if (entry.is_regular_file()) {
-                    files.push_back(entry.path().filename().string());
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error al acceder al directorio Test: " << e.what() << std::endl;
-    }
-    
-    return files;
-}
-
-// Función para mostrar y seleccionar archivo dinámicamente
-std::string select_test_file() {
-    std::vector<std::string> files = list_test_files();
-    
-    if (files.empty()) {
-        std::cout << "No se encontraron archivos en el directorio Test.\n";
-        std::cout << "Ingrese el nombre del archivo manualmente: ";
-        std::string filename;
-        std::getline(std::cin, filename);
-        return filename;
-    }
-    
-    std::cout << "\n=== ARCHIVOS DISPONIBLES EN TEST ===\n";
-    for (size_t i = 0; i < files.size(); i++) {
-        std::cout << (i + 1) << ". " << files[i] << "\n";
-    }
-    std::cout << (files.size() + 1) << ". Introducir nombre manualmente\n";
+class MemorySimulator : public SimulatorBase<MemorySimulator, MemoryManager> {
+private:
+    friend class SimulatorBase<MemorySimulator, MemoryManager>;
     
-    std::cout << "\nSeleccione una opcion (1-" << (files.size() + 1) << "): ";
-    std::string input;
-    std::getline(std::cin, input);
+    static constexpr ShellTexts TEXTS = {
+        "Seleccionando archivo dinámicamente...\n",
+        "No se seleccionó ningún archivo.\n",
+        {"Opción no válida. Usando el primer archivo disponible.\n",
+         "Entrada no válida. Usando el primer archivo disponible.\n"}};
     
-    try {
-        int choice = std::stoi(input);
-        if (choice >= 1 && choice <= static_cast<int>(files.size())) {
-            std::string selected_file = "../../Test/" + files[choice - 1];
-            std::cout << "Archivo seleccionado: " << files[choice - 1] << "\n";
-            return selected_file;
-        } else if (choice == static_cast<int>(files.size()) + 1) {
-            std::cout << "Ingrese el nombre del archivo: ";
-            std::string filename;
-            std::getline(std::cin, filename);
-            return filename;
-        } else {
-            std::cout << "Opción no válida. Usando el primer archivo disponible.\n";
-            std::string selected_file = "../../Test/" + files[0];
-            std::cout << "Archivo seleccionado: " << files[0] << "\n";
-            return selected_file;
-        }
-    } catch (const std::exception& e) {
-        std::cout << "Entrada no válida. Usando el primer archivo disponible.\n";
-        std::string selected_file = "../../Test/" + files[0];
-        std::cout << "Archivo seleccionado: " << files[0] << "\n";
-        return selected_file;
+    // Resultado de un A/L en la etapa de reporte del pipeline
+    static void report_operation(std::ostream& out, RecordWriter&, const ReportItem& item) {
+        print_op_message(out, item.op, item.process_name, item.size, item.status);
     }
-}
 
-class MemorySimulator {
-private:
-    MemoryManager memory_manager;
-    
 public:
-    MemorySimulator(int memory_size = 100) : memory_manager(memory_size) {}
+    MemorySimulator(Address memory_size = 100) : SimulatorBase(memory_size) {}
     
     void run() {
         std::cout << "=== SIMULADOR DE GESTION DE MEMORIA ===\n\n";
@@ -438,29 +339,22 @@ public:
         std::cout << "Comandos disponibles:\n";
         std::cout << "  A <proceso> <tamano>  - Asignar memoria\n";
         std::cout << "  L <proceso>           - Liberar memoria\n";
+        std::cout << "  R <proceso> <tamano>  - Redimensionar (en el lugar si se puede)\n";
+        std::cout << "  AB <n> <prefijo> <tamano...> - Asignar en lote prefijo1..prefijoN\n";
+        std::cout << "  LB <proceso...>       - Liberar en lote (una sola pasada de fusion)\n";
         std::cout << "  M                     - Mostrar estado de la memoria\n";
         std::cout << "  S                     - Mostrar estadisticas\n";
         std::cout << "  FR                    - Analisis de fragmentacion\n";
         std::cout << "  F [archivo]           - Ejecutar comandos desde archivo (selección dinámica si no se especifica)\n";
         std::cout << "  Q                     - Salir\n\n";
         
-        std::string line;
-        while (true) {
-            std::cout << "shell> ";
-            if (!std::getline(std::cin, line)) {
-                break;
-            }
-            
-            if (!process_command(line)) {
-                break;
-            }
-        }
+        command_loop();
     }
     
     void run_from_file() {
         std::cout << "\n=== MODO ARCHIVO ===\n";
         
-        std::string filename = select_test_file();
+        std::string filename = select_test_file(TEXTS.selection);
         
         if (filename.empty()) {
             std::cout << "No se especifico archivo. Cambiando a modo interactivo.\n";
@@ -478,22 +372,7 @@ public:
         
         std::cout << "Ejecutando comandos desde '" << filename << "'...\n\n";
         
-        std::string line;
-        int line_number = 0;
-        
-        while (std::getline(file, line)) {
-            line_number++;
-            
-            // Ignorar líneas vacías y comentarios
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            
-            std::cout << "[Linea " << line_number << "] " << line << "\n";
-            process_command(line);
-            std::cout << "\n"; // Espacio entre comandos para mejor legibilidad
-        }
-        
+        replay(file);
         file.close();
         std::cout << "=== Ejecucion del archivo completada ===\n";
         
@@ -506,105 +385,13 @@ public:
             run_interactive();
         }
     }
-    
-    bool process_command(const std::string& line) {
-        std::istringstream iss(line);
-        std::string command;
-        iss >> command;
-        
-        if (command.empty()) {
-            return true;
-        }
-        
-        // Convertir a mayúsculas
-        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
-        
-        if (command == "A") {
-            std::string process_name;
-            int size;
-            if (iss >> process_name >> size) {
-                memory_manager.allocate(process_name, size);
-            } else {
-                std::cout << "Uso: A <proceso> <tamano>\n";
-            }
-        }
-        else if (command == "L") {
-            std::string process_name;
-            if (iss >> process_name) {
-                memory_manager.deallocate(process_name);
-            } else {
-                std::cout << "Uso: L <proceso>\n";
-            }
-        }
-        else if (command == "M") {
-            memory_manager.show_memory();
-        }
-        else if (command == "S") {
-            memory_manager.show_statistics();
-        }
-        else if (command == "FR") {
-            memory_manager.analyze_fragmentation();
-        }
-        else if (command == "F") {
-            std::string filename;
-            if (iss >> filename) {
-                execute_from_file(filename);
-            } else {
-                // Si no se proporciona archivo, usar selección dinámica
-                std::cout << "Seleccionando archivo dinámicamente...\n";
-                std::string selected_file = select_test_file();
-                if (!selected_file.empty()) {
-                    execute_from_file(selected_file);
-                } else {
-                    std::cout << "No se seleccionó ningún archivo.\n";
-                }
-            }
-        }
-        else if (command == "Q") {
-            std::cout << "Saliendo del simulador...\n";
-            return false;
-        }
-        else {
-            std::cout << "Comando no reconocido: " << command << "\n";
-        }
-        
-        return true;
-    }
-    
-    void execute_from_file(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cout << "Error: No se pudo abrir el archivo '" << filename << "'\n";
-            return;
-        }
-        
-        std::string line;
-        int line_number = 0;
-        std::cout << "Ejecutando comandos desde '" << filename << "'...\n\n";
-        
-        while (std::getline(file, line)) {
-            line_number++;
-            
-            // Ignorar líneas vacías y comentarios
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            
-            std::cout << "[Linea " << line_number << "] " << line << "\n";
-            process_command(line);
-            std::cout << "\n"; // Espacio para mejor legibilidad
-        }
-        
-        std::cout << "=== Ejecucion del archivo completada ===\n";
-        file.close();
-    }
 };
 
 int main() {
     std::cout << "=== SIMULADOR DE GESTION DE MEMORIA ===\n";
     std::cout << "Configuracion inicial\n\n";
     
-    int memory_size;
+    Address memory_size;
     std::cout << "Ingrese el tamano total de memoria (minimo 100): ";
     std::cin >> memory_size;
     std::cin.ignore(); // Limpiar el buffer
@@ -613,6 +400,10 @@ int main() {
         std::cout << "Tamano minimo es 100. Usando 100 unidades.\n";
         memory_size = 100;
     }
+    if (memory_size > MAX_TOTAL_MEMORY) {
+        std::cout << "Tamano maximo es " << MAX_TOTAL_MEMORY << ". Usando " << MAX_TOTAL_MEMORY << " unidades.\n";
+        memory_size = MAX_TOTAL_MEMORY;
+    }
     
     std::cout << "Memoria configurada: " << memory_size << " unidades\n\n";
     
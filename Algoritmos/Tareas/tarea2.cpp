@@ -7,222 +7,941 @@
 #include <iomanip>
 #include <algorithm>
 #include <cctype>
+#include <climits>
 #include <filesystem>
+#include <array>
+#include <string_view>
+#include <thread>
+#include <memory>
+#include <cmath>
+#include <csignal>
+
+#include "memsim/memsim.hpp"
+#include "memsim/alloc_counter.hpp"
 
 namespace fs = std::filesystem;
+using namespace memsim;
 
-// Enumeración para los algoritmos de asignación
-enum class AllocationAlgorithm {
-    FIRST_FIT,
-    BEST_FIT,
-    WORST_FIT
-};
+// Columnas de cada tipo de registro estructurado
+constexpr std::array<std::string_view, 3> MEMORY_COLUMNS = {"total", "algorithm", "blocks"};
+constexpr std::array<std::string_view, 4> BLOCK_COLUMNS = {"start", "size", "state", "process"};
+constexpr std::array<std::string_view, 12> STATS_COLUMNS = {
+    "algorithm", "total", "free", "used", "free_blocks", "used_blocks",
+    "external_fragmentation", "internal_fragmentation", "smallest_free", "largest_free",
+    "efficiency", "fragmentation_level"};
+constexpr std::array<std::string_view, 5> HISTOGRAM_COLUMNS = {"bucket", "min", "max", "blocks", "units"};
+constexpr std::array<std::string_view, 12> QUICK_COLUMNS = {
+    "max_size", "depth", "hits", "misses", "hit_rate", "cached_blocks", "cached_memory", "flushes",
+    "flushed_blocks", "free_blocks", "free_blocks_consolidated", "largest_free_consolidated"};
+constexpr std::array<std::string_view, 9> ADAPTIVE_COLUMNS = {
+    "active", "requests", "windows", "switches", "large_requests", "cost_first", "cost_best", "cost_worst",
+    "last_switch"};
+constexpr std::array<std::string_view, 8> ADAPTIVE_SWITCH_COLUMNS = {
+    "request", "from", "to", "probes", "failure_rate", "fragmentation", "exploring", "index"};
+constexpr std::array<std::string_view, 12> ADAPTIVE_EVAL_COLUMNS = {
+    "scenario", "memory", "operations", "algorithm", "searches", "failures", "probes_per_search",
+    "mean_fragmentation", "final_fragmentation", "cost", "seconds", "switches"};
+constexpr std::array<std::string_view, 6> OP_COLUMNS = {"op", "process", "size", "status", "start", "algorithm"};
+constexpr std::array<std::string_view, 19> TRACE_COLUMNS = {
+    "file", "lines", "allocations", "releases", "other_commands", "invalid_sizes", "duplicates",
+    "unknown_releases", "min_size", "max_size", "average_size", "peak_live_units", "peak_live_line",
+    "peak_live_processes", "live_units", "live_processes", "average_lifetime", "max_lifetime",
+    "min_total_memory"};
+constexpr std::array<std::string_view, 4> TRACE_HISTOGRAM_COLUMNS = {"kind", "min", "max", "count"};
+constexpr std::array<std::string_view, 10> ORACLE_COLUMNS = {
+    "file", "operations", "intervals", "lower_bound", "offline_memory", "colouring_memory", "best_fit_memory",
+    "upper_bound", "oracle_seconds", "online_seconds"};
+constexpr std::array<std::string_view, 5> ORACLE_ALGORITHM_COLUMNS = {
+    "algorithm", "min_memory", "over_lower_bound", "over_oracle", "simulations"};
+constexpr std::array<std::string_view, 21> PAGING_COLUMNS = {
+    "source", "policy", "page_size", "frames", "tlb_entries", "tlb_ways", "processes", "releases", "rejected",
+    "accesses", "invalid_accesses", "tlb_hits", "tlb_misses", "page_faults", "evictions", "tlb_hit_rate",
+    "fault_rate", "cycles", "cycles_per_access", "seconds", "check"};
+constexpr std::array<std::string_view, 33> TIMED_COLUMNS = {
+    "source", "algorithm", "memory", "probe_time", "arrivals", "allocated", "failed", "rejected", "expirations",
+    "releases", "unknown_releases", "withdrawn", "events", "end_time", "latency_mean", "latency_p50", "latency_p99",
+    "latency_max", "memory_time", "mean_occupancy", "peak_used", "admission", "queued", "admitted", "still_waiting",
+    "max_queue", "bypasses", "wait_mean", "wait_p99", "wait_max", "head_blocked_time", "events_per_second", "check"};
+constexpr std::array<std::string_view, 13> BRANCH_COLUMNS = {
+    "source", "branch", "current", "algorithm", "memory", "used", "free", "free_blocks", "largest_free",
+    "processes", "failed", "operations", "check"};
+constexpr std::array<std::string_view, 14> BRANCH_CHECK_COLUMNS = {
+    "algorithm", "memory", "warm_operations", "warm_blocks", "branches", "operations_per_branch", "compared",
+    "fork_nodes", "nodes_per_operation", "fork_us", "copy_us", "live_nodes", "live_nodes_after_drop", "check"};
 
-// Estructura para representar un bloque de memoria
-struct MemoryBlock {
-    int start;
-    int size;
-    std::string process_name;
-    bool is_free;
+// Mensaje de texto con el resultado de un comando A o L
+void print_op_message(std::ostream& out, char op, std::string_view process_name, Address size,
+                      OpStatus status, AllocationAlgorithm algorithm) {
+    if (op == 'L') {
+        if (status == OpStatus::OK) {
+            out << "Memoria liberada del proceso '" << process_name << "'\n";
+        } else {
+            out << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
+        }
+        return;
+    }
     
-    MemoryBlock(int s, int sz, std::string name = "", bool free = true) 
-        : start(s), size(sz), process_name(name), is_free(free) {}
-};
+    switch (status) {
+        case OpStatus::OK:
+            out << "Memoria asignada al proceso '" << process_name 
+                << "' - Tamano: " << size << " unidades (Algoritmo: " 
+                << algorithm_display_name(algorithm) << ")\n";
+            break;
+        case OpStatus::INVALID_SIZE:
+            out << "Error: El tamano debe ser positivo\n";
+            break;
+        case OpStatus::DUPLICATE:
+            out << "Error: El proceso '" << process_name << "' ya tiene memoria asignada\n";
+            break;
+        default:
+            out << "Error: No hay suficiente memoria contigua disponible para el proceso '" 
+                << process_name << "'\n";
+            break;
+    }
+}
 
-class MemoryManager {
-private:
-    int total_memory;
-    std::vector<MemoryBlock> memory_blocks;
-    std::map<std::string, int> process_locations;
-    AllocationAlgorithm algorithm;
-    
-    // Algoritmo First Fit
-    bool allocate_first_fit(const std::string& process_name, int size) {
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end(); ++it) {
-            if (it->is_free && it->size >= size) {
-                allocate_block(it, process_name, size);
-                return true;
+// Mensaje de texto con el resultado de un comando R
+void print_resize_message(std::ostream& out, std::string_view process_name, Address size, OpStatus status,
+                          Address moved, AllocationAlgorithm algorithm) {
+    switch (status) {
+        case OpStatus::OK:
+            out << "Proceso '" << process_name << "' redimensionado - Tamano: " << size << " unidades";
+            if (moved > 0) {
+                out << " (movido con " << algorithm_display_name(algorithm) << ", " << moved 
+                    << " unidades copiadas)\n";
+            } else {
+                out << " (en el lugar)\n";
+            }
+            break;
+        case OpStatus::INVALID_SIZE:
+            out << "Error: El tamano debe ser positivo\n";
+            break;
+        case OpStatus::NOT_FOUND:
+            out << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
+            break;
+        default:
+            out << "Error: No hay suficiente memoria contigua para redimensionar el proceso '" 
+                << process_name << "'\n";
+            break;
+    }
+}
+
+// Registro estructurado con el resultado de un comando A, L o R
+void emit_op_record(RecordWriter& records, char op, std::string_view process_name, Address size,
+                    OpStatus status, Address start, AllocationAlgorithm algorithm) {
+    records.begin("op", OP_COLUMNS);
+    records.field("op", std::string_view(&op, 1));
+    records.field("process", process_name);
+    records.field("size", size);
+    records.field("status", op_status_name(status));
+    records.field("start", start);
+    records.field("algorithm", algorithm_display_name(algorithm));
+    records.end();
+}
+
+// Histograma en potencias de 2 como texto: una fila por clase con su porcentaje
+void print_log2_histogram(const Log2Histogram& histogram, long long total) {
+    for (int k = histogram.first(); k <= histogram.last(); k++) {
+        long long count = histogram.counts[static_cast<size_t>(k)];
+        double percent = total > 0 ? 100.0 * count / total : 0.0;
+        std::cout << "  " << std::right << std::setw(10) << Log2Histogram::class_min(k) << " - "
+                 << std::left << std::setw(10) << Log2Histogram::class_max(k) << ":" << std::right
+                 << std::setw(9) << count << std::setw(8) << std::fixed << std::setprecision(1) << percent
+                 << "%  " << std::string(static_cast<size_t>(percent / 2.5), '#') << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::left;
+    }
+}
+
+// Perfil de una traza (comando ANALYZE y opción --analyze) en texto o como registros
+void show_trace_profile(RecordWriter& records, const std::string& filename, const TraceProfile& profile) {
+    if (records.get_format() != OutputFormat::TEXT) {
+        records.begin("trace", TRACE_COLUMNS);
+        records.field("file", filename);
+        records.field("lines", profile.lines);
+        records.field("allocations", profile.allocations);
+        records.field("releases", profile.releases);
+        records.field("other_commands", profile.other_commands);
+        records.field("invalid_sizes", profile.invalid_sizes);
+        records.field("duplicates", profile.duplicates);
+        records.field("unknown_releases", profile.unknown_releases);
+        records.field("min_size", profile.min_size);
+        records.field("max_size", profile.max_size);
+        records.field("average_size", profile.average_size());
+        records.field("peak_live_units", profile.peak_live_units);
+        records.field("peak_live_line", profile.peak_live_line);
+        records.field("peak_live_processes", profile.peak_live_processes);
+        records.field("live_units", profile.live_units);
+        records.field("live_processes", profile.live_processes);
+        records.field("average_lifetime", profile.average_lifetime());
+        records.field("max_lifetime", profile.max_lifetime);
+        records.field("min_total_memory", profile.min_total_memory());
+        records.end();
+        
+        const std::pair<std::string_view, const Log2Histogram*> histograms[] = {
+            {"size", &profile.size_histogram}, {"lifetime", &profile.lifetime_histogram}};
+        for (const auto& [kind, histogram] : histograms) {
+            for (int k = histogram->first(); k <= histogram->last(); k++) {
+                records.begin("trace_histogram", TRACE_HISTOGRAM_COLUMNS);
+                records.field("kind", kind);
+                records.field("min", Log2Histogram::class_min(k));
+                records.field("max", Log2Histogram::class_max(k));
+                records.field("count", histogram->counts[static_cast<size_t>(k)]);
+                records.end();
             }
         }
+        records.flush();
+        return;
+    }
+    
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "PERFIL DE LA TRAZA: " << filename << "\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "Comandos analizados: " << profile.lines << " (A: " << profile.allocations 
+             << ", L: " << profile.releases << ", otros: " << profile.other_commands << ")\n";
+    if (profile.invalid_sizes + profile.duplicates + profile.unknown_releases > 0) {
+        std::cout << "Rechazados sin simular: " << profile.invalid_sizes << " tamanos invalidos, " 
+                 << profile.duplicates << " procesos duplicados, " << profile.unknown_releases 
+                 << " liberaciones sin proceso\n";
+    }
+    
+    std::cout << "\nDemanda:\n";
+    std::cout << "- Tamano de las solicitudes: min " << profile.min_size << ", max " << profile.max_size 
+             << ", promedio " << std::fixed << std::setprecision(2) << profile.average_size() << " unidades\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "- Pico de memoria viva: " << profile.peak_live_units << " unidades (linea " 
+             << profile.peak_live_line << ")\n";
+    std::cout << "- Maximo de procesos vivos simultaneos: " << profile.peak_live_processes << "\n";
+    std::cout << "- Procesos sin liberar al final: " << profile.live_processes << " (" 
+             << profile.live_units << " unidades)\n";
+    std::cout << "- Vida de los procesos liberados: promedio " << std::fixed << std::setprecision(2) 
+             << profile.average_lifetime() << ", max " << profile.max_lifetime << " operaciones A/L\n";
+    std::cout.unsetf(std::ios::floatfield);
+    
+    std::cout << "\nMemoria total minima (cota inferior): " << profile.min_total_memory() << " unidades\n";
+    std::cout << "  Con menos memoria ningun algoritmo atiende la traza completa; la fragmentacion\n";
+    std::cout << "  puede exigir mas, asi que conviene simular tamanos desde esta cota hacia arriba.\n";
+    
+    std::cout << "\nHistograma de tamanos (unidades):\n";
+    print_log2_histogram(profile.size_histogram, profile.allocations);
+    std::cout << "\nHistograma de vida (operaciones A/L):\n";
+    print_log2_histogram(profile.lifetime_histogram, profile.releases);
+    std::cout << std::string(60, '=') << "\n";
+}
+
+// Analiza el archivo de traza sin simular; devuelve false si no se pudo abrir
+bool analyze_trace_file(RecordWriter& records, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cout << "Error: No se pudo abrir el archivo '" << filename << "'\n";
         return false;
     }
+    show_trace_profile(records, filename, analyze_trace(file));
+    return true;
+}
+
+// Comparación del oráculo offline con los algoritmos en línea (opción --oracle)
+void show_oracle_report(RecordWriter& records, const std::string& filename, const OracleReport& report) {
+    // Exceso relativo de `memory` sobre `reference`; -1 si no hay dato
+    auto excess = [](long long memory, long long reference) {
+        return memory < 0 || reference <= 0 ? -1.0 : 100.0 * (memory - reference) / reference;
+    };
+    auto excess_text = [](double percent) {
+        std::ostringstream text;
+        text << "+" << std::fixed << std::setprecision(1) << percent << "%";
+        return text.str();
+    };
     
-    // Algoritmo Best Fit - encuentra el bloque libre más pequeño que quepa
-    bool allocate_best_fit(const std::string& process_name, int size) {
-        auto best_it = memory_blocks.end();
-        int best_size = INT_MAX;
-        
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end(); ++it) {
-            if (it->is_free && it->size >= size && it->size < best_size) {
-                best_it = it;
-                best_size = it->size;
-            }
+    if (records.get_format() != OutputFormat::TEXT) {
+        records.begin("oracle", ORACLE_COLUMNS);
+        records.field("file", filename);
+        records.field("operations", static_cast<long long>(report.operations));
+        records.field("intervals", static_cast<long long>(report.intervals));
+        records.field("lower_bound", report.lower_bound);
+        records.field("offline_memory", report.offline_memory);
+        records.field("colouring_memory", report.colouring_memory);
+        records.field("best_fit_memory", report.best_fit_memory);
+        records.field("upper_bound", report.upper_bound());
+        records.field("oracle_seconds", report.oracle_seconds);
+        records.field("online_seconds", report.online_seconds);
+        records.end();
+        for (const auto& online : report.online) {
+            records.begin("oracle_algorithm", ORACLE_ALGORITHM_COLUMNS);
+            records.field("algorithm", algorithm_display_name(online.algorithm));
+            records.field("min_memory", online.min_memory);
+            records.field("over_lower_bound", excess(online.min_memory, report.lower_bound));
+            records.field("over_oracle", excess(online.min_memory, report.upper_bound()));
+            records.field("simulations", online.simulations);
+            records.end();
         }
-        
-        if (best_it != memory_blocks.end()) {
-            allocate_block(best_it, process_name, size);
-            return true;
+        records.flush();
+        return;
+    }
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "ORACULO DE COLOCACION OFFLINE: " << filename << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Operaciones A/L: " << report.operations << " | Procesos (intervalos): " << report.intervals << "\n";
+    std::cout << "Cota inferior (pico de memoria viva): " << report.lower_bound << " unidades\n";
+    std::cout << "Colocacion offline (mayor primero, con la vida de cada proceso): ";
+    if (report.offline_memory < 0) {
+        std::cout << "omitida, mas de " << OFFLINE_PAIR_LIMIT << " pares de procesos conviven\n";
+    } else {
+        std::cout << report.offline_memory << " unidades\n";
+    }
+    std::cout << "Coloreo por clases de tamano (sin mirar el futuro): " << report.colouring_memory << " unidades\n";
+    std::cout << "Best Fit sin limite de memoria (sin mirar el futuro): " << report.best_fit_memory << " unidades\n";
+    std::cout << "Optimo entre la cota inferior y la mejor colocacion conocida: " << report.lower_bound << " - " << report.upper_bound() << " unidades\n";
+    
+    std::cout << "\n" << std::left << std::setw(12) << "Algoritmo" << std::setw(18) << "Memoria minima"
+             << std::setw(18) << "Sobre cota inf." << std::setw(16) << "Sobre oraculo" << "Simulaciones\n";
+    std::cout << std::string(78, '-') << "\n";
+    for (const auto& online : report.online) {
+        std::cout << std::setw(12) << algorithm_display_name(online.algorithm);
+        if (online.min_memory < 0) {
+            std::cout << std::setw(52) << ("sin solucion hasta " + std::to_string(MAX_TOTAL_MEMORY) + " (2^62)");
+        } else {
+            std::cout << std::setw(18) << online.min_memory
+                     << std::setw(18) << excess_text(excess(online.min_memory, report.lower_bound))
+                     << std::setw(16) << excess_text(excess(online.min_memory, report.upper_bound()));
         }
-        return false;
+        std::cout << online.simulations << "\n";
     }
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Tiempo: oraculo " << std::fixed << std::setprecision(3) << report.oracle_seconds 
+             << " s, simulaciones en linea " << report.online_seconds << " s\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "Memoria minima: First Fit es exacta (tope con memoria de sobra); el resto por\n";
+    std::cout << "busqueda binaria suponiendo que mas memoria no agrega fallos; como Best, Worst y\n";
+    std::cout << "Next Fit no siempre lo cumplen, su valor es una memoria sin fallos cuya menor falla.\n";
+}
+
+// Escenario de --adaptive-eval: una carga A/L y la memoria en que se reproduce
+struct AdaptiveScenario {
+    std::string name;
+    Address memory;
+    std::vector<ReplayOp> ops;
+};
+
+// Compara el algoritmo adaptativo con cada política fija en cada escenario (opción
+// --adaptive-eval). El costo es el que el adaptativo minimiza: sondas por búsqueda,
+// más 256 por fallo y 32 por la fragmentación externa media.
+void show_adaptive_evaluation(RecordWriter& records, const std::vector<AdaptiveScenario>& scenarios) {
+    constexpr size_t FIXED = static_cast<size_t>(AllocationAlgorithm::ADAPTIVE);
+    bool text = records.get_format() == OutputFormat::TEXT;
+    int best_or_tied = 0;        // escenarios donde el adaptativo iguala o mejora a las cinco fijas
+    int beats_candidates = 0;    // ... a First, Best y Worst Fit, las que alterna
+    double ratio_sum = 0.0;      // costo del adaptativo / mejor fija
     
-    // Algoritmo Worst Fit - encuentra el bloque libre más grande
-    bool allocate_worst_fit(const std::string& process_name, int size) {
-        auto worst_it = memory_blocks.end();
-        int worst_size = -1;
-        
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end(); ++it) {
-            if (it->is_free && it->size >= size && it->size > worst_size) {
-                worst_it = it;
-                worst_size = it->size;
+    if (text) {
+        std::cout << "\n" << std::string(78, '=') << "\n";
+        std::cout << "EVALUACION DEL ALGORITMO ADAPTATIVO - " << scenarios.size() << " escenarios\n";
+        std::cout << "Costo = sondas/busqueda + " << AdaptiveFit::FAILURE_COST << " x tasa de fallos + "
+                 << AdaptiveFit::FRAGMENTATION_COST << " x fragmentacion externa media\n";
+    }
+    for (const auto& scenario : scenarios) {
+        std::vector<PolicyScore> scores = evaluate_policies<SizeOrderedIndex>(scenario.memory, scenario.ops);
+        size_t best = 0;
+        for (size_t i = 1; i < FIXED; i++) {
+            if (scores[i].cost() < scores[best].cost()) {
+                best = i;
             }
         }
+        const PolicyScore& adaptive = scores[FIXED];
+        double best_cost = scores[best].cost();
+        double candidates_cost = std::min({scores[0].cost(), scores[1].cost(), scores[2].cost()});
+        best_or_tied += adaptive.cost() <= best_cost ? 1 : 0;
+        beats_candidates += adaptive.cost() <= candidates_cost ? 1 : 0;
+        ratio_sum += best_cost > 0.0 ? adaptive.cost() / best_cost : 1.0;
+        
+        if (!text) {
+            for (const auto& score : scores) {
+                records.begin("adaptive_eval", ADAPTIVE_EVAL_COLUMNS);
+                records.field("scenario", scenario.name);
+                records.field("memory", scenario.memory);
+                records.field("operations", static_cast<long long>(scenario.ops.size()));
+                records.field("algorithm", algorithm_display_name(score.algorithm));
+                records.field("searches", score.searches);
+                records.field("failures", score.failures);
+                records.field("probes_per_search", score.probes_per_search());
+                records.field("mean_fragmentation", score.mean_fragmentation);
+                records.field("final_fragmentation", score.final_fragmentation);
+                records.field("cost", score.cost());
+                records.field("seconds", score.seconds);
+                records.field("switches", static_cast<long long>(score.switches));
+                records.end();
+            }
+            continue;
+        }
         
-        if (worst_it != memory_blocks.end()) {
-            allocate_block(worst_it, process_name, size);
-            return true;
+        std::cout << "\n" << scenario.name << " | Memoria: " << scenario.memory << " | Operaciones A/L: "
+                 << scenario.ops.size() << "\n";
+        std::cout << std::left << std::setw(12) << "Algoritmo" << std::right << std::setw(10) << "Busquedas"
+                 << std::setw(9) << "Fallos" << std::setw(14) << "Sondas/busq." << std::setw(11) << "Frag. med."
+                 << std::setw(11) << "Frag. fin" << std::setw(10) << "Costo" << std::setw(10) << "ms" << "\n";
+        std::cout << std::string(78, '-') << "\n";
+        std::cout << std::fixed;
+        for (const auto& score : scores) {
+            std::cout << std::left << std::setw(12) << algorithm_display_name(score.algorithm) << std::right
+                     << std::setw(10) << score.searches << std::setw(9) << score.failures << std::setprecision(2)
+                     << std::setw(14) << score.probes_per_search() << std::setprecision(1) << std::setw(10)
+                     << 100.0 * score.mean_fragmentation << "%" << std::setw(10) << 100.0 * score.final_fragmentation
+                     << "%" << std::setprecision(2) << std::setw(10) << score.cost() << std::setprecision(1)
+                     << std::setw(10) << score.seconds * 1e3 << "\n";
         }
-        return false;
+        std::cout << "Adaptativo: " << adaptive.switches << " cambios de politica; mejor fija "
+                 << algorithm_display_name(scores[best].algorithm) << " (costo " << std::setprecision(2) << best_cost
+                 << "), adaptativo/mejor fija " << (best_cost > 0.0 ? adaptive.cost() / best_cost : 1.0) << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    if (!text) {
+        records.flush();
+        return;
     }
     
-    // Función auxiliar para realizar la asignación en el bloque seleccionado
-    void allocate_block(std::vector<MemoryBlock>::iterator it, const std::string& process_name, int size) {
-        int start_pos = it->start;
-        int remaining_size = it->size - size;
-        
-        // Crear el bloque ocupado
-        MemoryBlock allocated_block(start_pos, size, process_name, false);
-        
-        // Reemplazar el bloque libre
-        if (remaining_size > 0) {
-            // Si queda espacio, crear un nuevo bloque libre
-            it->start = start_pos + size;
-            it->size = remaining_size;
-            memory_blocks.insert(it, allocated_block);
-        } else {
-            // Si no queda espacio, simplemente reemplazar
-            *it = allocated_block;
-        }
-        
-        process_locations[process_name] = start_pos;
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "Adaptativo igual o mejor que las cinco fijas: " << best_or_tied << " de " << scenarios.size()
+             << " escenarios; que First, Best y Worst Fit: " << beats_candidates << " de " << scenarios.size() << "\n";
+    std::cout << "Costo medio relativo a la mejor fija de cada escenario: " << std::fixed << std::setprecision(3)
+             << (scenarios.empty() ? 0.0 : ratio_sum / static_cast<double>(scenarios.size())) << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::string(78, '=') << "\n";
+}
+
+// Resultado del modo paginado (opción --paging) en texto o como registro. Verifica la
+// memoria paginada al final; devuelve false si la verificación falla.
+bool show_paging_report(RecordWriter& records, const std::string& source, const PagedMemory& memory,
+                        const PagingRun& run) {
+    const PagingConfig& config = memory.get_config();
+    const PagingStats& stats = memory.get_stats();
+    std::string problem;
+    bool ok = memory.check_invariants(problem);
+    double per_second = run.seconds > 0.0 ? (stats.accesses + stats.invalid_accesses) / run.seconds : 0.0;
+    
+    if (records.get_format() != OutputFormat::TEXT) {
+        records.begin("paging", PAGING_COLUMNS);
+        records.field("source", source);
+        records.field("policy", replacement_name(config.policy));
+        records.field("page_size", config.page_size);
+        records.field("frames", config.frames);
+        records.field("tlb_entries", config.tlb_entries);
+        records.field("tlb_ways", config.tlb_ways);
+        records.field("processes", stats.processes);
+        records.field("releases", stats.releases);
+        records.field("rejected", run.rejected);
+        records.field("accesses", stats.accesses);
+        records.field("invalid_accesses", stats.invalid_accesses);
+        records.field("tlb_hits", stats.tlb_hits);
+        records.field("tlb_misses", stats.tlb_misses);
+        records.field("page_faults", stats.page_faults);
+        records.field("evictions", stats.evictions);
+        records.field("tlb_hit_rate", stats.tlb_hit_rate());
+        records.field("fault_rate", stats.fault_rate());
+        records.field("cycles", stats.cycles);
+        records.field("cycles_per_access", stats.cycles_per_access());
+        records.field("seconds", run.seconds);
+        records.field("check", ok);
+        records.end();
+        records.flush();
+        return ok;
     }
     
-public:
-    MemoryManager(int size = 100, AllocationAlgorithm alg = AllocationAlgorithm::FIRST_FIT) 
-        : total_memory(size), algorithm(alg) {
-        // Inicialmente toda la memoria está libre
-        memory_blocks.push_back(MemoryBlock(0, total_memory, "", true));
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "MEMORIA VIRTUAL PAGINADA: " << source << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Pagina: " << config.page_size << " unidades | Marcos: " << config.frames << " ("
+             << static_cast<long long>(config.frames) * config.page_size << " unidades) | TLB: "
+             << config.tlb_entries << " entradas, " << config.tlb_ways << " vias | Reemplazo: "
+             << replacement_name(config.policy) << "\n";
+    std::cout << "Procesos: creados " << stats.processes << ", liberados " << stats.releases << ", rechazados "
+             << run.rejected << " | Paginas residentes: " << memory.resident_pages() << "\n";
+    if (run.other_commands > 0) {
+        std::cout << "Comandos ignorados (ni A, ni L, ni T): " << run.other_commands << "\n";
     }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Accesos: " << stats.accesses << " (invalidos: " << stats.invalid_accesses << ")\n";
+    std::cout << "- Aciertos de TLB: " << stats.tlb_hits << " (" << stats.tlb_hit_rate() << "%)\n";
+    std::cout << "- Fallos de TLB: " << stats.tlb_misses << " (con la pagina residente: "
+             << stats.tlb_misses - stats.page_faults << ")\n";
+    std::cout << "- Fallos de pagina: " << stats.page_faults << " (" << stats.fault_rate() << "%), reemplazos: "
+             << stats.evictions << "\n";
+    std::cout << "Ciclos simulados: " << stats.cycles << " (" << stats.cycles_per_access() << " por acceso; TLB "
+             << config.costs.tlb_hit << ", tabla " << config.costs.page_walk << ", fallo "
+             << config.costs.page_fault << ")\n";
+    std::cout << "Tiempo: " << std::setprecision(3) << run.seconds << " s (" << std::setprecision(1)
+             << per_second / 1e6 << " millones de accesos/s)\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "Verificacion: " << (ok ? "OK" : "FALLO: " + problem) << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    return ok;
+}
+
+// Simulación con tiempo (opción --timed) sobre un gestor nuevo con la forma de bloques y
+// las listas rápidas pedidas. Al final verifica los invariantes y que los procesos vivos
+// sean los asignados menos los liberados; devuelve false si algo no cuadra.
+bool show_timed_report(RecordWriter& records, const std::string& source, Address memory_size,
+                       AllocationAlgorithm algorithm, const BlockLayout& layout, const QuickListConfig& quick,
+                       const std::vector<TimedRequest>& requests, long long ignored_lines, const TimedConfig& config) {
+    DynamicMemoryManager<SizeOrderedIndex> manager(memory_size, algorithm);
+    manager.set_layout(layout);
+    manager.set_quick_lists(quick);
+    TimedRun run = run_timed_simulation(manager, requests, config);
+    run.ignored_lines = ignored_lines;
     
-    // Método para cambiar el algoritmo
-    void set_algorithm(AllocationAlgorithm alg) {
-        algorithm = alg;
+    std::string problem;
+    bool ok = manager.check_invariants(problem);
+    long long live = std::count_if(manager.blocks().begin(), manager.blocks().end(),
+                                   [](const MemoryBlock& block) { return !block.is_free && !block.cached; });
+    if (ok && live != run.allocated - run.expirations - run.releases) {
+        ok = false;
+        problem = "quedan " + std::to_string(live) + " procesos vivos y se esperaban " +
+                  std::to_string(run.allocated - run.expirations - run.releases);
     }
+    double occupancy = 100.0 * run.mean_occupancy(memory_size);
     
-    // Obtener nombre del algoritmo actual
-    std::string get_algorithm_name() const {
-        switch (algorithm) {
-            case AllocationAlgorithm::FIRST_FIT: return "First Fit";
-            case AllocationAlgorithm::BEST_FIT: return "Best Fit";
-            case AllocationAlgorithm::WORST_FIT: return "Worst Fit";
-            default: return "Desconocido";
+    if (records.get_format() != OutputFormat::TEXT) {
+        records.begin("timed", TIMED_COLUMNS);
+        records.field("source", source);
+        records.field("algorithm", algorithm_display_name(algorithm));
+        records.field("memory", memory_size);
+        records.field("probe_time", run.probe_time);
+        records.field("arrivals", run.arrivals);
+        records.field("allocated", run.allocated);
+        records.field("failed", run.failed);
+        records.field("rejected", run.rejected);
+        records.field("expirations", run.expirations);
+        records.field("releases", run.releases);
+        records.field("unknown_releases", run.unknown_releases);
+        records.field("withdrawn", run.withdrawn);
+        records.field("events", run.events);
+        records.field("end_time", run.end_time);
+        records.field("latency_mean", run.latency.mean);
+        records.field("latency_p50", run.latency.p50);
+        records.field("latency_p99", run.latency.p99);
+        records.field("latency_max", run.latency.max);
+        records.field("memory_time", run.memory_time);
+        records.field("mean_occupancy", occupancy);
+        records.field("peak_used", run.peak_used);
+        records.field("admission", config.wait ? admission_name(config.admission) : "-");
+        records.field("queued", run.queued);
+        records.field("admitted", run.admitted);
+        records.field("still_waiting", run.still_waiting);
+        records.field("max_queue", run.max_queue);
+        records.field("bypasses", run.bypasses);
+        records.field("wait_mean", run.wait.mean);
+        records.field("wait_p99", run.wait.p99);
+        records.field("wait_max", run.wait.max);
+        records.field("head_blocked_time", run.head_blocked_time);
+        records.field("events_per_second", run.events_per_second());
+        records.field("check", ok);
+        records.end();
+        records.flush();
+        return ok;
+    }
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "SIMULACION CON TIEMPO: " << source << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Memoria: " << memory_size << " | Algoritmo: " << algorithm_display_name(algorithm)
+             << " | Costo por bloque examinado: " << run.probe_time << "\n";
+    std::cout << "Llegadas: " << run.arrivals << " | Asignadas: " << run.allocated << " | Sin memoria: " << run.failed
+             << " | Rechazadas: " << run.rejected << "\n";
+    std::cout << "Liberaciones: al vencer " << run.expirations << ", explicitas " << run.releases
+             << ", de procesos no vivos " << run.unknown_releases << "\n";
+    if (run.withdrawn > 0) {
+        std::cout << "Retiradas antes de asignarse (L de un proceso que aun esperaba): " << run.withdrawn << "\n";
+    }
+    if (run.ignored_lines > 0) {
+        std::cout << "Lineas ignoradas (ni A ni L, o marcas de tiempo invalidas): " << run.ignored_lines << "\n";
+    }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Tiempo simulado: " << run.end_time << " | Asignaciones por unidad de tiempo: "
+             << (run.end_time > 0 ? static_cast<double>(run.allocated) / run.end_time : 0.0) << "\n";
+    std::cout << "Latencia de asignacion (llegada a fin de la busqueda): media " << run.latency.mean << ", p50 "
+             << run.latency.p50 << ", p99 " << run.latency.p99 << ", max " << run.latency.max << "\n";
+    std::cout << "Memoria-tiempo: " << std::setprecision(0) << run.memory_time << " unidades x tiempo | Ocupacion media: "
+             << std::setprecision(2) << occupancy << "% | Pico: " << run.peak_used << "\n";
+    if (config.wait) {
+        std::cout << "Cola de espera (" << admission_name(config.admission) << "): encolados " << run.queued
+                 << ", admitidos " << run.admitted << ", esperando al final " << run.still_waiting
+                 << " | Longitud maxima: " << run.max_queue << "\n";
+        std::cout << "Espera en cola (entrada a admision): media " << run.wait.mean << ", p50 " << run.wait.p50
+                 << ", p99 " << run.wait.p99 << ", max " << run.wait.max << "\n";
+        if (run.still_waiting > 0) {
+            std::cout << "El mas antiguo sin atender lleva esperando " << run.oldest_waiting << "\n";
         }
+        std::cout << "Bloqueo en cabeza: " << std::setprecision(0) << run.head_blocked_time
+                 << " de tiempo con el mas antiguo sin caber y otro que si cabia | Adelantamientos: " << run.bypasses
+                 << std::setprecision(2) << "\n";
+    }
+    std::cout << "Eventos: " << run.events << " en " << std::setprecision(3) << run.seconds << " s ("
+             << std::setprecision(1) << run.events_per_second() / 1e6 << " millones/s; planificador solo "
+             << measure_event_queue(2000000, 1) << " millones/s)\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "Verificacion: " << (ok ? "OK" : "FALLO: " + problem) << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    return ok;
+}
+
+// Ramas reproducidas desde una traza (opción --branch con archivo): una fila por rama,
+// cada una verificada entera. Devuelve false si alguna rama no cuadra.
+bool show_branch_report(RecordWriter& records, const std::string& source, const BranchExplorer& explorer,
+                        const BranchRun& run) {
+    bool all_ok = true;
+    std::vector<std::string> problems;
+    for (const auto& [name, state] : explorer.get_branches()) {
+        std::string problem;
+        bool ok = explorer.check_invariants(state, problem);
+        problems.push_back(ok ? "" : problem);
+        all_ok = all_ok && ok;
     }
     
-    // Método para asignar memoria (comando A)
-    bool allocate(const std::string& process_name, int size) {
-        if (size <= 0) {
-            std::cout << "Error: El tamano debe ser positivo\n";
-            return false;
+    if (records.get_format() != OutputFormat::TEXT) {
+        size_t i = 0;
+        for (const auto& [name, state] : explorer.get_branches()) {
+            records.begin("branch", BRANCH_COLUMNS);
+            records.field("source", source);
+            records.field("branch", name);
+            records.field("current", name == explorer.current_branch());
+            records.field("algorithm", algorithm_display_name(state.algorithm));
+            records.field("memory", explorer.get_total_memory());
+            records.field("used", state.counters.used_memory);
+            records.field("free", state.counters.free_memory);
+            records.field("free_blocks", state.counters.free_blocks);
+            records.field("largest_free", state.blocks.max_measure());
+            records.field("processes", static_cast<long long>(state.processes.size()));
+            records.field("failed", state.counters.failed_allocations);
+            records.field("operations", state.counters.operations);
+            records.field("check", problems[i++].empty());
+            records.end();
         }
-        
-        if (process_locations.find(process_name) != process_locations.end()) {
-            std::cout << "Error: El proceso '" << process_name << "' ya tiene memoria asignada\n";
-            return false;
+        records.flush();
+        return all_ok;
+    }
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "RAMAS DEL ASIGNADOR: " << source << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Memoria: " << explorer.get_total_memory() << " | Ramas: " << explorer.get_branches().size()
+             << " | Rama vigente al terminar: " << explorer.current_branch() << "\n";
+    std::cout << "A atendidos: " << run.allocations << " | Sin memoria: " << run.failed << " | L atendidos: "
+             << run.releases << " | Rechazados: " << run.rejected << "\n";
+    std::cout << "BRANCH/SWITCH/DROP/ALG: " << run.branch_commands << " (invalidos: " << run.invalid_commands << ")\n";
+    if (run.other_commands > 0) {
+        std::cout << "Comandos ignorados (solo A, L, ALG y ramas): " << run.other_commands << "\n";
+    }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::left << std::setw(16) << "Rama" << std::setw(12) << "Algoritmo" << std::right
+             << std::setw(10) << "Usada" << std::setw(10) << "Libre" << std::setw(8) << "Huecos" << std::setw(10)
+             << "Mayor" << std::setw(6) << "Proc." << std::setw(7) << "Fallos" << "\n";
+    size_t i = 0;
+    for (const auto& [name, state] : explorer.get_branches()) {
+        std::string label = (name == explorer.current_branch() ? "*" : " ") + name;
+        std::cout << std::left << std::setw(16) << label << std::setw(12) << algorithm_display_name(state.algorithm)
+                 << std::right << std::setw(10) << state.counters.used_memory << std::setw(10)
+                 << state.counters.free_memory << std::setw(8) << state.counters.free_blocks << std::setw(10)
+                 << state.blocks.max_measure() << std::setw(6) << state.processes.size() << std::setw(7)
+                 << state.counters.failed_allocations << "\n";
+        if (!problems[i++].empty()) {
+            std::cout << "  FALLO: " << problems[i - 1] << "\n";
         }
+    }
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << "Nodos vivos entre todas las ramas: " << explorer.live_nodes() << " (creados en total: "
+             << explorer.created_nodes() << ")\n";
+    std::cout << "Verificacion: " << (all_ok ? "OK" : "FALLO") << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    return all_ok;
+}
+
+// Verificación con ramas sintéticas (opción --branch sin archivo)
+bool show_branch_check(RecordWriter& records, Address memory_size, AllocationAlgorithm algorithm,
+                       const BranchCheck& check) {
+    double fork_us = check.branches > 0 ? 1e6 * check.fork_seconds / check.branches : 0.0;
+    double copy_us = check.branches > 0 ? 1e6 * check.copy_seconds / check.branches : 0.0;
+    if (records.get_format() != OutputFormat::TEXT) {
+        records.begin("branch_check", BRANCH_CHECK_COLUMNS);
+        records.field("algorithm", algorithm_display_name(algorithm));
+        records.field("memory", memory_size);
+        records.field("warm_operations", check.warm_operations);
+        records.field("warm_blocks", static_cast<long long>(check.warm_blocks));
+        records.field("branches", check.branches);
+        records.field("operations_per_branch", check.operations_per_branch);
+        records.field("compared", check.compared);
+        records.field("fork_nodes", check.fork_nodes);
+        records.field("nodes_per_operation", check.nodes_per_operation);
+        records.field("fork_us", fork_us);
+        records.field("copy_us", copy_us);
+        records.field("live_nodes", check.live_nodes_full);
+        records.field("live_nodes_after_drop", check.live_nodes_dropped);
+        records.field("check", check.ok);
+        records.end();
+        records.flush();
+        return check.ok;
+    }
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "RAMAS DEL ASIGNADOR: carga sintetica\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Memoria: " << memory_size << " | Algoritmo de partida: " << algorithm_display_name(algorithm) << "\n";
+    std::cout << "Estado de partida: " << check.warm_operations << " operaciones A/L, " << check.warm_blocks
+             << " bloques\n";
+    std::cout << "Ramas: " << check.branches << " con " << check.operations_per_branch
+             << " A/L cada una (algoritmo i % 5), comparadas con una copia del gestor: " << check.compared
+             << " operaciones\n";
+    std::cout << std::string(78, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Crear una rama: " << check.fork_nodes << " nodos nuevos, " << fork_us
+             << " us | Copiar el gestor: " << copy_us << " us\n";
+    std::cout << "Nodos nuevos por A/L dentro de una rama: " << check.nodes_per_operation << " (log2 de los bloques: "
+             << std::log2(static_cast<double>(std::max<size_t>(check.warm_blocks, 1))) << ")\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << "Nodos vivos: " << check.live_nodes_full << " con todas las ramas, " << check.live_nodes_dropped
+             << " tras borrar la mitad\n";
+    std::cout << "Verificacion: " << (check.ok ? "OK" : "FALLO: " + check.problem) << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    return check.ok;
+}
+
+// Gestor de Tarea 2: núcleo de la biblioteca con algoritmo intercambiable (ALG) e
+// índice de libres por tamano, más la presentación en texto, JSON o CSV
+class MemoryManager : public DynamicMemoryManager<SizeOrderedIndex> {
+private:
+    RecordWriter records;
+    
+    // Registros estructurados del mapa de memoria (un registro por bloque)
+    void emit_memory_records() {
+        records.begin("memory", MEMORY_COLUMNS);
+        records.field("total", total_memory);
+        records.field("algorithm", get_algorithm_name());
+        records.field("blocks", static_cast<long long>(memory_blocks.size()));
+        records.end();
         
-        bool success = false;
-        
-        // Aplicar el algoritmo seleccionado
-        switch (algorithm) {
-            case AllocationAlgorithm::FIRST_FIT:
-                success = allocate_first_fit(process_name, size);
-                break;
-            case AllocationAlgorithm::BEST_FIT:
-                success = allocate_best_fit(process_name, size);
-                break;
-            case AllocationAlgorithm::WORST_FIT:
-                success = allocate_worst_fit(process_name, size);
-                break;
+        for (const auto& block : memory_blocks) {
+            records.begin("block", BLOCK_COLUMNS);
+            records.field("start", block.start);
+            records.field("size", block.size);
+            records.field("state", block.is_free ? "free" : block.cached ? "cached" : "used");
+            records.field("process", block.is_free ? std::string_view() : std::string_view(block.process_name));
+            records.end();
         }
+        records.flush();
+    }
+    
+    // Histograma de bloques libres con las mismas categorías que el comando FR
+    void emit_fragmentation_histogram() {
+        struct Bucket { std::string_view name; Address min; Address max; long long blocks; long long units; };
+        std::array<Bucket, 4> buckets = {{
+            {"very_small", 1, 5, 0, 0},
+            {"small", 6, 15, 0, 0},
+            {"medium", 16, 40, 0, 0},
+            {"large", 41, total_memory, 0, 0}}};
         
-        if (success) {
-            std::cout << "Memoria asignada al proceso '" << process_name 
-                     << "' - Tamano: " << size << " unidades (Algoritmo: " 
-                     << get_algorithm_name() << ")\n";
-        } else {
-            std::cout << "Error: No hay suficiente memoria contigua disponible para el proceso '" 
-                     << process_name << "'\n";
+        for (const auto& block : memory_blocks) {
+            if (!block.is_free) continue;
+            Bucket& bucket = block.size <= 5 ? buckets[0] : block.size <= 15 ? buckets[1] :
+                             block.size <= 40 ? buckets[2] : buckets[3];
+            bucket.blocks++;
+            bucket.units += block.size;
         }
         
-        return success;
+        for (const auto& bucket : buckets) {
+            records.begin("histogram", HISTOGRAM_COLUMNS);
+            records.field("bucket", bucket.name);
+            records.field("min", bucket.min);
+            records.field("max", bucket.max);
+            records.field("blocks", bucket.blocks);
+            records.field("units", bucket.units);
+            records.end();
+        }
+        records.flush();
     }
     
-    // Método para liberar memoria (comando L)
-    bool deallocate(const std::string& process_name) {
-        auto it = process_locations.find(process_name);
-        if (it == process_locations.end()) {
-            std::cout << "Error: El proceso '" << process_name << "' no tiene memoria asignada\n";
-            return false;
+    // Listas rápidas en S: aciertos, lo aparcado y su efecto en la fragmentación, que se
+    // mide comparando los huecos actuales con los que quedarían al consolidar
+    // Estado del algoritmo adaptativo: política vigente, costo medido de cada candidata
+    // y los cambios de política (en JSON/CSV, todos; en texto, los últimos)
+    void show_adaptive() {
+        constexpr size_t SHOWN_SWITCHES = 10;
+        const AdaptiveFit& adaptive = get_adaptive();
+        const auto& switches = adaptive.switches;
+        
+        if (records.get_format() != OutputFormat::TEXT) {
+            records.begin("adaptive", ADAPTIVE_COLUMNS);
+            records.field("active", algorithm_display_name(adaptive.active));
+            records.field("requests", adaptive.requests);
+            records.field("windows", adaptive.windows);
+            records.field("switches", static_cast<long long>(switches.size()));
+            records.field("large_requests", adaptive.large_requests);
+            records.field("cost_first", adaptive.cost[0]);
+            records.field("cost_best", adaptive.cost[1]);
+            records.field("cost_worst", adaptive.cost[2]);
+            records.field("last_switch", switches.empty() ? 0 : switches.back().request);
+            records.end();
+            for (size_t i = 0; i < switches.size(); i++) {
+                records.begin("adaptive_switch", ADAPTIVE_SWITCH_COLUMNS);
+                records.field("request", switches[i].request);
+                records.field("from", algorithm_display_name(switches[i].from));
+                records.field("to", algorithm_display_name(switches[i].to));
+                records.field("probes", switches[i].probes);
+                records.field("failure_rate", switches[i].failure_rate);
+                records.field("fragmentation", switches[i].fragmentation);
+                records.field("exploring", switches[i].exploring ? 1 : 0);
+                records.field("index", static_cast<long long>(i + 1));
+                records.end();
+            }
+            return;
         }
         
-        int process_start = it->second;
-        process_locations.erase(it);
-        
-        // Encontrar y liberar el bloque
-        for (auto& block : memory_blocks) {
-            if (!block.is_free && block.start == process_start && block.process_name == process_name) {
-                block.is_free = true;
-                block.process_name = "";
-                std::cout << "Memoria liberada del proceso '" << process_name << "'\n";
-                
-                // Fusionar bloques libres adyacentes
-                merge_free_blocks();
-                return true;
+        std::cout << "\n=== ALGORITMO ADAPTATIVO ===\n";
+        std::cout << "- Politica vigente: " << algorithm_display_name(adaptive.active) << "\n";
+        std::cout << "- Busquedas: " << adaptive.requests << " en " << adaptive.windows << " ventanas de "
+                 << AdaptiveFit::WINDOW << " (" << adaptive.large_requests
+                 << " grandes atendidas con Best Fit, fuera de las ventanas)\n";
+        std::cout << "- Costo medido (sondas + fallos + fragmentacion):";
+        for (AllocationAlgorithm candidate : AdaptiveFit::CANDIDATES) {
+            double cost = adaptive.cost[static_cast<size_t>(candidate)];
+            std::cout << " " << algorithm_display_name(candidate) << " ";
+            if (cost < 0.0) {
+                std::cout << "-";
+            } else {
+                std::cout << std::fixed << std::setprecision(2) << cost;
+                std::cout.unsetf(std::ios::floatfield);
+                std::cout << std::setprecision(6);
             }
         }
-        
-        return false;
+        std::cout << "\n- Cambios de politica: " << switches.size() << "\n";
+        size_t first = switches.size() > SHOWN_SWITCHES ? switches.size() - SHOWN_SWITCHES : 0;
+        for (size_t i = first; i < switches.size(); i++) {
+            const AdaptiveSwitch& change = switches[i];
+            std::cout << "  #" << i + 1 << " busqueda " << change.request << ": " << algorithm_display_name(change.from)
+                     << " -> " << algorithm_display_name(change.to) << (change.exploring ? " (exploracion)" : "")
+                     << std::fixed << std::setprecision(2) << " | sondas/busqueda " << change.probes
+                     << std::setprecision(1) << ", fallos " << 100.0 * change.failure_rate << "%, fragmentacion "
+                     << 100.0 * change.fragmentation << "%\n";
+            std::cout.unsetf(std::ios::floatfield);
+            std::cout << std::setprecision(6);
+        }
     }
     
-    // Método para fusionar bloques libres adyacentes
-    void merge_free_blocks() {
-        // Ordenar bloques por posición de inicio
-        std::sort(memory_blocks.begin(), memory_blocks.end(), 
-                 [](const MemoryBlock& a, const MemoryBlock& b) {
-                     return a.start < b.start;
-                 });
-        
-        // Fusionar bloques libres consecutivos
-        for (auto it = memory_blocks.begin(); it != memory_blocks.end() - 1; ) {
-            if (it->is_free && (it + 1)->is_free && 
-                (it->start + it->size) == (it + 1)->start) {
-                // Fusionar los bloques
-                it->size += (it + 1)->size;
-                memory_blocks.erase(it + 1);
+    void show_quick_lists() {
+        int free_blocks = 0, consolidated_blocks = 0;
+        Address consolidated_largest = 0, run = 0;
+        for (const auto& block : memory_blocks) {
+            if (block.is_free || block.cached) {
+                free_blocks += block.is_free ? 1 : 0;
+                consolidated_blocks += run == 0 ? 1 : 0;
+                run += block.size;
+                consolidated_largest = std::max(consolidated_largest, run);
             } else {
-                ++it;
+                run = 0;
             }
         }
+        long long eligible = counters.quick_hits + counters.quick_misses;
+        double hit_rate = eligible > 0 ? 100.0 * counters.quick_hits / eligible : 0.0;
+        
+        if (records.get_format() != OutputFormat::TEXT) {
+            records.begin("quick", QUICK_COLUMNS);
+            records.field("max_size", quick.max_size);
+            records.field("depth", quick.depth);
+            records.field("hits", counters.quick_hits);
+            records.field("misses", counters.quick_misses);
+            records.field("hit_rate", hit_rate);
+            records.field("cached_blocks", counters.cached_blocks);
+            records.field("cached_memory", counters.cached_memory);
+            records.field("flushes", counters.quick_flushes);
+            records.field("flushed_blocks", counters.quick_flushed_blocks);
+            records.field("free_blocks", free_blocks);
+            records.field("free_blocks_consolidated", consolidated_blocks);
+            records.field("largest_free_consolidated", consolidated_largest);
+            records.end();
+            return;
+        }
+        
+        std::cout << "\n=== LISTAS RAPIDAS ===\n";
+        std::cout << "- Tamanos hasta " << quick.max_size << ", " << quick.depth << " bloques por lista, tope " 
+                 << quick.max_cached_percent << "% de la memoria\n";
+        std::cout << "- Aciertos: " << counters.quick_hits << " de " << eligible 
+                 << " asignaciones con lista (" << hit_rate << "%)\n";
+        std::cout << "- Aparcados: " << counters.cached_blocks << " bloques, " << counters.cached_memory 
+                 << " unidades (" << (100.0 * counters.cached_memory / total_memory) 
+                 << "%), solo disponibles para su tamano\n";
+        std::cout << "- Consolidaciones diferidas: " << counters.quick_flushes << " (" 
+                 << counters.quick_flushed_blocks << " bloques devueltos)\n";
+        std::cout << "- Bloques libres: " << free_blocks << " (" << consolidated_blocks 
+                 << " al consolidar); mayor hueco: " << get_largest_free_block() << " (" 
+                 << consolidated_largest << " al consolidar)\n";
+    }
+
+public:
+    MemoryManager(Address size = 100, AllocationAlgorithm alg = AllocationAlgorithm::FIRST_FIT,
+                  OutputFormat format = OutputFormat::TEXT) 
+        : DynamicMemoryManager(size, alg), records(std::cout, format) {}
+    
+    // Cambiar el formato de salida (texto, JSON o CSV)
+    void set_output_format(OutputFormat format) {
+        records.set_format(format);
+    }
+    
+    OutputFormat get_output_format() const {
+        return records.get_format();
+    }
+    
+    // Perfil de un archivo de traza en el formato vigente (comando ANALYZE)
+    void show_trace_analysis(const std::string& filename) {
+        analyze_trace_file(records, filename);
+    }
+    
+    // Volcar los registros estructurados pendientes
+    void flush_output() {
+        records.flush();
+    }
+    
+    // Mensaje o registro con el resultado de un comando A o L
+    void report(char op, std::string_view process_name, Address size, OpStatus status, Address start) {
+        if (records.get_format() != OutputFormat::TEXT) {
+            emit_op_record(records, op, process_name, size, status, start, algorithm);
+        } else {
+            print_op_message(std::cout, op, process_name, size, status, algorithm);
+        }
+    }
+    
+    // Método para asignar memoria (comando A)
+    bool allocate(std::string_view process_name, Address size) {
+        Address start;
+        OpStatus status = try_allocate(process_name, size, start);
+        report('A', process_name, size, status, start);
+        return status == OpStatus::OK;
+    }
+    
+    // Método para liberar memoria (comando L)
+    bool deallocate(std::string_view process_name) {
+        Address start, size;
+        OpStatus status = try_deallocate(process_name, start, size);
+        report('L', process_name, size, status, start);
+        return status == OpStatus::OK;
+    }
+    
+    // Método para redimensionar un proceso (comando R)
+    bool resize(std::string_view process_name, Address size) {
+        Address start, moved;
+        OpStatus status = try_resize(process_name, size, start, moved);
+        if (records.get_format() != OutputFormat::TEXT) {
+            emit_op_record(records, 'R', process_name, size, status, start, algorithm);
+        } else {
+            print_resize_message(std::cout, process_name, size, status, moved, algorithm);
+        }
+        return status == OpStatus::OK;
     }
     
     // Método para mostrar el estado de la memoria (comando M) - Formato del ejemplo
     void show_memory() {
-        // Ordenar bloques por posición
-        std::sort(memory_blocks.begin(), memory_blocks.end(), 
-                 [](const MemoryBlock& a, const MemoryBlock& b) {
-                     return a.start < b.start;
-                 });
+        if (records.get_format() != OutputFormat::TEXT) {
+            emit_memory_records();
+            return;
+        }
         
         std::cout << "[";
         bool first = true;
@@ -235,6 +954,8 @@ public:
             
             if (block.is_free) {
                 std::cout << "Libre: " << block.size;
+            } else if (block.cached) {
+                std::cout << "Rapida: " << block.size;
             } else {
                 std::cout << block.process_name << ": " << block.size;
             }
@@ -244,17 +965,16 @@ public:
     
     // Método para mostrar estado detallado de la memoria
     void show_detailed_memory() {
+        if (records.get_format() != OutputFormat::TEXT) {
+            show_memory();
+            return;
+        }
+        
         std::cout << "\n" << std::string(60, '=') << "\n";
         std::cout << "MAPA DETALLADO DE MEMORIA (Total: " << total_memory << " unidades)\n";
         std::cout << "Algoritmo: " << get_algorithm_name() << "\n";
         std::cout << std::string(60, '=') << "\n";
         
-        // Ordenar bloques por posición
-        std::sort(memory_blocks.begin(), memory_blocks.end(), 
-                 [](const MemoryBlock& a, const MemoryBlock& b) {
-                     return a.start < b.start;
-                 });
-        
         std::cout << std::left << std::setw(8) << "Inicio" 
                  << std::setw(8) << "Tamano" 
                  << std::setw(12) << "Estado" 
@@ -264,45 +984,30 @@ public:
         for (const auto& block : memory_blocks) {
             std::cout << std::left << std::setw(8) << block.start
                      << std::setw(8) << block.size
-                     << std::setw(12) << (block.is_free ? "LIBRE" : "OCUPADO")
+                     << std::setw(12) << (block.is_free ? "LIBRE" : block.cached ? "RAPIDA" : "OCUPADO")
                      << (block.is_free ? "" : block.process_name) << "\n";
         }
         
         // Mostrar representación visual
         std::cout << "\nRepresentacion visual:\n";
-        std::string visual_map(total_memory, '.');
-        
-        for (const auto& block : memory_blocks) {
-            char symbol = block.is_free ? '.' : '#';
-            for (int i = block.start; i < block.start + block.size; ++i) {
-                visual_map[i] = symbol;
-            }
-        }
-        
-        // Mostrar la representación en líneas de 50 caracteres
-        for (int i = 0; i < total_memory; i += 50) {
-            std::cout << std::setw(3) << i << ": ";
-            int end = std::min(i + 50, total_memory);
-            for (int j = i; j < end; ++j) {
-                std::cout << visual_map[j];
-            }
-            std::cout << "\n";
-        }
+        print_visual_map(std::cout, memory_blocks, total_memory, [](const MemoryBlock& block) {
+            return block.is_free ? '.' : block.cached ? '+' : '#';
+        });
         
-        std::cout << "\nLeyenda: '.' = Libre, '#' = Ocupado\n";
+        std::cout << "\nLeyenda: '.' = Libre, '#' = Ocupado" << (quick.enabled() ? ", '+' = Lista rapida" : "") << "\n";
         std::cout << std::string(60, '=') << "\n\n";
     }
     
     // Mostrar estadísticas de memoria
     void show_statistics() {
-        int free_memory = 0;
-        int used_memory = 0;
+        Address free_memory = 0;
+        Address used_memory = 0;
         int free_blocks = 0;
         int used_blocks = 0;
-        int smallest_free_block = INT_MAX;
-        int largest_free_block = 0;
+        Address smallest_free_block = LLONG_MAX;
+        Address largest_free_block = 0;
         
-        std::vector<int> free_block_sizes;
+        std::vector<Address> free_block_sizes;
         
         for (const auto& block : memory_blocks) {
             if (block.is_free) {
@@ -316,14 +1021,14 @@ public:
                 if (block.size > largest_free_block) {
                     largest_free_block = block.size;
                 }
-            } else {
+            } else if (!block.cached) {
                 used_memory += block.size;
                 used_blocks++;
             }
         }
         
         // Calcular fragmentación externa según el algoritmo
-        int external_fragmentation = 0;
+        Address external_fragmentation = 0;
         int min_useful_size = 15; // Bloques menores a 15 unidades se consideran fragmentación externa
         
         for (const auto& block : memory_blocks) {
@@ -333,25 +1038,34 @@ public:
         }
         
         // Calcular fragmentación interna
-        // La fragmentación interna ocurre cuando un bloque asignado es mayor al necesario
-        int internal_fragmentation = 0;
-        
-        // Para algoritmos como Best Fit y Worst Fit, calculamos la fragmentación interna
-        // basándose en el desperdicio potencial según el algoritmo usado
-        switch (algorithm) {
-            case AllocationAlgorithm::BEST_FIT:
-                // Best Fit minimiza la fragmentación interna
-                internal_fragmentation = free_blocks * 2; // Estimación conservadora
-                break;
-            case AllocationAlgorithm::WORST_FIT:
-                // Worst Fit puede generar más fragmentación interna
-                internal_fragmentation = free_blocks * 5; // Estimación mayor
-                break;
-            case AllocationAlgorithm::FIRST_FIT:
-            default:
-                // First Fit tiene fragmentación interna moderada
-                internal_fragmentation = free_blocks * 3; // Estimación media
-                break;
+        // La fragmentación interna ocurre cuando un bloque asignado es mayor al necesario:
+        // lo ocupado menos lo pedido (0 con el modelo exacto, igual que Tarea 1)
+        Address internal_fragmentation = counters.used_memory - counters.requested_memory;
+        
+        if (records.get_format() != OutputFormat::TEXT) {
+            records.begin("stats", STATS_COLUMNS);
+            records.field("algorithm", get_algorithm_name());
+            records.field("total", total_memory);
+            records.field("free", free_memory);
+            records.field("used", used_memory);
+            records.field("free_blocks", free_blocks);
+            records.field("used_blocks", used_blocks);
+            records.field("external_fragmentation", external_fragmentation);
+            records.field("internal_fragmentation", internal_fragmentation);
+            records.field("smallest_free", free_blocks > 0 ? smallest_free_block : 0);
+            records.field("largest_free", largest_free_block);
+            records.field("efficiency", 100.0 * used_memory / total_memory);
+            records.field("fragmentation_level",
+                          100.0 * (external_fragmentation + internal_fragmentation) / total_memory);
+            records.end();
+            if (quick.enabled()) {
+                show_quick_lists();
+            }
+            if (get_adaptive().requests > 0) {
+                show_adaptive();
+            }
+            records.flush();
+            return;
         }
         
         std::cout << "Estadisticas de memoria (Algoritmo: " << get_algorithm_name() << "):\n";
@@ -368,6 +1082,34 @@ public:
                  << (100.0 * external_fragmentation / total_memory) << "%)\n";
         std::cout << "- Fragmentacion interna: " << internal_fragmentation << " unidades (" 
                  << (100.0 * internal_fragmentation / total_memory) << "%)\n";
+        if (layout.is_exact()) {
+            // Con el modelo exacto lo medido siempre es 0: se muestra además la estimación
+            // histórica por algoritmo, rotulada como tal y fuera de los totales
+            Address estimated_internal;
+            switch (algorithm) {
+                case AllocationAlgorithm::BEST_FIT:
+                    // Best Fit minimiza la fragmentación interna
+                    estimated_internal = free_blocks * 2; // Estimación conservadora
+                    break;
+                case AllocationAlgorithm::WORST_FIT:
+                    // Worst Fit puede generar más fragmentación interna
+                    estimated_internal = free_blocks * 5; // Estimación mayor
+                    break;
+                case AllocationAlgorithm::FIRST_FIT:
+                default:
+                    // First Fit tiene fragmentación interna moderada
+                    estimated_internal = free_blocks * 3; // Estimación media
+                    break;
+            }
+            std::cout << "  - Estimacion por algoritmo (no medida, bloques del tamano pedido): " 
+                     << estimated_internal << " unidades\n";
+        } else {
+            std::cout << "  - Unidades pedidas por los procesos: " << counters.requested_memory << "\n";
+            std::cout << "  - Cabeceras (" << layout.header << " por bloque): " << counters.header_memory << " unidades\n";
+            std::cout << "  - Relleno de alineacion (" << layout.alignment << ") y sobrantes menores a " 
+                     << layout.min_split << ": " 
+                     << (internal_fragmentation - counters.header_memory) << " unidades\n";
+        }
         
         if (free_blocks > 0) {
             std::cout << "- Bloque libre mas pequeno: " << smallest_free_block << " unidades\n";
@@ -404,6 +1146,36 @@ public:
                 std::cout << "- Tiempo de busqueda: O(n) con comparaciones\n";
                 std::cout << "- Fragmentacion esperada: Alta interna, baja externa\n";
                 break;
+            case AllocationAlgorithm::NEXT_FIT:
+                std::cout << "- Next Fit: Continua la busqueda desde la ultima asignacion\n";
+                std::cout << "- Tiempo de busqueda: O(n) lineal, recorrido circular\n";
+                std::cout << "- Fragmentacion esperada: Media, repartida por toda la memoria\n";
+                break;
+            case AllocationAlgorithm::TLSF:
+                std::cout << "- TLSF: Listas libres segregadas en dos niveles con mapas de bits\n";
+                std::cout << "- Tiempo de busqueda: O(1), acotado sin importar la cantidad de bloques\n";
+                std::cout << "- Fragmentacion esperada: Baja, similar a Best Fit (ajuste por tramos de tamano)\n";
+                break;
+            case AllocationAlgorithm::ADAPTIVE:
+                std::cout << "- Adaptativo: First, Best o Worst Fit segun el costo medido en ventanas de "
+                         << AdaptiveFit::WINDOW << " busquedas\n";
+                std::cout << "- Tiempo de busqueda: el de la politica vigente\n";
+                std::cout << "- Fragmentacion esperada: la menor que haya medido entre las tres\n";
+                break;
+        }
+        
+        if (counters.resizes > 0) {
+            std::cout << "\n=== REDIMENSIONES (R) ===\n";
+            std::cout << "- Atendidas: " << counters.resizes << " (en el lugar: " 
+                     << counters.resizes - counters.moves << ", con movimiento: " << counters.moves << ")\n";
+            std::cout << "- Unidades copiadas al mover: " << counters.moved_memory << "\n";
+        }
+        
+        if (quick.enabled()) {
+            show_quick_lists();
+        }
+        if (get_adaptive().requests > 0) {
+            show_adaptive();
         }
         
         // Eficiencia general
@@ -426,14 +1198,19 @@ public:
     
     // Método para análisis detallado de fragmentación (nuevo comando FR)
     void analyze_fragmentation() {
+        if (records.get_format() != OutputFormat::TEXT) {
+            emit_fragmentation_histogram();
+            return;
+        }
+        
         std::cout << "\n" << std::string(60, '=') << "\n";
         std::cout << "ANALISIS DETALLADO DE FRAGMENTACION\n";
         std::cout << std::string(60, '=') << "\n";
         
         // Clasificar bloques libres por tamaño
-        std::vector<int> very_small(0), small(0), medium(0), large(0);
-        int total_free = 0;
-        int total_used = 0;
+        std::vector<Address> very_small(0), small(0), medium(0), large(0);
+        Address total_free = 0;
+        Address total_used = 0;
         
         for (const auto& block : memory_blocks) {
             if (block.is_free) {
@@ -454,11 +1231,11 @@ public:
         std::cout << "- Grandes (>40 unidades): " << large.size() << " bloques\n";
         
         // Fragmentación por categorías
-        int very_small_total = 0, small_total = 0, medium_total = 0, large_total = 0;
-        for (int size : very_small) very_small_total += size;
-        for (int size : small) small_total += size;
-        for (int size : medium) medium_total += size;
-        for (int size : large) large_total += size;
+        Address very_small_total = 0, small_total = 0, medium_total = 0, large_total = 0;
+        for (Address size : very_small) very_small_total += size;
+        for (Address size : small) small_total += size;
+        for (Address size : medium) medium_total += size;
+        for (Address size : large) large_total += size;
         
         std::cout << "\nEspacio por categoria:\n";
         std::cout << "- Muy pequenos: " << very_small_total << " unidades (" 
@@ -494,155 +1271,59 @@ public:
                 std::cout << "- Best Fit reduciria desperdicio de espacio en ~25%\n";
                 std::cout << "- First Fit seria mas eficiente en tiempo\n";
                 break;
+            case AllocationAlgorithm::NEXT_FIT:
+                std::cout << "- First Fit concentraria los fragmentos al inicio de la memoria\n";
+                std::cout << "- Best Fit reduciria desperdicio de espacio\n";
+                break;
+            case AllocationAlgorithm::TLSF:
+                std::cout << "- Best Fit aprovecharia huecos del mismo tramo que TLSF descarta\n";
+                std::cout << "- First Fit no acota el peor caso de la busqueda\n";
+                break;
+            case AllocationAlgorithm::ADAPTIVE:
+                std::cout << "- Una politica fija evita las ventanas de exploracion, que usan la peor a proposito\n";
+                std::cout << "- --adaptive-eval compara el adaptativo con cada politica fija\n";
+                break;
         }
         
         std::cout << std::string(60, '=') << "\n";
     }
 };
 
-// Función para listar archivos en el directorio Test
-std::vector<std::string> list_test_files() {
-    std::vector<std::string> files;
-    std::string test_dir = "../../Test";
-    
-    try {
-        if (fs::exists(test_dir) && fs::is_directory(test_dir)) {
-            for (const auto& entry : fs::directory_iterator(test_dir)) {
-                if (entry.is_regular_file()) {
-                    files.push_back(entry.path().filename().string());
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error al acceder al directorio Test: " << e.what() << std::endl;
-    }
+class MemorySimulator : public SimulatorBase<MemorySimulator, MemoryManager> {
+private:
+    friend class SimulatorBase<MemorySimulator, MemoryManager>;
     
-    return files;
-}
-
-// Función para mostrar y seleccionar archivo dinámicamente
-std::string select_test_file() {
-    std::vector<std::string> files = list_test_files();
+    static constexpr ShellTexts TEXTS = {
+        "Seleccionando archivo dinamicamente...\n",
+        "No se selecciono ningun archivo.\n",
+        DEFAULT_SELECTION_TEXTS};
     
-    if (files.empty()) {
-        std::cout << "No se encontraron archivos en el directorio Test.\n";
-        std::cout << "Ingrese el nombre del archivo manualmente: ";
-        std::string filename;
-        std::getline(std::cin, filename);
-        return filename;
+    OutputFormat output_format() const {
+        return memory_manager.get_output_format();
     }
     
-    std::cout << "\n=== ARCHIVOS DISPONIBLES EN TEST ===\n";
-    for (size_t i = 0; i < files.size(); i++) {
-        std::cout << (i + 1) << ". " << files[i] << "\n";
+    void flush_output() {
+        memory_manager.flush_output();
     }
-    std::cout << (files.size() + 1) << ". Introducir nombre manualmente\n";
     
-    std::cout << "\nSeleccione una opcion (1-" << (files.size() + 1) << "): ";
-    std::string input;
-    std::getline(std::cin, input);
-    
-    try {
-        int choice = std::stoi(input);
-        if (choice >= 1 && choice <= static_cast<int>(files.size())) {
-            std::string selected_file = "../../Test/" + files[choice - 1];
-            std::cout << "Archivo seleccionado: " << files[choice - 1] << "\n";
-            return selected_file;
-        } else if (choice == static_cast<int>(files.size()) + 1) {
-            std::cout << "Ingrese el nombre del archivo: ";
-            std::string filename;
-            std::getline(std::cin, filename);
-            return filename;
-        } else {
-            std::cout << "Opcion no valida. Usando el primer archivo disponible.\n";
-            std::string selected_file = "../../Test/" + files[0];
-            std::cout << "Archivo seleccionado: " << files[0] << "\n";
-            return selected_file;
+    // Resultado de un A/L en la etapa de reporte del pipeline
+    static void report_operation(std::ostream& out, RecordWriter& records, const ReportItem& item) {
+        if (item.format == OutputFormat::TEXT) {
+            print_op_message(out, item.op, item.process_name, item.size, item.status, item.algorithm);
+            return;
         }
-    } catch (const std::exception& e) {
-        std::cout << "Entrada no valida. Usando el primer archivo disponible.\n";
-        std::string selected_file = "../../Test/" + files[0];
-        std::cout << "Archivo seleccionado: " << files[0] << "\n";
-        return selected_file;
-    }
-}
-
-class MemorySimulator {
-private:
-    MemoryManager memory_manager;
-    
-public:
-    MemorySimulator(int memory_size, AllocationAlgorithm algorithm) 
-        : memory_manager(memory_size, algorithm) {}
-    
-    void run() {
-        std::cout << "=== SIMULADOR DE GESTION DE MEMORIA - TAREA 2 ===\n";
-        std::cout << "Algoritmo seleccionado: " << memory_manager.get_algorithm_name() << "\n";
-        std::cout << "Comandos disponibles:\n";
-        std::cout << "  A <proceso> <tamano>  - Asignar memoria\n";
-        std::cout << "  L <proceso>           - Liberar memoria\n";
-        std::cout << "  M                     - Mostrar estado (formato simple)\n";
-        std::cout << "  D                     - Mostrar estado detallado\n";
-        std::cout << "  S                     - Mostrar estadisticas\n";
-        std::cout << "  FR                    - Analisis detallado de fragmentacion\n";
-        std::cout << "  F [archivo]           - Ejecutar comandos desde archivo (seleccion dinamica si no se especifica)\n";
-        std::cout << "  ALG <1|2|3>           - Cambiar algoritmo (1=First, 2=Best, 3=Worst)\n";
-        std::cout << "  Q                     - Salir\n\n";
-        
-        std::string line;
-        while (true) {
-            std::cout << "shell> ";
-            if (!std::getline(std::cin, line)) {
-                break;
-            }
-            
-            if (!process_command(line)) {
-                break;
-            }
+        if (records.get_format() != item.format) {
+            records.set_format(item.format);
         }
+        emit_op_record(records, item.op, item.process_name, item.size, item.status, item.start, item.algorithm);
+        records.flush();
     }
     
-    bool process_command(const std::string& line) {
-        std::istringstream iss(line);
-        std::string command;
-        iss >> command;
-        
-        if (command.empty()) {
-            return true;
-        }
-        
-        // Convertir a mayúsculas
-        std::transform(command.begin(), command.end(), command.begin(), ::toupper);
-        
-        if (command == "A") {
-            std::string process_name;
-            int size;
-            if (iss >> process_name >> size) {
-                memory_manager.allocate(process_name, size);
-            } else {
-                std::cout << "Uso: A <proceso> <tamano>\n";
-            }
-        }
-        else if (command == "L") {
-            std::string process_name;
-            if (iss >> process_name) {
-                memory_manager.deallocate(process_name);
-            } else {
-                std::cout << "Uso: L <proceso>\n";
-            }
-        }
-        else if (command == "M") {
-            memory_manager.show_memory();
-        }
-        else if (command == "D") {
+    // Comandos propios de Tarea 2: D, ALG, SAMPLE, FMT y ANALYZE
+    bool process_extra_command(const std::string& command, std::istringstream& iss) {
+        if (command == "D") {
             memory_manager.show_detailed_memory();
         }
-        else if (command == "S") {
-            memory_manager.show_statistics();
-        }
-        else if (command == "FR") {
-            memory_manager.analyze_fragmentation();
-        }
         else if (command == "ALG") {
             int alg_num;
             if (iss >> alg_num) {
@@ -651,183 +1332,1291 @@ public:
                     case 1: new_alg = AllocationAlgorithm::FIRST_FIT; break;
                     case 2: new_alg = AllocationAlgorithm::BEST_FIT; break;
                     case 3: new_alg = AllocationAlgorithm::WORST_FIT; break;
+                    case 4: new_alg = AllocationAlgorithm::NEXT_FIT; break;
+                    case 5: new_alg = AllocationAlgorithm::TLSF; break;
+                    case 6: new_alg = AllocationAlgorithm::ADAPTIVE; break;
                     default:
-                        std::cout << "Algoritmo invalido. Use 1=First Fit, 2=Best Fit, 3=Worst Fit\n";
+                        std::cout << "Algoritmo invalido. Use 1=First Fit, 2=Best Fit, 3=Worst Fit, 4=Next Fit, 5=TLSF, "
+                                     "6=Adaptativo\n";
                         return true;
                 }
                 memory_manager.set_algorithm(new_alg);
-                std::cout << "Algoritmo cambiado a: " << memory_manager.get_algorithm_name() << "\n";
+                if (human_output()) {
+                    std::cout << "Algoritmo cambiado a: " << memory_manager.get_algorithm_name() << "\n";
+                }
+            } else {
+                std::cout << "Uso: ALG <1|2|3|4|5|6> (1=First Fit, 2=Best Fit, 3=Worst Fit, 4=Next Fit, 5=TLSF, "
+                             "6=Adaptativo)\n";
+            }
+        }
+        else if (command == "SAMPLE") {
+            std::string mode;
+            iss >> mode;
+            std::transform(mode.begin(), mode.end(), mode.begin(), ::toupper);
+            
+            if (mode == "OPS" || mode == "US") {
+                long long every;
+                size_t capacity = MetricsSampler::DEFAULT_CAPACITY;
+                if (iss >> every && every > 0) {
+                    iss >> capacity;
+                    sampler.configure(mode == "OPS" ? SamplingMode::OPERATIONS : SamplingMode::MICROSECONDS,
+                                      every, capacity);
+                    if (human_output()) {
+                        std::cout << "Muestreo activado cada " << every 
+                                 << (mode == "OPS" ? " operaciones" : " microsegundos")
+                                 << " (capacidad: " << capacity << " muestras)\n";
+                    }
+                } else {
+                    std::cout << "Uso: SAMPLE OPS|US <n> [capacidad]\n";
+                }
+            } else if (mode == "OFF") {
+                sampler.configure(SamplingMode::OFF, 0, 0);
+            } else if (mode == "SAVE") {
+                std::string filename, kind;
+                if (iss >> filename) {
+                    iss >> kind;
+                    bool binary = kind == "bin" || kind == "BIN";
+                    if (sampler.save(filename, binary)) {
+                        if (human_output()) {
+                            std::cout << sampler.size() << " muestras guardadas en '" << filename << "'";
+                            if (sampler.dropped() > 0) {
+                                std::cout << " (" << sampler.dropped() << " sobrescritas por buffer lleno)";
+                            }
+                            std::cout << "\n";
+                        }
+                    } else {
+                        std::cout << "Error: No se pudo escribir el archivo '" << filename << "'\n";
+                    }
+                } else {
+                    std::cout << "Uso: SAMPLE SAVE <archivo> [csv|bin]\n";
+                }
             } else {
-                std::cout << "Uso: ALG <1|2|3> (1=First Fit, 2=Best Fit, 3=Worst Fit)\n";
+                std::cout << "Uso: SAMPLE OPS|US <n> [capacidad] | SAMPLE SAVE <archivo> [csv|bin] | SAMPLE OFF\n";
             }
         }
-        else if (command == "F") {
+        else if (command == "ANALYZE") {
             std::string filename;
             if (iss >> filename) {
-                execute_from_file(filename);
+                memory_manager.show_trace_analysis(filename);
             } else {
-                // Si no se proporciona archivo, usar selección dinámica
-                std::cout << "Seleccionando archivo dinamicamente...\n";
-                std::string selected_file = select_test_file();
-                if (!selected_file.empty()) {
-                    execute_from_file(selected_file);
-                } else {
-                    std::cout << "No se selecciono ningun archivo.\n";
-                }
+                std::cout << "Uso: ANALYZE <archivo>\n";
             }
         }
-        else if (command == "Q") {
-            std::cout << "Saliendo del simulador...\n";
-            return false;
+        else if (command == "FMT") {
+            std::string format_name;
+            OutputFormat format;
+            if (iss >> format_name && parse_output_format(format_name, format)) {
+                memory_manager.set_output_format(format);
+                if (human_output()) {
+                    std::cout << "Formato de salida: texto\n";
+                }
+            } else {
+                std::cout << "Uso: FMT <text|json|csv>\n";
+            }
         }
         else {
-            std::cout << "Comando no reconocido: " << command << "\n";
+            return false;
         }
-        
         return true;
     }
+
+public:
+    MemorySimulator(Address memory_size, AllocationAlgorithm algorithm,
+                    OutputFormat format = OutputFormat::TEXT) 
+        : SimulatorBase(memory_size, algorithm, format) {}
     
-    void execute_from_file(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cout << "Error: No se pudo abrir el archivo '" << filename << "'\n";
+    void run() {
+        if (!human_output()) {
+            // Sin banner ni prompt: la entrada estándar se procesa como un flujo de comandos
+            std::string line;
+            while (std::getline(std::cin, line) && process_command(line)) {
+            }
             return;
         }
         
-        std::string line;
-        int line_number = 0;
-        std::cout << "Ejecutando comandos desde '" << filename << "'...\n\n";
-        
-        while (std::getline(file, line)) {
-            line_number++;
-            
-            // Ignorar líneas vacías y comentarios
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            
-            std::cout << "[Linea " << line_number << "] " << line << "\n";
-            process_command(line);
-            std::cout << "\n";
-        }
+        std::cout << "=== SIMULADOR DE GESTION DE MEMORIA - TAREA 2 ===\n";
+        std::cout << "Algoritmo seleccionado: " << memory_manager.get_algorithm_name() << "\n";
+        std::cout << "Comandos disponibles:\n";
+        std::cout << "  A <proceso> <tamano>  - Asignar memoria\n";
+        std::cout << "  L <proceso>           - Liberar memoria\n";
+        std::cout << "  R <proceso> <tamano>  - Redimensionar (en el lugar si se puede)\n";
+        std::cout << "  AB <n> <prefijo> <tamano...> - Asignar en lote prefijo1..prefijoN\n";
+        std::cout << "  LB <proceso...>       - Liberar en lote (una sola pasada de fusion)\n";
+        std::cout << "  M                     - Mostrar estado (formato simple)\n";
+        std::cout << "  D                     - Mostrar estado detallado\n";
+        std::cout << "  S                     - Mostrar estadisticas\n";
+        std::cout << "  FR                    - Analisis detallado de fragmentacion\n";
+        std::cout << "  F [archivo]           - Ejecutar comandos desde archivo (seleccion dinamica si no se especifica)\n";
+        std::cout << "  ALG <1-6>             - Cambiar algoritmo (1=First, 2=Best, 3=Worst, 4=Next, 5=TLSF, 6=Adaptativo)\n";
+        std::cout << "  FMT <text|json|csv>   - Cambiar formato de salida (M, D, S, FR, A, L)\n";
+        std::cout << "  ANALYZE <archivo>     - Perfil de una traza sin simular (pico vivo, vidas, tamanos)\n";
+        std::cout << "  SAMPLE OPS|US <n> [capacidad] - Muestrear metricas cada n operaciones o microsegundos\n";
+        std::cout << "  SAMPLE SAVE <archivo> [csv|bin] / SAMPLE OFF - Guardar o desactivar el muestreo\n";
+        std::cout << "  Q                     - Salir\n\n";
         
-        std::cout << "=== Ejecucion del archivo completada ===\n";
-        file.close();
+        command_loop();
     }
 };
 
 // Función para mostrar ayuda de uso
+// Destino de salida que descarta todo (la verificación no mide la consola)
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override {
+        return traits_type::not_eof(c);
+    }
+    
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+// Verificación de la ruta sin reservas: reproduce una traza sintética que termina
+// liberando todo, primero en frío y luego ya en régimen, una y dos veces seguidas. La
+// diferencia entre ambas son las reservas de las operaciones A/L, que deben ser cero;
+// lo que queda son los buffers de línea que cada reproducción crea una sola vez.
+bool run_allocation_check(Address memory_size, AllocationAlgorithm algorithm, int count, int max_request) {
+    std::vector<ReplayOp> ops = synthetic_replay_ops(count, max_request, 1);
+    std::vector<std::string> live;
+    std::string trace;
+    for (const auto& op : ops) {
+        if (op.op == 'A') {
+            trace += "A proc_" + op.process_name + " " + std::to_string(op.size) + "\n";
+            live.push_back(op.process_name);
+        } else {
+            trace += "L proc_" + op.process_name + "\n";
+            live.erase(std::find(live.begin(), live.end(), op.process_name));
+        }
+    }
+    for (const auto& name : live) {
+        trace += "L proc_" + name + "\n";
+    }
+    size_t operations = ops.size() + live.size();
+    std::string doubled = trace + trace;
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "VERIFICACION DE RESERVAS EN EL HEAP - Algoritmo: " << algorithm_display_name(algorithm)
+             << " | Memoria: " << memory_size << " | Operaciones: " << operations << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Formato" << std::setw(20) << "Reservas en frio"
+             << std::setw(24) << "Fijas por reproduccion" << std::setw(14) << "Por A/L" << "Resultado\n";
+    std::cout << std::string(78, '-') << "\n";
+    
+    bool all_ok = true;
+    const std::pair<const char*, OutputFormat> formats[] = {
+        {"text", OutputFormat::TEXT}, {"json", OutputFormat::JSON}, {"csv", OutputFormat::CSV}};
+    for (const auto& [name, format] : formats) {
+        MemorySimulator simulator(memory_size, algorithm, format);
+        std::istringstream once(trace), twice(doubled);
+        NullBuffer discard;
+        std::streambuf* terminal = std::cout.rdbuf(&discard);
+        
+        // Reservas hechas al reproducir `input` desde el comienzo
+        auto replay_counting = [&](std::istringstream& input) {
+            input.clear();
+            input.seekg(0);
+            long long before = heap_allocations();
+            simulator.replay(input);
+            return heap_allocations() - before;
+        };
+        long long cold = replay_counting(twice);
+        long long fixed = replay_counting(once);
+        long long per_ops = replay_counting(twice) - fixed;
+        std::cout.rdbuf(terminal);
+        
+        bool ok = per_ops == 0;
+        all_ok = all_ok && ok;
+        std::cout << std::left << std::setw(10) << name << std::setw(20) << cold << std::setw(24) << fixed
+                 << std::setw(14) << per_ops << (ok ? "OK" : "FALLO") << "\n";
+    }
+    std::cout << std::string(78, '=') << "\n";
+    return all_ok;
+}
+
+// Verificación de memorias dispersas enormes: en un heap de `memory_size` unidades
+// asigna `count` procesos y libera uno de cada dos, de modo que quedan del orden de
+// `count` bloques, y luego coloca un proceso por cada diez mil en los huecos. El pico
+// de bytes en el heap del simulador debe depender de los bloques y no de la memoria
+// simulada.
+bool run_big_heap_check(Address memory_size, int count) {
+    constexpr long long MAX_PEAK_BYTES = 1LL << 30;
+    Address max_size = std::max<Address>(1, memory_size / count);
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "VERIFICACION DE MEMORIA DISPERSA - Memoria: " << memory_size << " | Procesos: " << count
+             << " | Tamanos: 1-" << max_size << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(14) << "Algoritmo" << std::setw(12) << "Bloques" << std::setw(10) << "Fallos"
+             << std::setw(16) << "Pico heap MiB" << std::setw(14) << "Bytes/bloque" << std::setw(10) << "Segundos"
+             << "Resultado\n";
+    std::cout << std::string(78, '-') << "\n";
+    
+    bool all_ok = true;
+    std::string problem;
+    for (AllocationAlgorithm algorithm : {AllocationAlgorithm::FIRST_FIT, AllocationAlgorithm::BEST_FIT,
+                                          AllocationAlgorithm::WORST_FIT, AllocationAlgorithm::NEXT_FIT,
+                                          AllocationAlgorithm::TLSF, AllocationAlgorithm::ADAPTIVE}) {
+        reset_heap_peak();
+        long long baseline = heap_bytes_in_use();
+        auto started = std::chrono::steady_clock::now();
+        
+        long long failures = 0;
+        size_t blocks = 0;
+        bool ok;
+        {
+            DynamicMemoryManager<SizeOrderedIndex> manager(memory_size, algorithm);
+            XorShift64 rng(1);
+            std::string name;
+            Address start, size;
+            auto allocate = [&](char prefix, int i, Address limit) {
+                name = prefix + std::to_string(i);
+                Address request = 1 + static_cast<Address>(rng.next() % static_cast<uint64_t>(limit));
+                failures += manager.try_allocate(name, request, start) == OpStatus::OK ? 0 : 1;
+            };
+            for (int i = 0; i < count; i++) {
+                allocate('P', i, max_size);
+            }
+            for (int i = 0; i < count; i += 2) {
+                name = "P" + std::to_string(i);
+                failures += manager.try_deallocate(name, start, size) == OpStatus::OK ? 0 : 1;
+            }
+            for (int i = 0; i < std::max(1, count / 10000); i++) {
+                allocate('Q', i, std::max<Address>(1, max_size / 2));
+            }
+            blocks = manager.blocks().size();
+            ok = manager.check_invariants(problem);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        long long peak = heap_bytes_peak() - baseline;
+        
+        ok = ok && failures == 0 && peak <= MAX_PEAK_BYTES;
+        all_ok = all_ok && ok;
+        std::cout << std::left << std::setw(14) << algorithm_display_name(algorithm) << std::setw(12) << blocks
+                 << std::setw(10) << failures << std::fixed << std::setprecision(1) << std::setw(16)
+                 << peak / 1048576.0 << std::setw(14) << (blocks > 0 ? static_cast<double>(peak) / blocks : 0.0)
+                 << std::setprecision(2) << std::setw(10) << seconds << (ok ? "OK" : "FALLO") << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+        if (!problem.empty()) {
+            std::cout << "  " << problem << "\n";
+            problem.clear();
+        }
+    }
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Limite del pico de heap: " << MAX_PEAK_BYTES / 1048576 << " MiB por algoritmo\n";
+    return all_ok;
+}
+
+// Prueba diferencial aleatoria de los gestores con verificación de invariantes
+bool run_fuzz_report(const FuzzConfig& config) {
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "PRUEBA DIFERENCIAL - Memoria: " << config.total_memory << " | Operaciones por corrida: " 
+             << config.operations << " | Semilla: " << config.seed << "\n";
+    std::cout << "Referencia: recorrido lineal | Tamanos: 1-" << config.max_size << " | Nombres: " << config.names
+             << " | Completa cada " << config.check_every << " op\n";
+    if (!config.layout.is_exact()) {
+        std::cout << "Bloques: alineacion " << config.layout.alignment << ", cabecera " << config.layout.header
+                 << ", corte minimo " << config.layout.min_split << "\n";
+    }
+    if (config.quick.enabled()) {
+        std::cout << "Listas rapidas: tamanos hasta " << config.quick.max_size << ", " << config.quick.depth
+                 << " bloques por lista, tope " << config.quick.max_cached_percent << "% de la memoria\n";
+    }
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(16) << "Corrida" << std::setw(14) << "Operaciones" << std::setw(18)
+             << "Verif. completas" << std::setw(16) << "Ops/s" << "Resultado\n";
+    std::cout << std::string(78, '-') << "\n";
+    
+    bool all_ok = true;
+    std::vector<FuzzResult> results = run_fuzz_suite(config);
+    for (const auto& result : results) {
+        all_ok = all_ok && !result.failed;
+        std::cout << std::left << std::setw(16) << result.label << std::setw(14) << result.operations 
+                 << std::setw(18) << result.checks << std::setw(16) << std::fixed << std::setprecision(0)
+                 << (result.seconds > 0 ? result.operations / result.seconds : 0.0) 
+                 << (result.failed ? "FALLO" : "OK") << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    for (const auto& result : results) {
+        if (result.failed) {
+            std::cout << "\n" << result.label << " - operacion " << result.failed_operation << " en " 
+                     << result.backend << ":\n  " << result.problem << "\n";
+        }
+    }
+    std::cout << std::string(78, '=') << "\n";
+    if (!all_ok) {
+        std::cout << "Reproducir con --seed=" << config.seed << " --ops=" << config.operations << "\n";
+    }
+    return all_ok;
+}
+
+// Verificación de un registro de decisiones contra la reproducción de la traza
+bool run_decision_verification(const std::string& log_file, const std::string& trace_file, bool linear) {
+    DecisionVerifier verifier(log_file);
+    if (!verifier.valid()) {
+        std::cout << "Error: '" << log_file << "' no es un registro de decisiones valido\n";
+        return false;
+    }
+    std::ifstream trace(trace_file);
+    if (!trace.is_open()) {
+        std::cout << "Error: No se pudo abrir el archivo '" << trace_file << "'\n";
+        return false;
+    }
+    
+    double seconds = linear ? verify_decisions<LinearScanIndex>(trace, verifier)
+                            : verify_decisions<SizeOrderedIndex>(trace, verifier);
+    
+    // Descripción breve de una decisión para el reporte de diferencias
+    auto describe = [](const DecisionRecord& record) {
+        std::ostringstream text;
+        text << "#" << record.sequence << " " << static_cast<char>(record.op) << " tamano " << record.size 
+             << " inicio " << record.start << " hueco " << record.hole_size << " " 
+             << op_status_name(static_cast<OpStatus>(record.status));
+        if (record.algorithm != DecisionRecord::NO_ALGORITHM) {
+            text << " (" << algorithm_display_name(static_cast<AllocationAlgorithm>(record.algorithm)) << ")";
+        }
+        return text.str();
+    };
+    
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "VERIFICACION DE DECISIONES - Registro: " << log_file << " | Traza: " << trace_file << "\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Memoria: " << verifier.header().total_memory << " | Algoritmo inicial: " 
+             << algorithm_display_name(static_cast<AllocationAlgorithm>(verifier.header().algorithm))
+             << " | Indice: " << (linear ? "recorrido lineal (referencia)" : "ordenado por tamano") << "\n";
+    if (verifier.header().alignment != 1 || verifier.header().min_split != 1 || verifier.header().header != 0) {
+        std::cout << "Bloques: alineacion " << verifier.header().alignment << ", cabecera " << verifier.header().header
+                 << ", corte minimo " << verifier.header().min_split << "\n";
+    }
+    if (verifier.header().quick_max_size > 0) {
+        std::cout << "Listas rapidas: tamanos hasta " << verifier.header().quick_max_size << ", "
+                 << verifier.header().quick_depth << " bloques por lista, tope "
+                 << verifier.header().quick_max_cached_percent << "% de la memoria\n";
+    }
+    std::cout << "Decisiones comparadas: " << verifier.compared << " | Distintas: " << verifier.mismatches 
+             << " | Registros sin reproducir: " << verifier.extra_records << "\n";
+    std::cout << "Sondas: registro " << verifier.logged_probes << ", reproduccion " << verifier.replayed_probes << "\n";
+    std::cout << "Tiempo de reproduccion: " << std::fixed << std::setprecision(3) << seconds << " s ("
+             << std::setprecision(1) << (verifier.compared > 0 ? seconds * 1e9 / verifier.compared : 0.0) 
+             << " ns/op)\n";
+    std::cout.unsetf(std::ios::floatfield);
+    
+    if (!verifier.first_mismatches.empty()) {
+        std::cout << "\nPrimeras diferencias:\n";
+        for (const auto& mismatch : verifier.first_mismatches) {
+            std::cout << "  Linea " << mismatch.line_number << ":\n";
+            std::cout << "    registrada: " << (mismatch.missing ? "(fin del registro)" : describe(mismatch.expected)) << "\n";
+            std::cout << "    obtenida:   " << describe(mismatch.actual) << "\n";
+        }
+    }
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Resultado: " << (verifier.passed() ? "OK, decisiones identicas" : "FALLO") << "\n";
+    return verifier.passed();
+}
+
+#ifdef __linux__
+// Servidor en ejecución, para detenerlo con Ctrl+C (--serve)
+AllocatorServer<DynamicMemoryManager<SizeOrderedIndex>>* active_server = nullptr;
+
+void stop_active_server(int) {
+    if (active_server != nullptr) {
+        active_server->stop();
+    }
+}
+
+void show_server_stats(const ServerStats& stats) {
+    std::cout << "Servidor: " << stats.connections << " conexiones, " << stats.requests << " peticiones en "
+             << stats.reads << " lecturas (" << std::fixed << std::setprecision(1)
+             << (stats.reads > 0 ? static_cast<double>(stats.requests) / stats.reads : 0.0)
+             << " por lectura, maximo " << stats.max_batch << "), " << stats.writes << " escrituras\n";
+    std::cout.unsetf(std::ios::floatfield);
+    if (stats.stalled_reads > 0) {
+        std::cout << "Lecturas suspendidas por respuestas sin recibir: " << stats.stalled_reads << "\n";
+    }
+    if (stats.oversized_lines > 0) {
+        std::cout << "Conexiones cortadas por lineas demasiado largas: " << stats.oversized_lines << "\n";
+    }
+}
+
+// Una fila por corrida del generador de carga; false si hubo respuestas ilegibles o
+// fuera de orden, o si se cortó una conexión
+bool show_load_report(const std::string& label, const LoadConfig& config, const LoadReport& report) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::setw(10) << report.requests
+             << std::setw(12) << std::fixed << std::setprecision(0) << report.throughput() << std::setprecision(1)
+             << std::setw(10) << report.latency.p50 / 1000.0 << std::setw(10) << report.latency.p99 / 1000.0
+             << std::setw(10) << report.latency.max / 1000.0 << std::setw(9) << report.no_memory << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+    bool ok = report.problem.empty() && report.bad_replies == 0 && report.errors == 0 &&
+              report.requests == static_cast<long long>(config.connections) * config.ops;
+    if (!report.problem.empty()) {
+        std::cout << "  Error: " << report.problem << "\n";
+    }
+    if (report.bad_replies > 0 || report.errors > 0) {
+        std::cout << "  Respuestas fuera de orden o ilegibles: " << report.bad_replies << ", otros errores: "
+                 << report.errors << "\n";
+    }
+    return ok;
+}
+
+void show_load_header(const std::string& target, const LoadConfig& config) {
+    std::cout << "\n" << std::string(78, '=') << "\n";
+    std::cout << "GENERADOR DE CARGA - Socket: " << target << " | Conexiones: " << config.connections
+             << " | Peticiones por conexion: " << config.ops << "\n";
+    std::cout << "55% A de 1-" << config.max_size << " unidades, 44% L, 1% S; latencia en microsegundos\n";
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << std::left << std::setw(22) << "Corrida" << std::right << std::setw(10) << "Peticiones"
+             << std::setw(12) << "Pet./s" << std::setw(10) << "p50 us" << std::setw(10) << "p99 us"
+             << std::setw(10) << "max us" << std::setw(9) << "Sin mem." << "\n";
+    std::cout << std::string(78, '-') << "\n";
+}
+
+// Servidor en un hilo sobre un socket temporal y la misma carga sin pipelining
+// (profundidad 1) y con `depth` peticiones en vuelo. Al final la memoria debe quedar
+// libre (cada cliente libera lo suyo) y el gestor íntegro.
+bool run_server_benchmark(Address memory_size, AllocationAlgorithm algorithm, LoadConfig config) {
+    DynamicMemoryManager<SizeOrderedIndex> manager(memory_size, algorithm);
+    AllocatorServer<DynamicMemoryManager<SizeOrderedIndex>> server(manager);
+    std::string path = (std::filesystem::temp_directory_path() / ("memsim-" + std::to_string(getpid()) + ".sock")).string();
+    std::string problem = server.listen_on(path);
+    if (!problem.empty()) {
+        std::cout << "Error: " << problem << "\n";
+        return false;
+    }
+    ServerStats stats;
+    std::thread serving([&]() { stats = server.run(); });
+    
+    show_load_header(path, config);
+    bool all_ok = true;
+    int depth = config.depth;
+    for (int run_depth : {1, depth}) {
+        config.depth = run_depth;
+        config.prefix = "d" + std::to_string(run_depth) + "c";
+        LoadReport report = run_load_generator(path, config);
+        all_ok = show_load_report("Profundidad " + std::to_string(run_depth), config, report) && all_ok;
+    }
+    problem = shutdown_server(path);
+    serving.join();
+    std::cout << std::string(78, '-') << "\n";
+    show_server_stats(stats);
+    
+    std::string invariant;
+    if (!problem.empty() || !manager.check_invariants(invariant) || manager.get_counters().used_memory != 0) {
+        std::cout << "Error: " << (!problem.empty() ? problem : !invariant.empty() ? invariant
+                                                            : "quedo memoria asignada tras liberar todo") << "\n";
+        all_ok = false;
+    }
+    std::cout << std::string(78, '=') << "\n";
+    std::cout << "Resultado: " << (all_ok ? "OK" : "FALLO") << "\n";
+    return all_ok;
+}
+#endif
+
 void show_usage(const char* program_name) {
     std::cout << "Uso: " << program_name << " [tamano_memoria] [algoritmo] [archivo_entrada]\n";
     std::cout << "\nParametros (todos opcionales para modo interactivo):\n";
     std::cout << "  tamano_memoria  : Tamano total de memoria (minimo 100)\n";
-    std::cout << "  algoritmo       : 1=First Fit, 2=Best Fit, 3=Worst Fit\n";
+    std::cout << "  algoritmo       : 1=First Fit, 2=Best Fit, 3=Worst Fit, 4=Next Fit, 5=TLSF, 6=Adaptativo\n";
     std::cout << "  archivo_entrada : (Opcional) Archivo con comandos a ejecutar\n";
+    std::cout << "\nOpciones:\n";
+    std::cout << "  --format=text|json|csv : Formato de salida (json/csv emiten registros legibles por maquina)\n";
+    std::cout << "  --sample-ops=N         : Muestrear metricas cada N operaciones A/L\n";
+    std::cout << "  --sample-us=T          : Muestrear metricas cada T microsegundos\n";
+    std::cout << "  --sample-cap=C         : Capacidad del buffer circular de muestras (defecto 65536)\n";
+    std::cout << "  --sample-out=archivo   : Guardar las muestras al terminar (.bin = binario, otro = CSV)\n";
+    std::cout << "  --pipeline             : Reproducir archivos en pipeline (hilos de analisis, asignacion y reporte)\n";
+    std::cout << "  --analyze=archivo      : Perfil de la traza sin simular (no requiere tamano ni algoritmo)\n";
+    std::cout << "  --oracle=archivo       : Cotas offline de la memoria minima frente a los algoritmos en linea\n";
+    std::cout << "  --align=n              : Alinear el tamano de cada bloque ocupado a n unidades\n";
+    std::cout << "  --header=n             : Cabecera de n unidades por bloque ocupado\n";
+    std::cout << "  --min-split=n          : No dejar sobrantes libres menores a n (se entregan al proceso)\n";
+    std::cout << "  --quick=n              : Listas rapidas: aparcar sin fusionar los bloques liberados de hasta\n";
+    std::cout << "                           n unidades y entregarlos al siguiente A del mismo tamano\n";
+    std::cout << "  --quick-depth=n        : Bloques por lista rapida (defecto 8)\n";
+    std::cout << "  --quick-cap=p          : Consolidar las listas si superarian el p% de la memoria (defecto 25)\n";
+    std::cout << "  --decision-log=archivo : Registrar en binario la decision de cada A/L (inicio, hueco, sondas)\n";
+    std::cout << "\nPrueba diferencial (referencia lineal frente a los demas gestores):\n";
+    std::cout << "  --fuzz [memoria]       : Secuencias A/L aleatorias; tras cada operacion compara resultados\n";
+    std::cout << "                           y contadores con la referencia\n";
+    std::cout << "  --seed=n               : Semilla de la secuencia (defecto 1)\n";
+    std::cout << "  --check-every=n        : Verificacion completa cada n operaciones (defecto 64)\n";
+    std::cout << "  (usa --ops=n por corrida, defecto 1000000, y --max-request=n)\n";
+    std::cout << "\nVerificacion de decisiones (memoria y algoritmo salen del registro):\n";
+    std::cout << "  --verify-decisions=registro archivo_traza : Reproducir la traza y comparar cada decision\n";
+    std::cout << "  --index=linear|ordered                    : Indice de la reproduccion (defecto linear, la\n";
+    std::cout << "                                              referencia; el simulador registra con ordered)\n";
+    std::cout << "                                              (con el algoritmo 6 use ordered: decide con las\n";
+    std::cout << "                                              sondas que mide y estas cambian con el indice)\n";
+    std::cout << "\nModo concurrente (requiere tamano_memoria y algoritmo):\n";
+    std::cout << "  --concurrent                      : Hilos que emiten A/L contra un gestor compartido\n";
+    std::cout << "  --lock=global|striped|lockfree|arenas|all : Estrategia de sincronizacion (defecto all)\n";
+    std::cout << "  --threads=N                       : Maximo de hilos; se mide 1, 2, 4, ... N (defecto 64)\n";
+    std::cout << "  --ops=N                           : Operaciones por hilo (defecto 20000)\n";
+    std::cout << "  --stripes=K                       : Franjas de direcciones para 'striped' (defecto 16)\n";
+    std::cout << "  --arenas=K|cores                  : Arenas para 'arenas' (defecto una por hilo)\n";
+    std::cout << "  --max-request=N                   : Tamano maximo de las solicitudes grandes (defecto 256)\n";
+    std::cout << "\nBenchmark de despacho (requiere tamano_memoria y algoritmo; archivo opcional):\n";
+    std::cout << "  --bench-dispatch                  : Costo por operacion con switch por asignacion, despacho unico\n";
+    std::cout << "                                      y politica fija; sin archivo usa una carga sintetica\n";
+    std::cout << "  --ops=N                           : Operaciones de la carga sintetica (defecto 200000)\n";
+    std::cout << "  --max-request=N                   : Tamano maximo de cada solicitud sintetica\n";
+    std::cout << "\nReporte de latencia (todos los algoritmos sobre la misma carga):\n";
+    std::cout << "  --latency memoria [archivo]       : Percentiles y maximo de ns por operacion A/L y sondas de la\n";
+    std::cout << "                                      peor busqueda; sin archivo usa una carga sintetica\n";
+    std::cout << "                                      (--ops=N, defecto 200000, y --max-request=N)\n";
+    std::cout << "\nEvaluacion del algoritmo adaptativo (6) frente a cada politica fija:\n";
+    std::cout << "  --adaptive-eval [memoria]         : Fallos, sondas y fragmentacion de cada algoritmo en las\n";
+    std::cout << "                                      trazas de Test (con la memoria indicada, defecto 100) y\n";
+    std::cout << "                                      en cargas sinteticas de --ops=N A/L (defecto 200000)\n";
+    std::cout << "\nMemoria virtual paginada (no requiere tamano ni algoritmo):\n";
+    std::cout << "  --paging [archivo]                : Tablas de paginas por proceso, TLB y reemplazo; reproduce\n";
+    std::cout << "                                      A, L y T <proceso> <desplazamiento> del archivo, o sin\n";
+    std::cout << "                                      archivo una carga sintetica con localidad (--ops=N,\n";
+    std::cout << "                                      defecto 20000000 accesos)\n";
+    std::cout << "  --page-size=n                     : Unidades por pagina, potencia de 2 (defecto 64)\n";
+    std::cout << "  --frames=n                        : Marcos fisicos (defecto 64)\n";
+    std::cout << "  --tlb=n / --tlb-ways=n            : Entradas y vias de la TLB (defecto 16 y 4)\n";
+    std::cout << "  --replace=fifo|lru|clock          : Politica de reemplazo de paginas (defecto lru)\n";
+    std::cout << "\nSimulacion con tiempo (requiere tamano_memoria y algoritmo; archivo opcional):\n";
+    std::cout << "  --timed                           : Eventos en tiempo simulado: 'A P1 30 @t=5 dur=40' llega en\n";
+    std::cout << "                                      t=5 y se libera solo 40 despues; sin archivo usa una carga\n";
+    std::cout << "                                      sintetica (--ops=N llegadas, defecto 200000)\n";
+    std::cout << "  --probe-time=n                    : Tiempo simulado por bloque examinado al asignar (defecto 1)\n";
+    std::cout << "  --wait=fifo|smallest|bestfit      : (implica --timed) Los A sin hueco esperan en una cola y al\n";
+    std::cout << "                                      liberar se admite el mas antiguo, el menor o el mayor que\n";
+    std::cout << "                                      quepa; informa esperas y bloqueo en cabeza\n";
+    std::cout << "\nRamas del asignador (requiere tamano_memoria y algoritmo; archivo opcional):\n";
+    std::cout << "  --branch                          : Reproduce A, L, ALG y BRANCH/SWITCH/DROP <rama> sobre un\n";
+    std::cout << "                                      estado persistente (crear una rama es O(1)); sin archivo\n";
+    std::cout << "                                      abre 256 ramas desde un estado de --ops=N A/L (defecto\n";
+    std::cout << "                                      50000) y las compara con copias del gestor\n";
+    std::cout << "\nServidor en socket Unix (Linux; requiere tamano_memoria y algoritmo):\n";
+    std::cout << "  --serve=ruta                      : Atiende '<id> A <proceso> <tamano>', '<id> L <proceso>',\n";
+    std::cout << "                                      '<id> S', '<id> ALG <n>' y '<id> SHUTDOWN' de varios clientes\n";
+    std::cout << "                                      (epoll) con muchas peticiones en vuelo por conexion\n";
+    std::cout << "  --serve-bench                     : Servidor en un hilo y el generador de carga con profundidad\n";
+    std::cout << "                                      1 y --depth; verifica que la memoria quede libre\n";
+    std::cout << "  --load=ruta                       : Generador de carga contra un servidor en marcha: rendimiento\n";
+    std::cout << "                                      y latencia p50/p99/max (--ops=N por conexion, defecto 100000)\n";
+    std::cout << "  --connections=N / --depth=K       : Conexiones (defecto 4) y peticiones en vuelo (defecto 64)\n";
+    std::cout << "  --shutdown                        : (con --load) Detener el servidor al terminar\n";
+    std::cout << "\nVerificacion de reservas (requiere tamano_memoria y algoritmo):\n";
+    std::cout << "  --check-allocs                    : Cuenta las llamadas a operator new al reproducir A/L en\n";
+    std::cout << "                                      regimen estable; deben ser cero (defecto --ops=20000)\n";
+    std::cout << "\nVerificacion de memoria dispersa (no requiere algoritmo):\n";
+    std::cout << "  --big-heap [memoria]              : Heap de 2^40 unidades (o el indicado) con un millon de\n";
+    std::cout << "                                      procesos (--ops=N); verifica invariantes y que el pico\n";
+    std::cout << "                                      de heap dependa de los bloques, no de la memoria\n";
     std::cout << "\nModos de uso:\n";
     std::cout << "  " << program_name << "                       # Modo interactivo con seleccion dinamica\n";
     std::cout << "  " << program_name << " 200 1              # 200 unidades, First Fit, modo interactivo\n";
     std::cout << "  " << program_name << " 150 2 comandos.txt # 150 unidades, Best Fit, desde archivo\n";
+    std::cout << "  " << program_name << " --format=json 150 2 comandos.txt # Registros JSON (uno por linea)\n";
 }
 
-int main(int argc, char* argv[]) {
-    std::cout << "=== SIMULADOR DE GESTION DE MEMORIA - TAREA 2 ===\n\n";
+// Opciones de la línea de comandos. `positional` conserva argv[0] y los parámetros que
+// no son opciones (tamano de memoria, algoritmo, archivo)
+struct CommandLine {
+    OutputFormat output_format = OutputFormat::TEXT;
+    SamplingMode sampling_mode = SamplingMode::OFF;
+    long long sampling_interval = 0;
+    size_t sampling_capacity = MetricsSampler::DEFAULT_CAPACITY;
+    std::string sampling_output;
+    bool pipelined_replay = false;
+    bool concurrent_mode = false;
+    bool bench_dispatch = false;
+    bool latency_mode = false;
+    bool adaptive_eval = false;
+    bool paging_mode = false;
+    PagingConfig paging_config;
+    bool check_allocs = false;
+    bool big_heap = false;
+    bool timed_mode = false;
+    bool branch_mode = false;
+    std::string serve_path;   // --serve=ruta
+    std::string load_path;    // --load=ruta
+    bool serve_bench = false;
+    bool load_shutdown = false;
+    LoadConfig load_config;
+    TimedConfig timed_config;
+    std::string analyze_file;
+    std::string oracle_file;
+    std::string decision_log_file;
+    std::string verify_log_file;
+    bool verify_linear = true;
+    bool fuzz_mode = false;
+    BlockLayout block_layout;
+    QuickListConfig quick_lists;
+    FuzzConfig fuzz_config;
+    std::string concurrent_lock = "all";
+    int concurrent_threads = 64;
+    int concurrent_stripes = 16;
+    int concurrent_arenas = 0;
+    // --ops=N y --max-request=N los comparten varios modos; sin --ops cada modo usa su
+    // propio valor por defecto, indicado donde lo lee con ops_or
+    int ops = 0;
+    int max_request = 256;
+    std::vector<char*> positional;
     
-    // Modo interactivo para selección de parámetros si no se proporcionan argumentos suficientes
-    if (argc < 3) {
-        std::cout << "Modo interactivo de configuracion:\n\n";
-        
-        int memory_size;
-        std::cout << "Ingrese el tamano de memoria (minimo 100): ";
-        std::cin >> memory_size;
-        std::cin.ignore(); // Limpiar buffer
-        
-        if (memory_size < 100) {
-            std::cout << "Tamano minimo es 100. Usando 100 unidades.\n";
-            memory_size = 100;
-        }
-        
-        int algorithm_num;
-        std::cout << "Seleccione algoritmo de asignacion:\n";
-        std::cout << "1. First Fit\n";
-        std::cout << "2. Best Fit\n";
-        std::cout << "3. Worst Fit\n";
-        std::cout << "Opcion (1-3): ";
-        std::cin >> algorithm_num;
-        std::cin.ignore(); // Limpiar buffer
-        
-        AllocationAlgorithm algorithm;
-        switch (algorithm_num) {
-            case 1: algorithm = AllocationAlgorithm::FIRST_FIT; break;
-            case 2: algorithm = AllocationAlgorithm::BEST_FIT; break;
-            case 3: algorithm = AllocationAlgorithm::WORST_FIT; break;
-            default:
-                std::cout << "Algoritmo no valido. Usando First Fit por defecto.\n";
-                algorithm = AllocationAlgorithm::FIRST_FIT;
-                break;
+    int ops_or(int mode_default) const {
+        return ops > 0 ? ops : mode_default;
+    }
+};
+
+// Opciones de muestreo (--sample-*); devuelven false si `arg` no es de su grupo
+bool parse_sampling_option(const std::string& arg, CommandLine& options) {
+    if (arg.rfind("--sample-ops=", 0) == 0) {
+        options.sampling_mode = SamplingMode::OPERATIONS;
+        options.sampling_interval = std::atoll(arg.c_str() + 13);
+    } else if (arg.rfind("--sample-us=", 0) == 0) {
+        options.sampling_mode = SamplingMode::MICROSECONDS;
+        options.sampling_interval = std::atoll(arg.c_str() + 12);
+    } else if (arg.rfind("--sample-cap=", 0) == 0) {
+        options.sampling_capacity = static_cast<size_t>(std::atoll(arg.c_str() + 13));
+    } else if (arg.rfind("--sample-out=", 0) == 0) {
+        options.sampling_output = arg.substr(13);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Forma de los bloques y listas rápidas, comunes a los modos con gestor
+bool parse_layout_option(const std::string& arg, CommandLine& options) {
+    if (arg.rfind("--align=", 0) == 0) {
+        options.block_layout.alignment = std::max(1, std::atoi(arg.c_str() + 8));
+    } else if (arg.rfind("--min-split=", 0) == 0) {
+        options.block_layout.min_split = std::max(1, std::atoi(arg.c_str() + 12));
+    } else if (arg.rfind("--header=", 0) == 0) {
+        options.block_layout.header = std::max(0, std::atoi(arg.c_str() + 9));
+    } else if (arg.rfind("--quick=", 0) == 0) {
+        options.quick_lists.max_size = std::max(0, std::atoi(arg.c_str() + 8));
+    } else if (arg.rfind("--quick-depth=", 0) == 0) {
+        options.quick_lists.depth = std::max(1, std::atoi(arg.c_str() + 14));
+    } else if (arg.rfind("--quick-cap=", 0) == 0) {
+        options.quick_lists.max_cached_percent = std::min(100, std::max(1, std::atoi(arg.c_str() + 12)));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Registro y verificación de decisiones, oráculo, perfil de traza y prueba diferencial
+bool parse_verification_option(const std::string& arg, CommandLine& options) {
+    if (arg.rfind("--decision-log=", 0) == 0) {
+        options.decision_log_file = arg.substr(15);
+    } else if (arg.rfind("--verify-decisions=", 0) == 0) {
+        options.verify_log_file = arg.substr(19);
+    } else if (arg == "--index=linear" || arg == "--index=ordered") {
+        options.verify_linear = arg == "--index=linear";
+    } else if (arg.rfind("--oracle=", 0) == 0) {
+        options.oracle_file = arg.substr(9);
+    } else if (arg.rfind("--analyze=", 0) == 0) {
+        options.analyze_file = arg.substr(10);
+    } else if (arg == "--fuzz") {
+        options.fuzz_mode = true;
+    } else if (arg.rfind("--seed=", 0) == 0) {
+        options.fuzz_config.seed = std::strtoull(arg.c_str() + 7, nullptr, 10);
+    } else if (arg.rfind("--check-every=", 0) == 0) {
+        options.fuzz_config.check_every = std::max(1, std::atoi(arg.c_str() + 14));
+    } else if (arg == "--check-allocs") {
+        options.check_allocs = true;
+    } else if (arg == "--big-heap") {
+        options.big_heap = true;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Modo por tiempos, cola de espera y ramas
+bool parse_timed_option(const std::string& arg, CommandLine& options) {
+    if (arg == "--timed") {
+        options.timed_mode = true;
+    } else if (arg == "--branch") {
+        options.branch_mode = true;
+    } else if (arg.rfind("--probe-time=", 0) == 0) {
+        options.timed_config.probe_time = std::max(0LL, std::atoll(arg.c_str() + 13));
+    } else if (arg == "--wait=fifo" || arg == "--wait=smallest" || arg == "--wait=bestfit") {
+        options.timed_mode = true;
+        options.timed_config.wait = true;
+        options.timed_config.admission = arg == "--wait=fifo" ? AdmissionPolicy::FIFO
+                                       : arg == "--wait=smallest" ? AdmissionPolicy::SMALLEST_FIRST
+                                                                  : AdmissionPolicy::BEST_FIT_FIRST;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Servidor y generador de carga
+bool parse_server_option(const std::string& arg, CommandLine& options) {
+    if (arg.rfind("--serve=", 0) == 0) {
+        options.serve_path = arg.substr(8);
+    } else if (arg.rfind("--load=", 0) == 0) {
+        options.load_path = arg.substr(7);
+    } else if (arg == "--serve-bench") {
+        options.serve_bench = true;
+    } else if (arg.rfind("--connections=", 0) == 0) {
+        options.load_config.connections = std::max(1, std::atoi(arg.c_str() + 14));
+    } else if (arg.rfind("--depth=", 0) == 0) {
+        options.load_config.depth = std::max(1, std::atoi(arg.c_str() + 8));
+    } else if (arg == "--shutdown") {
+        options.load_shutdown = true;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Memoria virtual paginada
+bool parse_paging_option(const std::string& arg, CommandLine& options) {
+    if (arg == "--paging") {
+        options.paging_mode = true;
+    } else if (arg.rfind("--page-size=", 0) == 0) {
+        options.paging_config.page_size = std::atoi(arg.c_str() + 12);
+    } else if (arg.rfind("--frames=", 0) == 0) {
+        options.paging_config.frames = std::atoi(arg.c_str() + 9);
+    } else if (arg.rfind("--tlb=", 0) == 0) {
+        options.paging_config.tlb_entries = std::atoi(arg.c_str() + 6);
+    } else if (arg.rfind("--tlb-ways=", 0) == 0) {
+        options.paging_config.tlb_ways = std::atoi(arg.c_str() + 11);
+    } else if (arg == "--replace=fifo" || arg == "--replace=lru" || arg == "--replace=clock") {
+        options.paging_config.policy = arg == "--replace=fifo" ? ReplacementPolicy::FIFO
+                                     : arg == "--replace=lru" ? ReplacementPolicy::LRU : ReplacementPolicy::CLOCK;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Modo concurrente
+bool parse_concurrent_option(const std::string& arg, CommandLine& options) {
+    if (arg == "--concurrent") {
+        options.concurrent_mode = true;
+    } else if (arg.rfind("--lock=", 0) == 0) {
+        options.concurrent_lock = arg.substr(7);
+    } else if (arg.rfind("--threads=", 0) == 0) {
+        options.concurrent_threads = std::max(1, std::atoi(arg.c_str() + 10));
+    } else if (arg.rfind("--stripes=", 0) == 0) {
+        options.concurrent_stripes = std::max(1, std::atoi(arg.c_str() + 10));
+    } else if (arg.rfind("--arenas=", 0) == 0) {
+        std::string value = arg.substr(9);
+        options.concurrent_arenas = value == "cores" ? static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))
+                                                     : std::max(0, std::atoi(value.c_str()));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Separar las opciones (--format=..., --sample-...) de los parámetros posicionales.
+// Devuelve false, tras mostrar el error, si alguna opción no es válida.
+bool parse_command_line(int argc, char* argv[], CommandLine& options) {
+    options.positional = {argv[0]};
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--format=", 0) == 0) {
+            if (!parse_output_format(arg.substr(9), options.output_format)) {
+                std::cout << "Error: Formato no valido '" << arg.substr(9) << "'. Use text, json o csv\n";
+                show_usage(argv[0]);
+                return false;
+            }
+        } else if (parse_sampling_option(arg, options) || parse_layout_option(arg, options) ||
+                   parse_verification_option(arg, options) || parse_timed_option(arg, options) ||
+                   parse_server_option(arg, options) || parse_paging_option(arg, options) ||
+                   parse_concurrent_option(arg, options)) {
+            continue;
+        } else if (arg == "--bench-dispatch") {
+            options.bench_dispatch = true;
+        } else if (arg == "--latency") {
+            options.latency_mode = true;
+        } else if (arg == "--adaptive-eval") {
+            options.adaptive_eval = true;
+        } else if (arg == "--pipeline") {
+            options.pipelined_replay = true;
+        } else if (arg.rfind("--ops=", 0) == 0) {
+            options.ops = std::max(1, std::atoi(arg.c_str() + 6));
+        } else if (arg.rfind("--max-request=", 0) == 0) {
+            options.max_request = std::max(1, std::atoi(arg.c_str() + 14));
+        } else {
+            options.positional.push_back(argv[i]);
         }
-        
-        std::cout << "\nDesea cargar comandos desde un archivo? (s/n): ";
-        std::string load_file;
-        std::getline(std::cin, load_file);
-        
-        std::string input_file;
-        if (load_file == "s" || load_file == "S" || load_file == "si" || load_file == "SI") {
-            input_file = select_test_file();
+    }
+    return true;
+}
+
+// Prueba diferencial: referencia lineal frente a los demás gestores, con invariantes
+int run_fuzz_mode(const CommandLine& options, int argc, char* argv[]) {
+    if (argc > 2) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    FuzzConfig config = options.fuzz_config;
+    if (argc == 2) {
+        config.total_memory = std::atoll(argv[1]);
+    }
+    if (config.total_memory <= 0) {
+        std::cout << "Error: El tamano de memoria debe ser positivo\n";
+        return 1;
+    }
+    config.operations = options.ops_or(1000000); // por corrida
+    config.max_size = options.max_request;
+    config.layout = options.block_layout;
+    config.quick = options.quick_lists;
+    return run_fuzz_report(config) ? 0 : 2;
+}
+
+// Memoria dispersa de 2^40 unidades: el costo depende de los bloques, no del tamano
+int run_big_heap_mode(const CommandLine& options, int argc, char* argv[]) {
+    Address memory_size = argc == 2 ? std::atoll(argv[1]) : 1LL << 40;
+    if (argc > 2 || memory_size <= 0 || memory_size > MAX_TOTAL_MEMORY) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    int processes = options.ops_or(1000000);
+    return run_big_heap_check(memory_size, processes) ? 0 : 2;
+}
+
+// Memoria virtual paginada: traza A/L/T o carga sintética
+int run_paging_mode(const CommandLine& options, int argc, char* argv[]) {
+    std::string problem = options.paging_config.validate();
+    if (argc > 2 || !problem.empty()) {
+        if (!problem.empty()) {
+            std::cout << "Error: " << problem << "\n";
         }
-        
-        std::cout << "\nConfiguracion:\n";
-        std::cout << "- Memoria: " << memory_size << " unidades\n";
-        
-        switch (algorithm) {
-            case AllocationAlgorithm::FIRST_FIT: std::cout << "- Algoritmo: First Fit\n"; break;
-            case AllocationAlgorithm::BEST_FIT: std::cout << "- Algoritmo: Best Fit\n"; break;
-            case AllocationAlgorithm::WORST_FIT: std::cout << "- Algoritmo: Worst Fit\n"; break;
+        show_usage(argv[0]);
+        return 1;
+    }
+    RecordWriter records(std::cout, options.output_format);
+    PagedMemory memory(options.paging_config);
+    if (argc == 2) {
+        std::ifstream file(argv[1]);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << argv[1] << "'\n";
+            return 1;
         }
-        
-        if (!input_file.empty()) {
-            std::cout << "- Archivo de entrada: " << input_file << "\n";
+        PagingRun run = replay_paging_trace(file, memory);
+        return show_paging_report(records, argv[1], memory, run) ? 0 : 2;
+    }
+    int accesses = options.ops_or(20000000);
+    PagingRun run = run_synthetic_paging(memory, 32, accesses, 1);
+    return show_paging_report(records, "carga sintetica", memory, run) ? 0 : 2;
+}
+
+// Latencia por operación de cada algoritmo, con sus peores casos
+int run_latency_mode(const CommandLine& options, int argc, char* argv[]) {
+    if (argc < 2 || argc > 3 || std::atoll(argv[1]) <= 0) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    std::vector<ReplayOp> ops;
+    if (argc == 3) {
+        std::ifstream file(argv[2]);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << argv[2] << "'\n";
+            return 1;
         }
-        std::cout << "\n";
-        
-        // Crear simulador
-        MemorySimulator simulator(memory_size, algorithm);
-        
-        // Si hay archivo de entrada, ejecutarlo primero
-        if (!input_file.empty()) {
-            std::ifstream file(input_file);
-            if (!file.is_open()) {
-                std::cout << "Error: No se pudo abrir el archivo '" << input_file << "'\n";
-                std::cout << "Continuando en modo interactivo...\n\n";
-            } else {
-                std::string line;
-                int line_number = 0;
-                std::cout << "Ejecutando comandos desde '" << input_file << "'...\n\n";
-                
-                while (std::getline(file, line)) {
-                    line_number++;
-                    
-                    // Ignorar líneas vacías y comentarios
-                    if (line.empty() || line[0] == '#') {
-                        continue;
-                    }
-                    
-                    std::cout << "[Linea " << line_number << "] " << line << "\n";
-                    simulator.process_command(line);
-                    std::cout << "\n";
-                }
-                
-                file.close();
-                std::cout << "=== Ejecucion del archivo completada ===\n\n";
-                std::cout << "Continuando en modo interactivo...\n\n";
-            }
+        ops = load_replay_ops(file);
+    } else {
+        ops = synthetic_replay_ops(options.ops_or(200000), options.max_request, 1);
+    }
+    run_latency_report<SizeOrderedIndex>(std::atoll(argv[1]), ops, 3);
+    return 0;
+}
+
+#ifdef __linux__
+// Generador de carga contra un servidor ya en marcha (--serve en otro proceso)
+int run_load_mode(const CommandLine& options, int argc, char* argv[]) {
+    if (argc > 1) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    LoadConfig config = options.load_config;
+    config.ops = options.ops_or(config.ops); // por conexión, 100000 en LoadConfig
+    config.max_size = options.max_request;
+    show_load_header(options.load_path, config);
+    bool ok = show_load_report("Profundidad " + std::to_string(config.depth), config,
+                               run_load_generator(options.load_path, config));
+    if (options.load_shutdown) {
+        std::string problem = shutdown_server(options.load_path);
+        if (!problem.empty()) {
+            std::cout << "Error: " << problem << "\n";
+            ok = false;
         }
-        
-        // Ejecutar modo interactivo
-        simulator.run();
-        
+    }
+    std::cout << std::string(78, '=') << "\n";
+    return ok ? 0 : 2;
+}
+#endif
+
+// Adaptativo frente a cada política fija: trazas de Test y cargas sintéticas grandes
+int run_adaptive_eval_mode(const CommandLine& options, int argc, char* argv[]) {
+    Address memory_size = argc == 2 ? std::atoll(argv[1]) : 100;
+    if (argc > 2 || memory_size <= 0 || memory_size > MAX_TOTAL_MEMORY) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    std::vector<AdaptiveScenario> scenarios;
+    std::vector<std::string> files = list_test_files();
+    std::sort(files.begin(), files.end());
+    for (const auto& name : files) {
+        std::ifstream file("../../Test/" + name);
+        std::vector<ReplayOp> ops = load_replay_ops(file);
+        if (!ops.empty()) {
+            scenarios.push_back({name, memory_size, std::move(ops)});
+        }
+    }
+    // Cargas grandes: la de --latency, que llena la memoria, y tres en régimen estable
+    // con la demanda viva al 85%, una de ellas con fases de tamanos distintos
+    int count = options.ops_or(200000); // A/L por carga
+    scenarios.push_back({"sintetica, tamanos 1-256", 20000, synthetic_replay_ops(count, 256, 1)});
+    const struct { Address memory; int max_size; int phase_length; } steady[] = {
+        {20000, 256, 0}, {100000, 2048, 0}, {100000, 2048, count / 12}};
+    for (const auto& load : steady) {
+        scenarios.push_back({"estable, tamanos 1-" + std::to_string(load.max_size) +
+                                 (load.phase_length > 0 ? ", por fases" : ""),
+                             load.memory,
+                             steady_replay_ops(count, load.memory * 85 / 100, load.max_size, load.phase_length, 1)});
+    }
+    RecordWriter records(std::cout, options.output_format);
+    show_adaptive_evaluation(records, scenarios);
+    return 0;
+}
+
+// Configura el simulador (muestreo, forma de bloques, listas rápidas) y abre el
+// registro de decisiones (--decision-log), que queda en `decision_log`
+bool prepare_simulator(MemorySimulator& simulator, const CommandLine& options, Address memory_size,
+                       AllocationAlgorithm algorithm, std::unique_ptr<DecisionLogWriter>& decision_log) {
+    simulator.set_pipelined(options.pipelined_replay);
+    if (options.sampling_mode != SamplingMode::OFF) {
+        simulator.get_sampler().configure(options.sampling_mode, options.sampling_interval, options.sampling_capacity);
+    }
+    simulator.set_layout(options.block_layout);
+    simulator.set_quick_lists(options.quick_lists);
+    if (options.decision_log_file.empty()) {
+        return true;
+    }
+    decision_log = std::make_unique<DecisionLogWriter>(options.decision_log_file, memory_size, algorithm,
+                                                       options.block_layout, options.quick_lists);
+    if (!decision_log->is_open()) {
+        std::cerr << "Error: No se pudo escribir el archivo '" << options.decision_log_file << "'\n";
+        return false;
+    }
+    simulator.set_decision_sink(decision_log.get());
+    return true;
+}
+
+// Guarda las muestras al terminar (--sample-out)
+int finish_sampling(MemorySimulator& simulator, const CommandLine& options) {
+    if (!options.sampling_output.empty() && simulator.get_sampler().enabled()) {
+        bool binary = fs::path(options.sampling_output).extension() == ".bin";
+        if (!simulator.get_sampler().save(options.sampling_output, binary)) {
+            std::cerr << "Error: No se pudo escribir el archivo '" << options.sampling_output << "'\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Modo interactivo para selección de parámetros si no se proporcionan argumentos suficientes
+int run_interactive_setup(const CommandLine& options) {
+    std::cout << "Modo interactivo de configuracion:\n\n";
+    
+    Address memory_size;
+    std::cout << "Ingrese el tamano de memoria (minimo 100): ";
+    std::cin >> memory_size;
+    std::cin.ignore(); // Limpiar buffer
+    
+    if (memory_size < 100) {
+        std::cout << "Tamano minimo es 100. Usando 100 unidades.\n";
+        memory_size = 100;
+    }
+    if (memory_size > MAX_TOTAL_MEMORY) {
+        std::cout << "Tamano maximo es " << MAX_TOTAL_MEMORY << ". Usando " << MAX_TOTAL_MEMORY << " unidades.\n";
+        memory_size = MAX_TOTAL_MEMORY;
+    }
+    
+    int algorithm_num;
+    std::cout << "Seleccione algoritmo de asignacion:\n";
+    std::cout << "1. First Fit\n";
+    std::cout << "2. Best Fit\n";
+    std::cout << "3. Worst Fit\n";
+    std::cout << "4. Next Fit\n";
+    std::cout << "5. TLSF\n";
+    std::cout << "6. Adaptativo (First/Best/Worst Fit segun lo medido)\n";
+    std::cout << "Opcion (1-6): ";
+    std::cin >> algorithm_num;
+    std::cin.ignore(); // Limpiar buffer
+    
+    AllocationAlgorithm algorithm;
+    switch (algorithm_num) {
+        case 1: algorithm = AllocationAlgorithm::FIRST_FIT; break;
+        case 2: algorithm = AllocationAlgorithm::BEST_FIT; break;
+        case 3: algorithm = AllocationAlgorithm::WORST_FIT; break;
+        case 4: algorithm = AllocationAlgorithm::NEXT_FIT; break;
+        case 5: algorithm = AllocationAlgorithm::TLSF; break;
+        case 6: algorithm = AllocationAlgorithm::ADAPTIVE; break;
+        default:
+            std::cout << "Algoritmo no valido. Usando First Fit por defecto.\n";
+            algorithm = AllocationAlgorithm::FIRST_FIT;
+            break;
+    }
+    
+    std::cout << "\nDesea cargar comandos desde un archivo? (s/n): ";
+    std::string load_file;
+    std::getline(std::cin, load_file);
+    
+    std::string input_file;
+    if (load_file == "s" || load_file == "S" || load_file == "si" || load_file == "SI") {
+        input_file = select_test_file();
+    }
+    
+    std::cout << "\nConfiguracion:\n";
+    std::cout << "- Memoria: " << memory_size << " unidades\n";
+    
+    switch (algorithm) {
+        case AllocationAlgorithm::FIRST_FIT: std::cout << "- Algoritmo: First Fit\n"; break;
+        case AllocationAlgorithm::BEST_FIT: std::cout << "- Algoritmo: Best Fit\n"; break;
+        case AllocationAlgorithm::WORST_FIT: std::cout << "- Algoritmo: Worst Fit\n"; break;
+        case AllocationAlgorithm::NEXT_FIT: std::cout << "- Algoritmo: Next Fit\n"; break;
+        case AllocationAlgorithm::TLSF: std::cout << "- Algoritmo: TLSF\n"; break;
+        case AllocationAlgorithm::ADAPTIVE: std::cout << "- Algoritmo: Adaptativo\n"; break;
+    }
+    
+    if (!input_file.empty()) {
+        std::cout << "- Archivo de entrada: " << input_file << "\n";
+    }
+    std::cout << "\n";
+    
+    // Crear simulador
+    MemorySimulator simulator(memory_size, algorithm, options.output_format);
+    std::unique_ptr<DecisionLogWriter> decision_log;
+    if (!prepare_simulator(simulator, options, memory_size, algorithm, decision_log)) {
+        return 1;
+    }
+    
+    // Si hay archivo de entrada, ejecutarlo primero
+    if (!input_file.empty()) {
+        std::ifstream file(input_file);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << input_file << "'\n";
+            std::cout << "Continuando en modo interactivo...\n\n";
+        } else {
+            std::cout << "Ejecutando comandos desde '" << input_file << "'...\n\n";
+            simulator.replay(file);
+            file.close();
+            std::cout << "=== Ejecucion del archivo completada ===\n\n";
+            std::cout << "Continuando en modo interactivo...\n\n";
+        }
+    }
+    
+    // Ejecutar modo interactivo
+    simulator.run();
+    
+    return finish_sampling(simulator, options);
+}
+
+// Costo por operación del despacho de la política, sobre la traza o una carga sintética
+int run_dispatch_mode(const CommandLine& options, Address memory_size, AllocationAlgorithm algorithm,
+                      const std::string& input_file) {
+    std::vector<ReplayOp> ops;
+    if (!input_file.empty()) {
+        std::ifstream file(input_file);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << input_file << "'\n";
+            return 1;
+        }
+        ops = load_replay_ops(file);
+    } else {
+        ops = synthetic_replay_ops(options.ops_or(200000), options.max_request, 1);
+    }
+    return run_dispatch_benchmark<SizeOrderedIndex>(memory_size, algorithm, ops, 5) ? 0 : 2;
+}
+
+// Llegadas y duraciones por tiempo, con la cola de espera si se pidió --wait
+int run_timed_mode(const CommandLine& options, Address memory_size, AllocationAlgorithm algorithm,
+                   const std::string& input_file) {
+    RecordWriter records(std::cout, options.output_format);
+    long long ignored = 0;
+    std::vector<TimedRequest> requests;
+    if (!input_file.empty()) {
+        std::ifstream file(input_file);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << input_file << "'\n";
+            return 1;
+        }
+        requests = load_timed_requests(file, ignored);
+    } else {
+        int arrivals = options.ops_or(200000);
+        requests = synthetic_timed_requests(arrivals, options.max_request, memory_size, 1);
+    }
+    return show_timed_report(records, input_file.empty() ? "carga sintetica" : input_file, memory_size, algorithm,
+                             options.block_layout, options.quick_lists, requests, ignored, options.timed_config) ? 0 : 2;
+}
+
+#ifdef __linux__
+// Servidor (--serve) o servidor con el generador de carga en el mismo proceso (--serve-bench)
+int run_server_mode(const CommandLine& options, Address memory_size, AllocationAlgorithm algorithm) {
+    if (options.serve_bench) {
+        LoadConfig config = options.load_config;
+        config.ops = options.ops_or(config.ops); // por conexión, 100000 en LoadConfig
+        config.max_size = options.max_request;
+        return run_server_benchmark(memory_size, algorithm, config) ? 0 : 2;
+    }
+    DynamicMemoryManager<SizeOrderedIndex> manager(memory_size, algorithm);
+    manager.set_layout(options.block_layout);
+    manager.set_quick_lists(options.quick_lists);
+    AllocatorServer<DynamicMemoryManager<SizeOrderedIndex>> server(manager);
+    std::string problem = server.listen_on(options.serve_path);
+    if (!problem.empty()) {
+        std::cout << "Error: " << problem << "\n";
+        return 1;
+    }
+    std::cout << "Escuchando en " << options.serve_path << " (memoria " << memory_size << ", "
+             << algorithm_display_name(algorithm) << "); termina con SHUTDOWN o Ctrl+C" << std::endl;
+    active_server = &server;
+    std::signal(SIGINT, stop_active_server);
+    std::signal(SIGTERM, stop_active_server);
+    ServerStats stats = server.run();
+    active_server = nullptr;
+    show_server_stats(stats);
+    return 0;
+}
+#endif
+
+// Ramas copy-on-write: sobre la traza o la verificación sintética de ramas
+int run_branch_mode(const CommandLine& options, Address memory_size, AllocationAlgorithm algorithm,
+                    const std::string& input_file) {
+    if (options.quick_lists.enabled()) {
+        std::cout << "Error: Las ramas no admiten listas rapidas\n";
+        return 1;
+    }
+    if (algorithm == AllocationAlgorithm::ADAPTIVE) {
+        std::cout << "Error: Las ramas admiten los algoritmos 1 a 5\n";
+        return 1;
+    }
+    RecordWriter records(std::cout, options.output_format);
+    if (!input_file.empty()) {
+        std::ifstream file(input_file);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << input_file << "'\n";
+            return 1;
+        }
+        BranchExplorer explorer(memory_size, algorithm, options.block_layout);
+        BranchRun run = replay_branch_trace(file, explorer);
+        return show_branch_report(records, input_file, explorer, run) ? 0 : 2;
+    }
+    DynamicMemoryManager<SizeOrderedIndex> manager(memory_size, algorithm);
+    manager.set_layout(options.block_layout);
+    int operations = options.ops_or(50000);
+    BranchCheck check = run_branch_check(manager, options.block_layout, operations, 256, 64, options.max_request, 1);
+    return show_branch_check(records, memory_size, algorithm, check) ? 0 : 2;
+}
+
+// Hilos contra un gestor compartido con cada estrategia de sincronización pedida
+int run_concurrent_mode(const CommandLine& options, Address memory_size, AllocationAlgorithm algorithm,
+                        const char* program_name) {
+    // El adaptativo cambia de estado en cada búsqueda, también en las que fallan en
+    // una franja, y la reproducción serie por región no puede repetir esas búsquedas
+    if (algorithm == AllocationAlgorithm::ADAPTIVE) {
+        std::cout << "Error: El modo concurrente admite los algoritmos 1 a 5\n";
+        return 1;
+    }
+    const std::string& lock = options.concurrent_lock;
+    std::vector<LockStrategy> strategies;
+    if (lock == "global" || lock == "all") strategies.push_back(LockStrategy::GLOBAL_MUTEX);
+    if (lock == "striped" || lock == "all") strategies.push_back(LockStrategy::STRIPED);
+    if (lock == "lockfree" || lock == "all") strategies.push_back(LockStrategy::LOCK_FREE_SMALL);
+    if (lock == "arenas" || lock == "all") strategies.push_back(LockStrategy::ARENAS);
+    if (strategies.empty()) {
+        std::cout << "Error: Estrategia no valida '" << lock << "'\n";
+        show_usage(program_name);
+        return 1;
+    }
+    
+    bool all_ok = true;
+    int ops_per_thread = options.ops_or(20000);
+    for (LockStrategy strategy : strategies) {
+        int regions = strategy == LockStrategy::ARENAS ? options.concurrent_arenas : options.concurrent_stripes;
+        all_ok = run_concurrency_benchmark(strategy, memory_size, algorithm, options.concurrent_threads,
+                                           ops_per_thread, regions, options.max_request) && all_ok;
+    }
+    return all_ok ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+    CommandLine options;
+    if (!parse_command_line(argc, argv, options)) {
+        return 1;
+    }
+    argc = static_cast<int>(options.positional.size());
+    argv = options.positional.data();
+    bool human = options.output_format == OutputFormat::TEXT;
+    
+    if (human) {
+        std::cout << "=== SIMULADOR DE GESTION DE MEMORIA - TAREA 2 ===\n\n";
+    }
+    
+    // Perfil de la traza: una pasada sin simular la colocación
+    if (!options.analyze_file.empty()) {
+        RecordWriter records(std::cout, options.output_format);
+        return analyze_trace_file(records, options.analyze_file) ? 0 : 1;
+    }
+    
+    // Verificador: reproduce la traza y compara cada decisión con el registro
+    if (!options.verify_log_file.empty()) {
+        if (argc != 2) {
+            show_usage(argv[0]);
+            return 1;
+        }
+        return run_decision_verification(options.verify_log_file, argv[1], options.verify_linear) ? 0 : 2;
+    }
+    
+    if (options.fuzz_mode) {
+        return run_fuzz_mode(options, argc, argv);
+    }
+    if (options.big_heap) {
+        return run_big_heap_mode(options, argc, argv);
+    }
+    if (options.paging_mode) {
+        return run_paging_mode(options, argc, argv);
+    }
+    if (options.latency_mode) {
+        return run_latency_mode(options, argc, argv);
+    }
+    if (!options.load_path.empty()) {
+#ifdef __linux__
+        return run_load_mode(options, argc, argv);
+#else
+        std::cout << "Error: El generador de carga requiere Linux (sockets Unix)\n";
+        return 1;
+#endif
+    }
+    if (options.adaptive_eval) {
+        return run_adaptive_eval_mode(options, argc, argv);
+    }
+    
+    // Oráculo offline: conoce toda la traza y la compara con los algoritmos en línea
+    if (!options.oracle_file.empty()) {
+        std::ifstream file(options.oracle_file);
+        if (!file.is_open()) {
+            std::cout << "Error: No se pudo abrir el archivo '" << options.oracle_file << "'\n";
+            return 1;
+        }
+        RecordWriter records(std::cout, options.output_format);
+        show_oracle_report(records, options.oracle_file, run_placement_oracle(load_replay_ops(file)));
         return 0;
     }
     
+    if ((options.concurrent_mode || options.bench_dispatch || options.check_allocs || options.timed_mode ||
+         options.branch_mode || options.serve_bench || !options.serve_path.empty()) && argc < 3) {
+        show_usage(argv[0]);
+        return 1;
+    }
+    
+    if (argc < 3) {
+        return run_interactive_setup(options);
+    }
+    
     // Modo tradicional con argumentos de línea de comandos
     if (argc > 4) {
         show_usage(argv[0]);
@@ -835,7 +2624,7 @@ int main(int argc, char* argv[]) {
     }
     
     // Parsear argumentos
-    int memory_size = std::atoi(argv[1]);
+    Address memory_size = std::atoll(argv[1]);
     int algorithm_num = std::atoi(argv[2]);
     std::string input_file = (argc == 4) ? argv[3] : "";
     
@@ -844,6 +2633,10 @@ int main(int argc, char* argv[]) {
         std::cout << "Error: Tamano de memoria debe ser al menos 100 unidades\n";
         return 1;
     }
+    if (memory_size > MAX_TOTAL_MEMORY) {
+        std::cout << "Error: Tamano de memoria debe ser a lo sumo " << MAX_TOTAL_MEMORY << " unidades\n";
+        return 1;
+    }
     
     // Validar y configurar algoritmo
     AllocationAlgorithm algorithm;
@@ -851,28 +2644,65 @@ int main(int argc, char* argv[]) {
         case 1: algorithm = AllocationAlgorithm::FIRST_FIT; break;
         case 2: algorithm = AllocationAlgorithm::BEST_FIT; break;
         case 3: algorithm = AllocationAlgorithm::WORST_FIT; break;
+        case 4: algorithm = AllocationAlgorithm::NEXT_FIT; break;
+        case 5: algorithm = AllocationAlgorithm::TLSF; break;
+        case 6: algorithm = AllocationAlgorithm::ADAPTIVE; break;
         default:
-            std::cout << "Error: Algoritmo debe ser 1, 2 o 3\n";
+            std::cout << "Error: Algoritmo debe ser 1, 2, 3, 4, 5 o 6\n";
             show_usage(argv[0]);
             return 1;
     }
     
-    std::cout << "Configuracion:\n";
-    std::cout << "- Memoria: " << memory_size << " unidades\n";
-    
-    switch (algorithm) {
-        case AllocationAlgorithm::FIRST_FIT: std::cout << "- Algoritmo: First Fit\n"; break;
-        case AllocationAlgorithm::BEST_FIT: std::cout << "- Algoritmo: Best Fit\n"; break;
-        case AllocationAlgorithm::WORST_FIT: std::cout << "- Algoritmo: Worst Fit\n"; break;
+    if (options.check_allocs) {
+        int operations = options.ops_or(20000); // A/L en régimen estable
+        return run_allocation_check(memory_size, algorithm, operations, options.max_request) ? 0 : 2;
+    }
+    if (options.bench_dispatch) {
+        return run_dispatch_mode(options, memory_size, algorithm, input_file);
+    }
+    if (options.timed_mode) {
+        return run_timed_mode(options, memory_size, algorithm, input_file);
+    }
+    if (options.serve_bench || !options.serve_path.empty()) {
+#ifdef __linux__
+        return run_server_mode(options, memory_size, algorithm);
+#else
+        std::cout << "Error: El servidor requiere Linux (sockets Unix y epoll)\n";
+        return 1;
+#endif
+    }
+    if (options.branch_mode) {
+        return run_branch_mode(options, memory_size, algorithm, input_file);
+    }
+    if (options.concurrent_mode) {
+        return run_concurrent_mode(options, memory_size, algorithm, argv[0]);
     }
     
-    if (!input_file.empty()) {
-        std::cout << "- Archivo de entrada: " << input_file << "\n";
+    if (human) {
+        std::cout << "Configuracion:\n";
+        std::cout << "- Memoria: " << memory_size << " unidades\n";
+        
+        switch (algorithm) {
+            case AllocationAlgorithm::FIRST_FIT: std::cout << "- Algoritmo: First Fit\n"; break;
+            case AllocationAlgorithm::BEST_FIT: std::cout << "- Algoritmo: Best Fit\n"; break;
+            case AllocationAlgorithm::WORST_FIT: std::cout << "- Algoritmo: Worst Fit\n"; break;
+            case AllocationAlgorithm::NEXT_FIT: std::cout << "- Algoritmo: Next Fit\n"; break;
+            case AllocationAlgorithm::TLSF: std::cout << "- Algoritmo: TLSF\n"; break;
+            case AllocationAlgorithm::ADAPTIVE: std::cout << "- Algoritmo: Adaptativo\n"; break;
+        }
+        
+        if (!input_file.empty()) {
+            std::cout << "- Archivo de entrada: " << input_file << "\n";
+        }
+        std::cout << "\n";
     }
-    std::cout << "\n";
     
     // Crear simulador
-    MemorySimulator simulator(memory_size, algorithm);
+    MemorySimulator simulator(memory_size, algorithm, options.output_format);
+    std::unique_ptr<DecisionLogWriter> decision_log;
+    if (!prepare_simulator(simulator, options, memory_size, algorithm, decision_log)) {
+        return 1;
+    }
     
     // Si hay archivo de entrada, ejecutarlo primero
     if (!input_file.empty()) {
@@ -882,30 +2712,20 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
-        std::string line;
-        int line_number = 0;
-        std::cout << "Ejecutando comandos desde '" << input_file << "'...\n\n";
-        
-        while (std::getline(file, line)) {
-            line_number++;
-            
-            // Ignorar líneas vacías y comentarios
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            
-            std::cout << "[Linea " << line_number << "] " << line << "\n";
-            simulator.process_command(line);
-            std::cout << "\n";
+        if (human) {
+            std::cout << "Ejecutando comandos desde '" << input_file << "'...\n\n";
         }
         
+        simulator.replay(file);
         file.close();
-        std::cout << "=== Ejecucion del archivo completada ===\n\n";
-        std::cout << "Continuando en modo interactivo...\n\n";
+        if (human) {
+            std::cout << "=== Ejecucion del archivo completada ===\n\n";
+            std::cout << "Continuando en modo interactivo...\n\n";
+        }
     }
     
     // Ejecutar modo interactivo
     simulator.run();
     
-    return 0;
-}
\ No newline at end of file
+    return finish_sampling(simulator, options);
+}